@@ -97,6 +97,7 @@ class Sam_do(samUtils.Sam):
         parser.add_argument('--no-recursivity', dest='noRecursivity', action='store_true', default=False, help='Disable recursivity when using directory as input/output')
         parser.add_argument('--continue-on-error', dest='continueOnError', action='store_true', default=False, help='continue the process even if errors occured')
         parser.add_argument('--stop-on-missing-files', dest='stopOnMissingFiles', action='store_true', default=False, help='stop the process if missing files')
+        parser.add_argument('--trace', dest='trace', default='', help='write the timings of each node and frame to this file, in the Chrome trace event format')
         parser.add_argument('--no-plugin-cache', dest='noPluginCache', action='store_true', default=False, help='load plugins without using the cache file')
         parser.add_argument('--rebuild-plugin-cache', dest='rebuildPluginCache', action='store_true', default=False, help='load plugins and rebuild the cache file')
         parser.add_argument('-v', '--verbose', dest='verbose', action=samUtils.SamSetVerboseAction, default=2, help='verbose level (0/fatal, 1/error, 2/warn(by default), 3/info, 4/debug, 5(or upper)/trace) of tuttle host and sam application')
@@ -537,6 +538,8 @@ class Sam_do(samUtils.Sam):
             options.setContinueOnError(args.continueOnError)
             # sam-do --stop-on-missing-files
             options.setContinueOnMissingFile(not args.stopOnMissingFiles)
+            # sam-do --trace
+            options.setTraceFilename(args.trace)
             # Set progress handle
             ranges = options.getTimeRanges()
             if not len(ranges):
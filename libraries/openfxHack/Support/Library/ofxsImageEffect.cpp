@@ -656,6 +656,12 @@ void ImageEffectDescriptor::setPluginEvaluation(double evaluation)
     _effectProps.propSetDouble(kTuttleOfxImageEffectPropEvaluation, evaluation, false);
 }
 
+void ImageEffectDescriptor::setPointwise(bool v)
+{
+    // This property is an extension, so it's optional.
+    _effectProps.propSetInt(kTuttleOfxImageEffectPropPointwise, int(v), false);
+}
+
 /** @brief Is the plugin single instance only ? */
 void ImageEffectDescriptor::setSingleInstance(bool v)
 {
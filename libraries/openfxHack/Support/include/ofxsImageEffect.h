@@ -446,6 +446,9 @@ public:
     void addSupportedExtensions( const std::vector<std::string>& extensions );
 
     void setPluginEvaluation( double evaluation );
+
+    /** @brief Is each output pixel only computed from the source pixel at the same position ? defaults to false */
+    void setPointwise( bool v );
     
     /** @brief Is the plugin single instance only ? defaults to false */
     void setSingleInstance( bool v );
@@ -0,0 +1,26 @@
+#ifndef _ofxPointwise_h_
+#define _ofxPointwise_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Indicates that the plugin is a pointwise operation.
+ *
+ * - Type - int X 1
+ * - Property Set - plugin descriptor (read/write)
+ * - Default - 0
+ * - Valid Values - This must be one of 0 or 1
+ *   - 0 - the output pixels may depend on any source pixel
+ *   - 1 - each output pixel only depends on the source pixel at the same position and time,
+ *         so the host may render the effect in place, in the buffer of its source image
+ *
+ * The host uses it to render chains of pointwise effects in a single buffer, by bands.
+ */
+#define kTuttleOfxImageEffectPropPointwise "TuttleOfxImageEffectPropPointwise"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
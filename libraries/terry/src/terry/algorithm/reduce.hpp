@@ -0,0 +1,126 @@
+#ifndef _TERRY_ALGORITHM_REDUCE_HPP_
+#define _TERRY_ALGORITHM_REDUCE_HPP_
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace terry
+{
+namespace algorithm
+{
+
+/**
+ * @brief Reduction of the rows [y1, y2) in horizontal bands, each one reduced in its own partial result.
+ *
+ * The bands can be reduced by different threads, then the partial results are merged in the bands order.
+ * The bands don't depend on the number of threads, so neither does the result.
+ *
+ * RowReducer is copyable, reduces a row with operator()( y ) and merges the result of the following rows with
+ * merge( const RowReducer& ).
+ */
+template <class RowReducer>
+class band_reduction
+{
+public:
+    static const std::ptrdiff_t defaultBandHeight = 16;
+
+    band_reduction(const RowReducer& init, const std::ptrdiff_t y1, const std::ptrdiff_t y2,
+                   const std::ptrdiff_t bandHeight = defaultBandHeight)
+        : _y1(y1)
+        , _y2(std::max(y1, y2))
+        , _bandHeight(bandHeight)
+        , _partials((_y2 - _y1 + bandHeight - 1) / bandHeight, init)
+        , _init(init)
+    {
+        BOOST_ASSERT(bandHeight > 0);
+    }
+
+    std::size_t nbBands() const { return _partials.size(); }
+
+    /// Number of rows of a band, only the last one can be smaller than the band height
+    std::ptrdiff_t nbBandRows(const std::size_t band) const
+    {
+        BOOST_ASSERT(band < _partials.size());
+        const std::ptrdiff_t begin = _y1 + band * _bandHeight;
+        return std::min(begin + _bandHeight, _y2) - begin;
+    }
+
+    /// Reduce the rows of a band, the different bands can be reduced concurrently
+    void reduceBand(const std::size_t band)
+    {
+        BOOST_ASSERT(band < _partials.size());
+        RowReducer& reducer = _partials[band];
+        const std::ptrdiff_t begin = _y1 + band * _bandHeight;
+        const std::ptrdiff_t end = begin + nbBandRows(band);
+        for(std::ptrdiff_t y = begin; y < end; ++y)
+            reducer(y);
+    }
+
+    /// Merge the partial results, once all the bands are reduced
+    RowReducer result() const
+    {
+        RowReducer result = _init;
+        for(std::size_t band = 0; band < _partials.size(); ++band)
+            result.merge(_partials[band]);
+        return result;
+    }
+
+private:
+    std::ptrdiff_t _y1;
+    std::ptrdiff_t _y2;
+    std::ptrdiff_t _bandHeight;
+    std::vector<RowReducer> _partials;
+    RowReducer _init;
+};
+
+/**
+ * @brief Row reducer applying a pixel functor to each pixel of the rows of a view, like transform_pixels.
+ * PixelReducer merges the result of the following pixels with merge( const PixelReducer& ).
+ */
+template <class View, class PixelReducer>
+struct pixel_row_reducer
+{
+    View _view;
+    PixelReducer _reducer;
+
+    pixel_row_reducer(const View& view, const PixelReducer& init)
+        : _view(view)
+        , _reducer(init)
+    {
+    }
+
+    void operator()(const std::ptrdiff_t y)
+    {
+        typename View::x_iterator it = _view.row_begin(y);
+        const std::ptrdiff_t width = _view.width();
+        for(std::ptrdiff_t x = 0; x < width; ++x)
+            _reducer(it[x]);
+    }
+
+    void merge(const pixel_row_reducer& other) { _reducer.merge(other._reducer); }
+};
+
+/**
+ * @brief Reduce all the bands in the current thread.
+ */
+template <class RowReducer>
+RowReducer reduce_rows(const RowReducer& init, const std::ptrdiff_t y1, const std::ptrdiff_t y2)
+{
+    band_reduction<RowReducer> reduction(init, y1, y2);
+    for(std::size_t band = 0; band < reduction.nbBands(); ++band)
+        reduction.reduceBand(band);
+    return reduction.result();
+}
+
+template <class View, class PixelReducer>
+PixelReducer reduce_pixels(const View& view, const PixelReducer& init)
+{
+    return reduce_rows(pixel_row_reducer<View, PixelReducer>(view, init), 0, view.height())._reducer;
+}
+}
+}
+
+#endif
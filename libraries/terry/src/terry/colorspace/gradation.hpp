@@ -165,7 +165,7 @@ struct channel_color_gradation_t<Channel, gradation::sRGB, gradation::Linear>
         const T fSrc = channel_convert<T>(src);
         T fDst;
 
-        if(src > 0.04045)
+        if(fSrc > 0.04045)
         {
             fDst = std::pow((fSrc + 0.055) / 1.055, 2.4);
         }
@@ -216,7 +216,7 @@ struct channel_color_gradation_t<Channel, gradation::Linear, gradation::sRGB>
         const T fSrc = channel_convert<T>(src);
         T fDst;
 
-        if(src > 0.0031308)
+        if(fSrc > 0.0031308)
         {
             fDst = 1.055 * std::pow(T(fSrc), T(1.0 / 2.4)) - 0.055;
         }
@@ -0,0 +1,218 @@
+#ifndef _TERRY_COLOR_GRADATION_LUT_HPP_
+#define _TERRY_COLOR_GRADATION_LUT_HPP_
+
+#include "gradation.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace terry
+{
+namespace color
+{
+
+/**
+ * @brief Analytic gradation conversion of a float value, used to fill the tables.
+ * The gradations are copied, unlike channel_color_gradation_t which references them.
+ */
+template <class TIN, class TOUT>
+struct gradation_float_function_t
+{
+    TIN _in;
+    TOUT _out;
+
+    gradation_float_function_t(const TIN& in, const TOUT& out)
+        : _in(in)
+        , _out(out)
+    {
+    }
+
+    float operator()(const float value) const
+    {
+        bits32f dst;
+        channel_color_gradation_t<bits32f, TIN, TOUT>(_in, _out)(bits32f(value), dst);
+        return dst;
+    }
+};
+
+template <typename Channel>
+struct is_float_gradation_channel
+    : public boost::mpl::bool_<boost::is_same<typename floating_channel_type_t<Channel>::type, Channel>::value>
+{
+};
+
+/**
+ * @brief Gradation conversion of a channel from a table generated once, instead of the pow/log of each value.
+ *
+ * Integer channels (8, 10, 12 or 16 bits) use a table of all their values, filled with
+ * channel_color_gradation_t: the result is exactly the one of the analytic conversion.
+ *
+ * Float channels use a table indexed like half floats, by the exponent and the 10 upper bits of the mantissa,
+ * for the values in [2^-14, 2^8). Each segment of the table is linearly interpolated with the lower bits of the
+ * mantissa. Against the analytic conversion computed in float, the error is within 1.1e-6 relative to the result,
+ * or 6e-8 absolute for results below 1/16, for all the gradations.
+ * The segments which can't be interpolated within 2^-20 (discontinuities at the knee of Rec709, the fast growing
+ * exponentials of the log to linear conversions above 1, non finite results), and the negative, smaller, greater
+ * or non finite values use the analytic conversion.
+ */
+template <typename Channel, class IsFloat = typename is_float_gradation_channel<Channel>::type>
+class gradation_lut;
+
+template <typename Channel>
+class gradation_lut<Channel, boost::mpl::false_>
+{
+public:
+    typedef typename channel_traits<Channel>::const_reference ChannelConstRef;
+
+    template <class TIN, class TOUT>
+    void build(const TIN& in, const TOUT& out)
+    {
+        const std::size_t nbValues = std::size_t(channel_traits<Channel>::max_value()) + 1;
+        BOOST_ASSERT(channel_traits<Channel>::min_value() == 0);
+        BOOST_ASSERT(nbValues <= 65536);
+        _table.resize(nbValues);
+        const channel_color_gradation_t<Channel, TIN, TOUT> convert(in, out);
+        for(std::size_t i = 0; i < nbValues; ++i)
+            convert(Channel(i), _table[i]);
+    }
+
+    Channel operator()(ChannelConstRef src) const { return _table[std::size_t(src)]; }
+
+private:
+    std::vector<Channel> _table;
+};
+
+template <typename Channel>
+class gradation_lut<Channel, boost::mpl::true_>
+{
+public:
+    typedef typename channel_traits<Channel>::const_reference ChannelConstRef;
+
+    static const int minExponent = -14;
+    static const int maxExponent = 8;
+    static const int indexedMantissaBits = 10;
+
+    template <class TIN, class TOUT>
+    void build(const TIN& in, const TOUT& out)
+    {
+        _function = gradation_float_function_t<TIN, TOUT>(in, out);
+        const std::size_t nbSegments = (maxExponent - minExponent) << indexedMantissaBits;
+        _segments.resize(2 * nbSegments);
+        for(std::size_t i = 0; i < nbSegments; ++i)
+        {
+            const boost::uint32_t bits = minBits() + (boost::uint32_t(i) << interpolatedBits);
+            const float v0 = _function(fromBits(bits));
+            const float v1 = _function(fromBits(bits + (1u << interpolatedBits)));
+            float slope = v1 - v0;
+            bool interpolable = std::fabs(v0) <= std::numeric_limits<float>::max() &&
+                                std::fabs(v1) <= std::numeric_limits<float>::max();
+            for(int q = 1; q < 4 && interpolable; ++q)
+            {
+                const float expected = _function(fromBits(bits + (q << (interpolatedBits - 2))));
+                const float tolerance = std::ldexp(std::max(std::fabs(expected), 1.0f / 16.0f), -20);
+                interpolable = std::fabs(v0 + slope * (q * 0.25f) - expected) <= tolerance;
+            }
+            if(!interpolable)
+                slope = std::numeric_limits<float>::quiet_NaN();
+            _segments[2 * i] = v0;
+            _segments[2 * i + 1] = slope;
+        }
+    }
+
+    Channel operator()(ChannelConstRef src) const
+    {
+        const float value = src;
+        boost::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // negative values have the sign bit, so they are greater than maxBits like the non finite values
+        if(bits >= minBits() && bits < maxBits())
+        {
+            const boost::uint32_t offset = bits - minBits();
+            const float* segment = &_segments[2 * (offset >> interpolatedBits)];
+            const float t = float(offset & ((1u << interpolatedBits) - 1)) * (1.0f / (1u << interpolatedBits));
+            const float result = segment[0] + segment[1] * t;
+            if(result == result) // NaN for the segments to compute
+                return Channel(result);
+        }
+        return Channel(_function(value));
+    }
+
+private:
+    static const int interpolatedBits = 23 - indexedMantissaBits;
+
+    static boost::uint32_t minBits() { return boost::uint32_t(127 + minExponent) << 23; }
+    static boost::uint32_t maxBits() { return boost::uint32_t(127 + maxExponent) << 23; }
+    static float fromBits(const boost::uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    std::vector<float> _segments; ///< value at the beginning and slope of each segment
+    boost::function<float(float)> _function;
+};
+
+template <typename Channel>
+struct channel_gradation_lut_t : public std::binary_function<Channel, Channel, Channel>
+{
+    typedef typename channel_traits<Channel>::const_reference ChannelConstRef;
+    typedef typename channel_traits<Channel>::reference ChannelRef;
+
+    const gradation_lut<Channel>& _lut;
+
+    channel_gradation_lut_t(const gradation_lut<Channel>& lut)
+        : _lut(lut)
+    {
+    }
+
+    ChannelRef operator()(ChannelConstRef src, ChannelRef dst) const { return dst = _lut(src); }
+};
+
+/**
+ * @brief Same as transform_pixel_color_gradation_t, with a table built for the channel type of the pixels.
+ */
+template <typename Channel>
+struct transform_pixel_gradation_lut_t
+{
+    const gradation_lut<Channel>& _lut;
+
+    transform_pixel_gradation_lut_t(const gradation_lut<Channel>& lut)
+        : _lut(lut)
+    {
+    }
+
+    template <typename Pixel>
+    Pixel operator()(const Pixel& p1) const
+    {
+        Pixel p2;
+        static_for_each(p1, p2, channel_gradation_lut_t<Channel>(_lut));
+        return p2;
+    }
+};
+
+/**
+ * @example gradation_lut<bits16> lut; lut.build( gradation::sRGB(), gradation::Linear() );
+ *          gradation_convert_view_lut( srcView, dstView, lut );
+ */
+template <class View>
+void gradation_convert_view_lut(const View& src, View& dst,
+                                const gradation_lut<typename channel_type<View>::type>& lut)
+{
+    boost::gil::transform_pixels(src, dst, transform_pixel_gradation_lut_t<typename channel_type<View>::type>(lut));
+}
+}
+}
+
+#endif
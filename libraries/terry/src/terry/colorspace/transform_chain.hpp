@@ -0,0 +1,199 @@
+#ifndef _TERRY_COLOR_TRANSFORM_CHAIN_HPP_
+#define _TERRY_COLOR_TRANSFORM_CHAIN_HPP_
+
+#include "gradation_lut.hpp"
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace terry
+{
+namespace color
+{
+
+/**
+ * @brief Sequence of color conversions of rgb float values, compiled once and applied to the rows of an image.
+ *
+ * The steps are 3x3 matrices (layouts, temperatures, primaries) and gradations, converted into tables.
+ * compile() multiplies the consecutive matrices into one and removes the identities, so a chain of
+ * conversions costs at most one matrix between each gradation.
+ */
+class color_transform_chain
+{
+public:
+    typedef boost::numeric::ublas::bounded_matrix<double, 3, 3> Matrix33;
+
+    static Matrix33 identity()
+    {
+        Matrix33 m(3, 3);
+        for(std::size_t i = 0; i < 3; ++i)
+            for(std::size_t j = 0; j < 3; ++j)
+                m(i, j) = (i == j) ? 1.0 : 0.0;
+        return m;
+    }
+
+    static Matrix33 diagonal(const double a, const double b, const double c)
+    {
+        Matrix33 m = identity();
+        m(0, 0) = a;
+        m(1, 1) = b;
+        m(2, 2) = c;
+        return m;
+    }
+
+    static Matrix33 matrix(const double m00, const double m01, const double m02, const double m10, const double m11,
+                           const double m12, const double m20, const double m21, const double m22)
+    {
+        Matrix33 m(3, 3);
+        m(0, 0) = m00;
+        m(0, 1) = m01;
+        m(0, 2) = m02;
+        m(1, 0) = m10;
+        m(1, 1) = m11;
+        m(1, 2) = m12;
+        m(2, 0) = m20;
+        m(2, 1) = m21;
+        m(2, 2) = m22;
+        return m;
+    }
+
+    static Matrix33 inverse(const Matrix33& m)
+    {
+        const double c00 = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+        const double c01 = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+        const double c02 = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+        const double invDet = 1.0 / (m(0, 0) * c00 + m(0, 1) * c01 + m(0, 2) * c02);
+        return matrix(c00 * invDet, (m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2)) * invDet,
+                      (m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1)) * invDet, c01 * invDet,
+                      (m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0)) * invDet,
+                      (m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2)) * invDet, c02 * invDet,
+                      (m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1)) * invDet,
+                      (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * invDet);
+    }
+
+    /// @name Layouts expressed as a matrix
+    /// @{
+    /// YUV of rgb values encoded with their gradation, the coefficients of layout::yuv_t
+    static Matrix33 rgb_to_yuv()
+    {
+        return matrix(0.299, 0.587, 0.114, -0.14713, -0.28886, 0.436, 0.615, -0.51499, -0.10001);
+    }
+    /// YPbPr of rgb values encoded with their gradation, the coefficients of layout::YPbPr_t
+    static Matrix33 rgb_to_YPbPr()
+    {
+        return matrix(0.299, 0.587, 0.114, -0.168736, -0.331264, 0.5, 0.5, -0.418688, -0.081312);
+    }
+    /// XYZ of linear rgb values with the sRGB / Rec709 primaries and the D65 white
+    static Matrix33 rgb_to_XYZ()
+    {
+        return matrix(0.4124564, 0.3575761, 0.1804375, 0.2126729, 0.7151522, 0.0721750, 0.0193339, 0.1191920,
+                      0.9503041);
+    }
+    /// @}
+
+    /// Apply the matrix @p m to the values
+    void addMatrix(const Matrix33& m)
+    {
+        Step step;
+        step._matrix = m;
+        _steps.push_back(step);
+    }
+
+    /// Convert the values from the gradation @p in to @p out
+    template <class TIN, class TOUT>
+    void addGradation(const TIN& in, const TOUT& out)
+    {
+        if(boost::is_same<TIN, TOUT>::value)
+            return;
+        Step step;
+        step._lut.reset(new gradation_lut<bits32f>());
+        step._lut->build(in, out);
+        _steps.push_back(step);
+    }
+
+    /// Merge the consecutive matrices and remove the identities
+    void compile()
+    {
+        std::vector<Step> steps;
+        for(std::vector<Step>::const_iterator it = _steps.begin(); it != _steps.end(); ++it)
+        {
+            if(!it->_lut && !steps.empty() && !steps.back()._lut)
+                steps.back()._matrix = boost::numeric::ublas::prod(it->_matrix, steps.back()._matrix);
+            else
+                steps.push_back(*it);
+        }
+        _steps.clear();
+        for(std::vector<Step>::const_iterator it = steps.begin(); it != steps.end(); ++it)
+        {
+            if(it->_lut || !isIdentity(it->_matrix))
+                _steps.push_back(*it);
+        }
+    }
+
+    std::size_t nbSteps() const { return _steps.size(); }
+
+    /**
+     * @brief Apply all the steps to @p nbPixels rgb values.
+     * @param[in, out] values interleaved red, green and blue values
+     */
+    void apply(float* values, const std::size_t nbPixels) const
+    {
+        for(std::vector<Step>::const_iterator it = _steps.begin(); it != _steps.end(); ++it)
+        {
+            float* const end = values + 3 * nbPixels;
+            if(it->_lut)
+            {
+                const gradation_lut<bits32f>& lut = *it->_lut;
+                for(float* v = values; v != end; ++v)
+                    *v = lut(bits32f(*v));
+            }
+            else
+            {
+                float m[3][3];
+                for(std::size_t i = 0; i < 3; ++i)
+                    for(std::size_t j = 0; j < 3; ++j)
+                        m[i][j] = float(it->_matrix(i, j));
+                for(float* v = values; v != end; v += 3)
+                {
+                    const float r = v[0];
+                    const float g = v[1];
+                    const float b = v[2];
+                    v[0] = m[0][0] * r + m[0][1] * g + m[0][2] * b;
+                    v[1] = m[1][0] * r + m[1][1] * g + m[1][2] * b;
+                    v[2] = m[2][0] * r + m[2][1] * g + m[2][2] * b;
+                }
+            }
+        }
+    }
+
+private:
+    static bool isIdentity(const Matrix33& m)
+    {
+        for(std::size_t i = 0; i < 3; ++i)
+            for(std::size_t j = 0; j < 3; ++j)
+                if(std::fabs(m(i, j) - (i == j ? 1.0 : 0.0)) > 1e-9)
+                    return false;
+        return true;
+    }
+
+    struct Step
+    {
+        Step()
+            : _matrix(identity())
+        {
+        }
+        Matrix33 _matrix;
+        boost::shared_ptr<gradation_lut<bits32f> > _lut; ///< the step is a gradation if set, a matrix otherwise
+    };
+
+    std::vector<Step> _steps;
+};
+}
+}
+
+#endif
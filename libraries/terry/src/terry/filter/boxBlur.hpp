@@ -0,0 +1,200 @@
+#ifndef _TERRY_FILTER_BOXBLUR_HPP_
+#define _TERRY_FILTER_BOXBLUR_HPP_
+
+#include "convolve.hpp"
+
+#include <terry/numeric/assign.hpp>
+#include <terry/numeric/init.hpp>
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/pixel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace terry
+{
+using namespace boost::gil;
+
+namespace filter
+{
+
+/**
+ * @brief Box filter with a fractional weight on its two end pixels, so its variance is not limited to integer radii.
+ *
+ * A cascade of nbPasses extended boxes approximates a gaussian with a cost per pixel independent of its size.
+ * [Gwosdek, Grewenig, Bruhn, Weickert, "Theoretical foundations of Gaussian convolution by extended box filtering",
+ * SSVM 2011]
+ */
+struct extended_box
+{
+    std::size_t _nbPasses;
+    std::size_t _radius;
+    double _alpha; ///< weight of each end pixel, relative to the inner ones
+
+    /**
+     * @param variance variance of the gaussian, in pixels
+     */
+    extended_box(const double variance, const std::size_t nbPasses = 3)
+        : _nbPasses(nbPasses)
+        , _radius(0)
+        , _alpha(0.0)
+    {
+        if(variance <= 0.0)
+            return;
+        const double passVariance = variance / nbPasses;
+        _radius = static_cast<std::size_t>(std::floor(0.5 * std::sqrt(12.0 * passVariance + 1.0) - 0.5));
+        const double r = _radius;
+        _alpha = (2.0 * r + 1.0) * (passVariance - r * (r + 1.0) / 3.0) / (2.0 * ((r + 1.0) * (r + 1.0) - passVariance));
+    }
+
+    bool isIdentity() const { return _radius == 0 && _alpha == 0.0; }
+
+    /// Number of source pixels needed on each side of a filtered pixel
+    std::size_t margin() const { return isIdentity() ? 0 : _nbPasses * (_radius + 1); }
+};
+
+namespace detail
+{
+
+/**
+ * @brief One extended box pass over a line of @p size elements, each made of @p elementSize channels.
+ * @param[in] src line of size + 2 * (radius + 1) elements
+ * @param[in] sum buffer of elementSize channels
+ * @param[out] dst line of size elements, dst[i] is the filtered src[i + radius + 1]
+ */
+template <typename Channel>
+void extended_box_pass(const Channel* src, const std::size_t size, const std::size_t elementSize, const extended_box& box,
+                       Channel* sum, Channel* dst)
+{
+    const std::size_t width = 2 * box._radius + 1;
+    const Channel norm = Channel(1.0 / (width + 2.0 * box._alpha));
+    const Channel endWeight = Channel(box._alpha) * norm;
+
+    std::fill(sum, sum + elementSize, Channel(0));
+    for(std::size_t i = 1; i <= width; ++i)
+        for(std::size_t c = 0; c < elementSize; ++c)
+            sum[c] += src[i * elementSize + c];
+
+    const std::size_t lastOffset = (width + 1) * elementSize;
+    for(std::size_t i = 0; i < size; ++i, src += elementSize, dst += elementSize)
+    {
+        for(std::size_t c = 0; c < elementSize; ++c)
+        {
+            dst[c] = sum[c] * norm + (src[c] + src[lastOffset + c]) * endWeight;
+            sum[c] += src[lastOffset + c] - src[elementSize + c];
+        }
+    }
+}
+
+/**
+ * @brief Apply the passes of @p box on a line of @p size elements, with the margin of the box on each side.
+ * @return the buffer containing the result, @p line or @p tmp
+ */
+template <typename Channel>
+Channel* extended_box_passes(Channel* line, Channel* tmp, const std::size_t size, const std::size_t elementSize,
+                             const extended_box& box, Channel* sum)
+{
+    const std::size_t step = box._radius + 1;
+    std::size_t margin = box.margin();
+    Channel* src = line;
+    Channel* dst = tmp;
+    for(std::size_t pass = 0; pass < box._nbPasses && margin > 0; ++pass)
+    {
+        margin -= step;
+        extended_box_pass(src, size + 2 * margin, elementSize, box, sum, dst);
+        std::swap(src, dst);
+    }
+    return src;
+}
+}
+
+/**
+ * @brief Gaussian blur approximated by a cascade of extended box filters, in rows then in columns.
+ *
+ * Same interface as correlate_rows_cols: @p dst_tl is the top left point of @p dst in @p src coordinates and the pixels
+ * outside of @p src follow the boundary @p option (padded sources are clamped).
+ * The cost per pixel doesn't depend on the size of the boxes. The image is processed in vertical strips to bound the
+ * size of the temporary buffers.
+ */
+template <typename PixelAccum, typename SrcView, typename DstView>
+void gaussian_box_blur(const SrcView& src, const extended_box& boxX, const extended_box& boxY, const DstView& dst,
+                       const typename SrcView::point_t& dst_tl, const convolve_boundary_option option)
+{
+    using namespace terry::numeric;
+    typedef typename channel_type<PixelAccum>::type Channel;
+    typedef typename pixel_proxy<typename SrcView::value_type>::type PIXEL_SRC_REF;
+    typedef typename pixel_proxy<typename DstView::value_type>::type PIXEL_DST_REF;
+    static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+    static const std::ptrdiff_t kMinStripWidth = 256;
+
+    const std::ptrdiff_t dstWidth = dst.width();
+    const std::ptrdiff_t dstHeight = dst.height();
+    if(dstWidth == 0 || dstHeight == 0)
+        return;
+    const std::ptrdiff_t srcWidth = src.width();
+    const std::ptrdiff_t srcHeight = src.height();
+    const std::ptrdiff_t marginX = boxX.margin();
+    const std::ptrdiff_t marginY = boxY.margin();
+    const std::ptrdiff_t stripWidth = std::min(std::max(kMinStripWidth, 4 * marginX), dstWidth);
+    const std::ptrdiff_t nbRows = dstHeight + 2 * marginY;
+
+    PixelAccum zero;
+    pixel_zeros_t<PixelAccum>()(zero);
+
+    std::vector<PixelAccum> line(stripWidth + 2 * marginX);
+    std::vector<PixelAccum> lineTmp(line.size());
+    std::vector<PixelAccum> rows(nbRows * stripWidth);
+    std::vector<PixelAccum> rowsTmp(rows.size());
+    std::vector<PixelAccum> sum(stripWidth);
+
+    for(std::ptrdiff_t x0 = 0; x0 < dstWidth; x0 += stripWidth)
+    {
+        const std::ptrdiff_t width = std::min(stripWidth, dstWidth - x0);
+        const std::ptrdiff_t lineBegin = dst_tl.x + x0 - marginX;
+
+        // rows pass, for the rows of dst and the margin of the columns pass
+        for(std::ptrdiff_t row = 0; row < nbRows; ++row)
+        {
+            PixelAccum* dstRow = &rows[row * width];
+            const std::ptrdiff_t y = detail::extend_position(dst_tl.y - marginY + row, srcHeight, option);
+            if(y < 0)
+            {
+                std::fill(dstRow, dstRow + width, zero);
+                continue;
+            }
+            typename SrcView::x_iterator srcIt = src.row_begin(y);
+            for(std::ptrdiff_t i = 0; i < width + 2 * marginX; ++i)
+            {
+                const std::ptrdiff_t x = detail::extend_position(lineBegin + i, srcWidth, option);
+                if(x < 0)
+                    line[i] = zero;
+                else
+                    pixel_assigns_t<PIXEL_SRC_REF, PixelAccum>()(srcIt[x], line[i]);
+            }
+            const PixelAccum* filtered = reinterpret_cast<const PixelAccum*>(detail::extended_box_passes(
+                reinterpret_cast<Channel*>(&line.front()), reinterpret_cast<Channel*>(&lineTmp.front()), width,
+                nbChannels, boxX, reinterpret_cast<Channel*>(&sum.front())));
+            std::copy(filtered, filtered + width, dstRow);
+        }
+
+        // columns pass, each element of the line is a row of the strip
+        const PixelAccum* filtered = reinterpret_cast<const PixelAccum*>(detail::extended_box_passes(
+            reinterpret_cast<Channel*>(&rows.front()), reinterpret_cast<Channel*>(&rowsTmp.front()), dstHeight,
+            width * nbChannels, boxY, reinterpret_cast<Channel*>(&sum.front())));
+
+        for(std::ptrdiff_t y = 0; y < dstHeight; ++y)
+        {
+            typename DstView::x_iterator dstIt = dst.row_begin(y) + x0;
+            const PixelAccum* filteredRow = filtered + y * width;
+            for(std::ptrdiff_t x = 0; x < width; ++x, ++dstIt)
+                pixel_assigns_t<PixelAccum, PIXEL_DST_REF>()(filteredRow[x], *dstIt);
+        }
+    }
+}
+}
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include <cstddef>
 #include <cassert>
 #include <algorithm>
+#include <limits>
 #include <vector>
 #include <functional>
 
@@ -259,11 +260,161 @@ void correlate_rows_imp(const SrcView& src, const Kernel& ker, const DstView& ds
     }
 }
 
+/**
+ * @brief Position used for @p x with the boundary option, -1 for a zero pixel.
+ */
+inline std::ptrdiff_t extend_position(const std::ptrdiff_t x, const std::ptrdiff_t size,
+                                      const convolve_boundary_option option)
+{
+    if(x >= 0 && x < size)
+        return x;
+    switch(option)
+    {
+        case convolve_option_extend_mirror:
+        {
+            const std::ptrdiff_t period = 2 * size;
+            std::ptrdiff_t m = x % period;
+            if(m < 0)
+                m += period;
+            return (m < size) ? m : period - 1 - m;
+        }
+        case convolve_option_extend_zero:
+        case convolve_option_output_zero:
+            return -1;
+        case convolve_option_extend_constant:
+        case convolve_option_extend_padded:
+        case convolve_option_output_ignore:
+            break;
+    }
+    return (x < 0) ? 0 : size - 1;
+}
+
+/// compute the correlation of 1D kernel with the columns of an image, with vectorized weighted sums of rows
+/// The image is processed in blocks of columns: the source rows of a block are converted once to floats, read
+/// contiguously, then each destination row of the block is the weighted sum of the rows of its window.
+/// Same parameters as correlate_rows_imp, dst may be src.
+template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView>
+void correlate_cols_blocked(const SrcView& src, const Kernel& ker, const DstView& dst,
+                            const typename SrcView::point_t& dst_tl, const convolve_boundary_option option)
+{
+    using namespace terry::numeric;
+
+    typedef typename pixel_proxy<typename SrcView::value_type>::type PIXEL_SRC_REF;
+    typedef typename pixel_proxy<typename DstView::value_type>::type PIXEL_DST_REF;
+    typedef typename channel_type<PixelAccum>::type Channel;
+    typedef boost::is_same<Channel, boost::gil::bits32f> IsFloat;
+    static const std::ptrdiff_t nbChannels = num_channels<PixelAccum>::value;
+    static const std::ptrdiff_t kBlockValues = 64 * 1024; // floats of the converted source rows of a block
+    static const std::ptrdiff_t kMinBlockWidth = 16;
+
+    // dst must be contained in src
+    assert(dst_tl <= src.dimensions());
+    assert(ker.size() > 1);
+
+    const std::ptrdiff_t width = dst.width();
+    const std::ptrdiff_t height = dst.height();
+    if(width == 0 || height == 0)
+        return;
+    const std::ptrdiff_t srcHeight = src.height();
+    const std::ptrdiff_t kerSize = ker.size();
+    const std::ptrdiff_t left = ker.left_size();
+    const std::ptrdiff_t right = ker.right_size();
+
+    // rows of dst computed, the rows whose window goes out of src are ignored or zeroed with the output options
+    std::ptrdiff_t yBegin = 0;
+    std::ptrdiff_t yEnd = height;
+    if(option == convolve_option_output_ignore || option == convolve_option_output_zero)
+    {
+        if(height < kerSize)
+            yEnd = 0;
+        else
+        {
+            yBegin = std::max(left - dst_tl.y, std::ptrdiff_t(0));
+            yEnd = std::max(std::min(height, srcHeight - right - dst_tl.y), yBegin);
+        }
+        if(option == convolve_option_output_zero)
+        {
+            PixelAccum acc_zero;
+            pixel_zeros_t<PixelAccum>()(acc_zero);
+            typename DstView::value_type dst_zero;
+            pixel_assigns_t<PixelAccum, PIXEL_DST_REF>()(acc_zero, dst_zero);
+            for(std::ptrdiff_t y = 0; y < height; ++y)
+                if(y < yBegin || y >= yEnd)
+                    std::fill_n(dst.row_begin(y), width, dst_zero);
+        }
+    }
+    if(yBegin >= yEnd)
+        return;
+
+    // source row of each row of the windows, kZeroRow for a zero row
+    // padded rows are read outside of src, so they can be negative
+    static const std::ptrdiff_t kZeroRow = std::numeric_limits<std::ptrdiff_t>::min();
+    std::vector<std::ptrdiff_t> srcRows(yEnd - yBegin + kerSize - 1);
+    std::ptrdiff_t firstRow = std::numeric_limits<std::ptrdiff_t>::max();
+    std::ptrdiff_t lastRow = kZeroRow;
+    for(std::size_t v = 0; v < srcRows.size(); ++v)
+    {
+        const std::ptrdiff_t y = dst_tl.y + yBegin - left + v;
+        if(option == convolve_option_extend_padded)
+            srcRows[v] = y;
+        else
+        {
+            const std::ptrdiff_t row = extend_position(y, srcHeight, option);
+            srcRows[v] = (row < 0) ? kZeroRow : row;
+        }
+        if(srcRows[v] != kZeroRow)
+        {
+            firstRow = std::min(firstRow, srcRows[v]);
+            lastRow = std::max(lastRow, srcRows[v]);
+        }
+    }
+    const std::ptrdiff_t nbSrcRows = (lastRow >= firstRow) ? lastRow - firstRow + 1 : 0;
+    const std::ptrdiff_t blockWidth =
+        std::min(std::max(kBlockValues / ((nbSrcRows + 1) * nbChannels), kMinBlockWidth), width);
+
+    std::vector<float> weights(kerSize);
+    std::copy(ker.begin(), ker.end(), weights.begin());
+    std::vector<float> block((nbSrcRows + 1) * blockWidth * nbChannels, 0.0f);
+    const float* zeroRow = &block[nbSrcRows * blockWidth * nbChannels];
+    std::vector<const float*> srcs(kerSize);
+    std::vector<float> result(blockWidth * nbChannels);
+
+    for(std::ptrdiff_t x0 = 0; x0 < width; x0 += blockWidth)
+    {
+        const std::ptrdiff_t blockSize = std::min(blockWidth, width - x0) * nbChannels;
+
+        // all the source rows of the block are read before writing dst
+        for(std::ptrdiff_t r = 0; r < nbSrcRows; ++r)
+        {
+            typename SrcView::x_iterator srcIt = src.x_at(dst_tl.x + x0, firstRow + r);
+            float* blockRow = &block[r * blockWidth * nbChannels];
+            for(std::ptrdiff_t i = 0; i < blockSize; i += nbChannels, ++srcIt)
+            {
+                PixelAccum pixel;
+                pixel_assigns_t<PIXEL_SRC_REF, PixelAccum>()(*srcIt, pixel);
+                const Channel* channels = reinterpret_cast<const Channel*>(&pixel);
+                std::copy(channels, channels + nbChannels, blockRow + i);
+            }
+        }
+
+        for(std::ptrdiff_t y = yBegin; y < yEnd; ++y)
+        {
+            const std::ptrdiff_t* rows = &srcRows[y - yBegin];
+            for(std::ptrdiff_t k = 0; k < kerSize; ++k)
+                srcs[k] = (rows[k] == kZeroRow) ? zeroRow : &block[(rows[k] - firstRow) * blockWidth * nbChannels];
+            weighted_sum(&srcs.front(), &weights.front(), kerSize, blockSize, &result.front());
+            assign_accum_from_float<PixelAccum>(&result.front(), blockSize / nbChannels, dst.row_begin(y) + x0,
+                                                IsFloat());
+        }
+    }
+}
+
 template <typename PixelAccum>
 class correlator_n
 {
 private:
     std::size_t _size;
+    correlate_buffers _buffers; ///< reused by the rows
 
 public:
     correlator_n(std::size_t size_in)
@@ -274,19 +425,22 @@ public:
     GIL_FORCEINLINE void operator()(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
                                     DstIterator dst_begin)
     {
-        correlate_pixels_n<PixelAccum>(src_begin, src_end, ker_begin, _size, dst_begin);
+        correlate_pixels_n<PixelAccum>(src_begin, src_end, ker_begin, _size, dst_begin, _buffers);
     }
 };
 
 template <std::size_t Size, typename PixelAccum>
 struct correlator_k
 {
+private:
+    correlate_buffers _buffers; ///< reused by the rows
+
 public:
     template <typename SrcIterator, typename KernelIterator, typename DstIterator>
     GIL_FORCEINLINE void operator()(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
                                     DstIterator dst_begin)
     {
-        correlate_pixels_k<Size, PixelAccum>(src_begin, src_end, ker_begin, dst_begin);
+        correlate_pixels_k<Size, PixelAccum>(src_begin, src_end, ker_begin, dst_begin, _buffers);
     }
 };
 
@@ -310,6 +464,30 @@ GIL_FORCEINLINE void correlate_1d_imp(const SrcView& src, const Kernel& ker, con
     correlate_rows_imp<PixelAccum>(src, ker, dst, dst_tl, option, detail::correlator_k<Kernel::static_size, PixelAccum>());
 }
 
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel along the columns of an image, as the rows of the transposed image
+template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView, typename Fixed>
+GIL_FORCEINLINE void correlate_cols_1d_imp(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                           const typename SrcView::point_t& dst_tl, const convolve_boundary_option option,
+                                           const Fixed fixed, const boost::mpl::false_ /*vectorized*/)
+{
+    correlate_1d_imp<PixelAccum>(transposed_view(src), ker, transposed_view(dst),
+                                 typename SrcView::point_t(dst_tl.y, dst_tl.x), option, boost::mpl::true_(), fixed);
+}
+
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel along the columns of an image, with vectorized weighted sums of rows
+template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView, typename Fixed>
+GIL_FORCEINLINE void correlate_cols_1d_imp(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                           const typename SrcView::point_t& dst_tl, const convolve_boundary_option option,
+                                           const Fixed fixed, const boost::mpl::true_ /*vectorized*/)
+{
+    if(ker.size() == 1)
+        correlate_cols_1d_imp<PixelAccum>(src, ker, dst, dst_tl, option, fixed, boost::mpl::false_());
+    else
+        correlate_cols_blocked<PixelAccum>(src, ker, dst, dst_tl, option);
+}
+
 /// @ingroup ImageAlgorithms
 /// correlate a 1D variable-size kernel along the columns of an image
 /// can be remove with "fixed" param as template argument
@@ -318,8 +496,8 @@ GIL_FORCEINLINE void correlate_1d_imp(const SrcView& src, const Kernel& ker, con
                                       const typename SrcView::point_t& dst_tl, const convolve_boundary_option option,
                                       const boost::mpl::false_ rows, const boost::mpl::false_ fixed)
 {
-    correlate_1d_imp<PixelAccum>(transposed_view(src), ker, transposed_view(dst),
-                                 typename SrcView::point_t(dst_tl.y, dst_tl.x), option, boost::mpl::true_(), fixed);
+    correlate_cols_1d_imp<PixelAccum>(src, ker, dst, dst_tl, option, fixed,
+                                      typename is_vectorized_correlation<PixelAccum, Kernel>::type());
 }
 
 /// @ingroup ImageAlgorithms
@@ -329,8 +507,8 @@ GIL_FORCEINLINE void correlate_1d_imp(const SrcView& src, const Kernel& ker, con
                                       const typename SrcView::point_t& dst_tl, const convolve_boundary_option option,
                                       const boost::mpl::false_ rows, const boost::mpl::true_ fixed)
 {
-    correlate_1d_imp<PixelAccum>(transposed_view(src), ker, transposed_view(dst),
-                                 typename SrcView::point_t(dst_tl.y, dst_tl.x), option, boost::mpl::true_(), fixed);
+    correlate_cols_1d_imp<PixelAccum>(src, ker, dst, dst_tl, option, fixed,
+                                      typename is_vectorized_correlation<PixelAccum, Kernel>::type());
 }
 
 /// @ingroup ImageAlgorithms
@@ -2,21 +2,152 @@
 #define _TERRY_FILTER_CORRELATE_HPP_
 
 #include "detail/inner_product.hpp"
+#include "detail/weighted_sum.hpp"
 
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/init.hpp>
 #include <terry/pixel_proxy.hpp>
 
+#include <boost/gil/typedefs.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace terry
 {
 namespace filter
 {
 
-/// @brief 1D un-guarded correlation with a variable-size kernel
+namespace detail
+{
+
+/// @brief Accumulation pixels whose channels are computed with float vectors: 32 bits float and 16 bits channels
+template <typename PixelAccum>
+struct is_vectorized_accum
+    : boost::mpl::or_<boost::is_same<typename channel_type<PixelAccum>::type, boost::gil::bits32f>,
+                      boost::is_same<typename channel_type<PixelAccum>::type, boost::gil::bits16> >
+{
+};
+
+/// @brief Correlations computed with weighted_sum: a vectorized accumulation pixel and a floating point kernel
+template <typename PixelAccum, typename Kernel>
+struct is_vectorized_correlation
+    : boost::mpl::and_<is_vectorized_accum<PixelAccum>, boost::is_floating_point<typename Kernel::value_type> >
+{
+};
+
+/// @brief The @p nbValues channels of a line of accumulation pixels as floats
+template <typename PixelAccum>
+const float* accum_channels_as_float(const PixelAccum* pixels, const std::size_t /*nbValues*/,
+                                     std::vector<float>& /*buffer*/, const boost::mpl::true_ /*float*/)
+{
+    return reinterpret_cast<const float*>(pixels);
+}
+
+template <typename PixelAccum>
+const float* accum_channels_as_float(const PixelAccum* pixels, const std::size_t nbValues, std::vector<float>& buffer,
+                                     const boost::mpl::false_ /*float*/)
+{
+    typedef typename channel_type<PixelAccum>::type Channel;
+    const Channel* channels = reinterpret_cast<const Channel*>(pixels);
+    buffer.resize(nbValues);
+    std::copy(channels, channels + nbValues, buffer.begin());
+    return &buffer.front();
+}
+
+/// @brief Assign the float results of weighted_sum to @p nbPixels pixels of the destination
+template <typename PixelAccum, typename DstIterator>
+DstIterator assign_accum_from_float(const float* values, const std::size_t nbPixels, DstIterator dst_begin,
+                                    const boost::mpl::true_ /*float*/)
+{
+    typedef typename pixel_proxy<typename std::iterator_traits<DstIterator>::value_type>::type PIXEL_DST_REF;
+    const PixelAccum* pixels = reinterpret_cast<const PixelAccum*>(values);
+    for(std::size_t i = 0; i < nbPixels; ++i, ++dst_begin)
+        terry::numeric::pixel_assigns_t<PixelAccum, PIXEL_DST_REF>()(pixels[i], *dst_begin);
+    return dst_begin;
+}
+
+/// @brief 16 bits channels are rounded and clamped once, on the accumulated value
+template <typename PixelAccum, typename DstIterator>
+DstIterator assign_accum_from_float(const float* values, const std::size_t nbPixels, DstIterator dst_begin,
+                                    const boost::mpl::false_ /*float*/)
+{
+    typedef typename pixel_proxy<typename std::iterator_traits<DstIterator>::value_type>::type PIXEL_DST_REF;
+    typedef typename channel_type<PixelAccum>::type Channel;
+    static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+    PixelAccum pixel;
+    Channel* channels = reinterpret_cast<Channel*>(&pixel);
+    for(std::size_t i = 0; i < nbPixels; ++i, ++dst_begin, values += nbChannels)
+    {
+        for(std::size_t c = 0; c < nbChannels; ++c)
+            channels[c] = static_cast<Channel>(std::min(std::max(values[c] + 0.5f, 0.0f), 65535.0f));
+        terry::numeric::pixel_assigns_t<PixelAccum, PIXEL_DST_REF>()(pixel, *dst_begin);
+    }
+    return dst_begin;
+}
+
+/**
+ * @brief Buffers of the vectorized correlation of a line.
+ * The correlators keep them between the rows of an image, so the rows don't allocate once the first one is done.
+ */
+struct correlate_buffers
+{
+    std::vector<float> _src;
+    std::vector<const float*> _srcs;
+    std::vector<float> _weights;
+    std::vector<float> _result;
+};
+
+/**
+ * @brief 1D un-guarded correlation of a line of accumulation pixels, computed in float vectors with weighted_sum.
+ * Each kernel value multiplies the line shifted by one pixel, the channels of the pixels are processed as a flat array.
+ */
+template <typename PixelAccum, typename KernelIterator, typename DstIterator>
+DstIterator correlate_pixels_vectorized(const PixelAccum* src_begin, const PixelAccum* src_end, KernelIterator ker_begin,
+                                        const std::size_t ker_size, DstIterator dst_begin, correlate_buffers& buffers)
+{
+    typedef boost::is_same<typename channel_type<PixelAccum>::type, boost::gil::bits32f> IsFloat;
+    static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+
+    const std::size_t nbPixels = src_end - src_begin;
+    if(nbPixels == 0)
+        return dst_begin;
+
+    const float* src =
+        accum_channels_as_float(src_begin, (nbPixels + ker_size - 1) * nbChannels, buffers._src, IsFloat());
+    buffers._srcs.resize(ker_size);
+    buffers._weights.resize(ker_size);
+    for(std::size_t k = 0; k < ker_size; ++k, ++ker_begin)
+    {
+        buffers._srcs[k] = src + k * nbChannels;
+        buffers._weights[k] = static_cast<float>(*ker_begin);
+    }
+    buffers._result.resize(nbPixels * nbChannels);
+    weighted_sum(&buffers._srcs.front(), &buffers._weights.front(), ker_size, buffers._result.size(),
+                 &buffers._result.front());
+    return assign_accum_from_float<PixelAccum>(&buffers._result.front(), nbPixels, dst_begin, IsFloat());
+}
+
 template <typename PixelAccum, typename SrcIterator, typename KernelIterator, typename Integer, typename DstIterator>
-GIL_FORCEINLINE DstIterator correlate_pixels_n(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
-                                               Integer ker_size, DstIterator dst_begin)
+GIL_FORCEINLINE DstIterator correlate_pixels_n_imp(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                                   Integer ker_size, DstIterator dst_begin, correlate_buffers& buffers,
+                                                   const boost::mpl::true_ /*vectorized*/)
+{
+    return correlate_pixels_vectorized<PixelAccum>(src_begin, src_end, ker_begin, ker_size, dst_begin, buffers);
+}
+
+template <typename PixelAccum, typename SrcIterator, typename KernelIterator, typename Integer, typename DstIterator>
+GIL_FORCEINLINE DstIterator correlate_pixels_n_imp(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                                   Integer ker_size, DstIterator dst_begin,
+                                                   correlate_buffers& /*buffers*/,
+                                                   const boost::mpl::false_ /*vectorized*/)
 {
     using namespace terry::numeric;
 
@@ -39,10 +170,18 @@ GIL_FORCEINLINE DstIterator correlate_pixels_n(SrcIterator src_begin, SrcIterato
     return dst_begin;
 }
 
-/// @brief 1D un-guarded correlation with a fixed-size kernel
 template <std::size_t Size, typename PixelAccum, typename SrcIterator, typename KernelIterator, typename DstIterator>
-GIL_FORCEINLINE DstIterator correlate_pixels_k(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
-                                               DstIterator dst_begin)
+GIL_FORCEINLINE DstIterator correlate_pixels_k_imp(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                                   DstIterator dst_begin, correlate_buffers& buffers,
+                                                   const boost::mpl::true_ /*vectorized*/)
+{
+    return correlate_pixels_vectorized<PixelAccum>(src_begin, src_end, ker_begin, Size, dst_begin, buffers);
+}
+
+template <std::size_t Size, typename PixelAccum, typename SrcIterator, typename KernelIterator, typename DstIterator>
+GIL_FORCEINLINE DstIterator correlate_pixels_k_imp(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                                   DstIterator dst_begin, correlate_buffers& /*buffers*/,
+                                                   const boost::mpl::false_ /*vectorized*/)
 {
     using namespace terry::numeric;
 
@@ -63,6 +202,54 @@ GIL_FORCEINLINE DstIterator correlate_pixels_k(SrcIterator src_begin, SrcIterato
     }
     return dst_begin;
 }
+
+/// @brief The vectorized correlation reads the temporary line of accumulation pixels filled by correlate_rows_imp
+template <typename PixelAccum, typename SrcIterator, typename KernelIterator>
+struct use_vectorized_correlation
+    : boost::mpl::and_<is_vectorized_accum<PixelAccum>, boost::is_same<SrcIterator, PixelAccum*>,
+                       boost::is_floating_point<typename std::iterator_traits<KernelIterator>::value_type> >
+{
+};
+}
+
+/// @brief 1D un-guarded correlation with a variable-size kernel, reusing the buffers of the previous lines
+template <typename PixelAccum, typename SrcIterator, typename KernelIterator, typename Integer, typename DstIterator>
+GIL_FORCEINLINE DstIterator correlate_pixels_n(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                               Integer ker_size, DstIterator dst_begin,
+                                               detail::correlate_buffers& buffers)
+{
+    typedef typename detail::use_vectorized_correlation<PixelAccum, SrcIterator, KernelIterator>::type Vectorized;
+    return detail::correlate_pixels_n_imp<PixelAccum>(src_begin, src_end, ker_begin, ker_size, dst_begin, buffers,
+                                                      Vectorized());
+}
+
+/// @brief 1D un-guarded correlation with a variable-size kernel
+template <typename PixelAccum, typename SrcIterator, typename KernelIterator, typename Integer, typename DstIterator>
+GIL_FORCEINLINE DstIterator correlate_pixels_n(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                               Integer ker_size, DstIterator dst_begin)
+{
+    detail::correlate_buffers buffers;
+    return correlate_pixels_n<PixelAccum>(src_begin, src_end, ker_begin, ker_size, dst_begin, buffers);
+}
+
+/// @brief 1D un-guarded correlation with a fixed-size kernel, reusing the buffers of the previous lines
+template <std::size_t Size, typename PixelAccum, typename SrcIterator, typename KernelIterator, typename DstIterator>
+GIL_FORCEINLINE DstIterator correlate_pixels_k(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                               DstIterator dst_begin, detail::correlate_buffers& buffers)
+{
+    typedef typename detail::use_vectorized_correlation<PixelAccum, SrcIterator, KernelIterator>::type Vectorized;
+    return detail::correlate_pixels_k_imp<Size, PixelAccum>(src_begin, src_end, ker_begin, dst_begin, buffers,
+                                                            Vectorized());
+}
+
+/// @brief 1D un-guarded correlation with a fixed-size kernel
+template <std::size_t Size, typename PixelAccum, typename SrcIterator, typename KernelIterator, typename DstIterator>
+GIL_FORCEINLINE DstIterator correlate_pixels_k(SrcIterator src_begin, SrcIterator src_end, KernelIterator ker_begin,
+                                               DstIterator dst_begin)
+{
+    detail::correlate_buffers buffers;
+    return correlate_pixels_k<Size, PixelAccum>(src_begin, src_end, ker_begin, dst_begin, buffers);
+}
 }
 }
 
@@ -0,0 +1,127 @@
+#ifndef _TERRY_FILTER_DETAIL_WEIGHTED_SUM_HPP_
+#define _TERRY_FILTER_DETAIL_WEIGHTED_SUM_HPP_
+
+#include <terry/simd.hpp>
+
+#include <cstddef>
+
+namespace terry
+{
+namespace filter
+{
+namespace detail
+{
+
+using terry::ESimdLevel;
+using terry::eSimdNone;
+using terry::eSimdSSE2;
+using terry::eSimdAVX2;
+using terry::simd_level;
+
+/**
+ * @brief dst[i] = sum of weights[k] * srcs[k][i] for k in [0, nbSrcs), for i in [0, size)
+ *
+ * The correlation of a row is the weighted sum of the row shifted by one pixel for each kernel value,
+ * the correlation of the columns is the weighted sum of the rows of the window.
+ */
+inline void weighted_sum_scalar(const float* const* srcs, const float* weights, const std::size_t nbSrcs,
+                                const std::size_t begin, const std::size_t size, float* dst)
+{
+    for(std::size_t i = begin; i < size; ++i)
+    {
+        float acc = 0.0f;
+        for(std::size_t k = 0; k < nbSrcs; ++k)
+            acc += weights[k] * srcs[k][i];
+        dst[i] = acc;
+    }
+}
+
+#ifdef TERRY_SIMD_X86
+inline void weighted_sum_sse2(const float* const* srcs, const float* weights, const std::size_t nbSrcs,
+                              const std::size_t size, float* dst)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for(std::size_t k = 0; k < nbSrcs; ++k)
+        {
+            const __m128 w = _mm_set1_ps(weights[k]);
+            const float* src = srcs[k] + i;
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, _mm_loadu_ps(src)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, _mm_loadu_ps(src + 4)));
+        }
+        _mm_storeu_ps(dst + i, acc0);
+        _mm_storeu_ps(dst + i + 4, acc1);
+    }
+    for(; i + 4 <= size; i += 4)
+    {
+        __m128 acc = _mm_setzero_ps();
+        for(std::size_t k = 0; k < nbSrcs; ++k)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(srcs[k] + i)));
+        _mm_storeu_ps(dst + i, acc);
+    }
+    weighted_sum_scalar(srcs, weights, nbSrcs, i, size, dst);
+}
+
+TERRY_TARGET_AVX2
+inline void weighted_sum_avx2(const float* const* srcs, const float* weights, const std::size_t nbSrcs,
+                              const std::size_t size, float* dst)
+{
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16)
+    {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for(std::size_t k = 0; k < nbSrcs; ++k)
+        {
+            const __m256 w = _mm256_set1_ps(weights[k]);
+            const float* src = srcs[k] + i;
+            acc0 = _mm256_fmadd_ps(w, _mm256_loadu_ps(src), acc0);
+            acc1 = _mm256_fmadd_ps(w, _mm256_loadu_ps(src + 8), acc1);
+        }
+        _mm256_storeu_ps(dst + i, acc0);
+        _mm256_storeu_ps(dst + i + 8, acc1);
+    }
+    for(; i + 8 <= size; i += 8)
+    {
+        __m256 acc = _mm256_setzero_ps();
+        for(std::size_t k = 0; k < nbSrcs; ++k)
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(srcs[k] + i), acc);
+        _mm256_storeu_ps(dst + i, acc);
+    }
+    weighted_sum_scalar(srcs, weights, nbSrcs, i, size, dst);
+}
+#endif
+
+/**
+ * @brief Weighted sum with the best instruction set of the running CPU.
+ * @see weighted_sum_scalar
+ */
+inline void weighted_sum(const float* const* srcs, const float* weights, const std::size_t nbSrcs, const std::size_t size,
+                         float* dst, const ESimdLevel level = simd_level())
+{
+    switch(level)
+    {
+#ifdef TERRY_SIMD_X86
+        case eSimdAVX2:
+            weighted_sum_avx2(srcs, weights, nbSrcs, size, dst);
+            return;
+        case eSimdSSE2:
+            weighted_sum_sse2(srcs, weights, nbSrcs, size, dst);
+            return;
+#else
+        case eSimdAVX2:
+        case eSimdSSE2:
+#endif
+        case eSimdNone:
+            break;
+    }
+    weighted_sum_scalar(srcs, weights, nbSrcs, 0, size, dst);
+}
+}
+}
+}
+
+#endif
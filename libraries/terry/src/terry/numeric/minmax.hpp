@@ -94,6 +94,13 @@ struct pixel_minmax_by_channel_t
         pixel_assign_min_t<Pixel, CPixel>()(v, min);
         pixel_assign_max_t<Pixel, CPixel>()(v, max);
     }
+
+    /// Add the min and max of other pixels, for reductions in parallel
+    void merge(const pixel_minmax_by_channel_t& other)
+    {
+        pixel_assign_min_t<CPixel, CPixel>()(other.min, min);
+        pixel_assign_max_t<CPixel, CPixel>()(other.max, max);
+    }
 };
 }
 }
@@ -0,0 +1,109 @@
+#ifndef _TERRY_NUMERIC_MOMENTS_HPP_
+#define _TERRY_NUMERIC_MOMENTS_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+namespace terry
+{
+namespace numeric
+{
+
+/**
+ * @brief Number of values, mean and sums of the powers 2 to 4 of the deviations from the mean, for each channel.
+ *
+ * The moments of a block of values are computed in two passes, around their mean, then the blocks are merged with
+ * the pairwise formulas of Chan et al. and Pebay. Unlike the sums of the powers of the values, it doesn't lose the
+ * precision of the variance when the mean is large compared to the deviations.
+ * [Pebay, "Formulas for robust, one-pass parallel computation of covariances and arbitrary-order statistical
+ * moments", Sandia Report SAND2008-6212]
+ */
+template <std::size_t NbChannels>
+struct channel_moments
+{
+    double _count;
+    double _mean[NbChannels];
+    double _m2[NbChannels];
+    double _m3[NbChannels];
+    double _m4[NbChannels];
+
+    channel_moments()
+        : _count(0.0)
+    {
+        for(std::size_t c = 0; c < NbChannels; ++c)
+            _mean[c] = _m2[c] = _m3[c] = _m4[c] = 0.0;
+    }
+
+    /**
+     * @brief Moments of @p nbValues values of each channel.
+     * @param[in] values interleaved channels, NbChannels * nbValues doubles
+     */
+    channel_moments(const double* values, const std::size_t nbValues)
+        : _count(nbValues)
+    {
+        for(std::size_t c = 0; c < NbChannels; ++c)
+            _mean[c] = _m2[c] = _m3[c] = _m4[c] = 0.0;
+        if(nbValues == 0)
+            return;
+
+        const double* end = values + nbValues * NbChannels;
+        for(const double* v = values; v != end; v += NbChannels)
+            for(std::size_t c = 0; c < NbChannels; ++c)
+                _mean[c] += v[c];
+        for(std::size_t c = 0; c < NbChannels; ++c)
+            _mean[c] /= _count;
+
+        for(const double* v = values; v != end; v += NbChannels)
+        {
+            for(std::size_t c = 0; c < NbChannels; ++c)
+            {
+                const double d = v[c] - _mean[c];
+                const double d2 = d * d;
+                _m2[c] += d2;
+                _m3[c] += d2 * d;
+                _m4[c] += d2 * d2;
+            }
+        }
+    }
+
+    /// Add the moments of other values
+    void merge(const channel_moments& other)
+    {
+        if(other._count == 0.0)
+            return;
+        if(_count == 0.0)
+        {
+            *this = other;
+            return;
+        }
+        const double na = _count;
+        const double nb = other._count;
+        const double n = na + nb;
+        for(std::size_t c = 0; c < NbChannels; ++c)
+        {
+            const double delta = other._mean[c] - _mean[c];
+            const double deltaN = delta / n;
+            const double deltaN2 = deltaN * deltaN;
+            const double term = delta * deltaN * na * nb;
+            _m4[c] += other._m4[c] + term * deltaN2 * (na * na - na * nb + nb * nb) +
+                      6.0 * deltaN2 * (na * na * other._m2[c] + nb * nb * _m2[c]) +
+                      4.0 * deltaN * (na * other._m3[c] - nb * _m3[c]);
+            _m3[c] += other._m3[c] + term * deltaN * (na - nb) + 3.0 * deltaN * (na * other._m2[c] - nb * _m2[c]);
+            _m2[c] += other._m2[c] + term;
+            _mean[c] += nb * deltaN;
+        }
+        _count = n;
+    }
+
+    double mean(const std::size_t c) const { return _mean[c]; }
+    /// Population variance
+    double variance(const std::size_t c) const { return _m2[c] / _count; }
+    double standardDeviation(const std::size_t c) const { return std::sqrt(variance(c)); }
+    double skewness(const std::size_t c) const { return (_m3[c] / _count) / std::pow(standardDeviation(c), 3); }
+    /// Excess kurtosis, 0 for a normal distribution
+    double kurtosis(const std::size_t c) const { return (_m4[c] / _count) / std::pow(variance(c), 2) - 3.0; }
+};
+}
+}
+
+#endif
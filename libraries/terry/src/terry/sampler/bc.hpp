@@ -9,7 +9,7 @@ using namespace boost::gil;
 namespace sampler
 {
 
-struct bc_sampler
+struct bc_sampler : public tabulated_sampler
 {
     const size_t _windowSize;
     const RESAMPLING_CORE_TYPE _valB;
@@ -21,6 +21,7 @@ struct bc_sampler
         _valB(0.0)
         , _valC(0.0)
     {
+        buildWeightTable(*this);
     }
 
     bc_sampler(RESAMPLING_CORE_TYPE valB, RESAMPLING_CORE_TYPE valC)
@@ -29,6 +30,7 @@ struct bc_sampler
         _valB(valB)
         , _valC(valC)
     {
+        buildWeightTable(*this);
     }
 
     /**
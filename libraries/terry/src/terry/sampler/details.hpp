@@ -11,8 +11,14 @@
 
 #include <terry/typedefs.hpp>
 
+#include "weight_table.hpp"
+
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/assert.hpp>
+
 #include <cmath>
-#include <vector>
+#include <iterator>
 
 namespace terry
 {
@@ -49,210 +55,123 @@ struct add_dst_mul_src
     }
 };
 
+/// Float RGBA, converts the source channels without the generic channel conversion
+template <>
+struct add_dst_mul_src<rgba32f_pixel_t, bits64f, rgba32f_pixel_t>
+{
+    void operator()(const rgba32f_pixel_t& src, const bits64f weight, rgba32f_pixel_t& dst) const
+    {
+        dst[0] += bits32f(src[0] * weight);
+        dst[1] += bits32f(src[1] * weight);
+        dst[2] += bits32f(src[2] * weight);
+        dst[3] += bits32f(src[3] * weight);
+    }
+};
+
+/// Max number of pixels in the window of a sampler (a Lanczos filter of size 30 uses 60 pixels)
+static const std::size_t kMaxWindowSize = 64;
+
 /**
- * @brief Get pixels around a particular position.
- * @param[in] loc locator which points to a pixel
- * @param[in] pt0 x,y position of loc
- * @param[in] windowWidth the region inside which we search our pixels
- * @param[out] ptN pixel value to retrieve
- *
- * it's to use with (B,C) filter
- * number of points need to be even
- *
- * -----------------
- * | A | B | C | D |
- * -----------------
- *       ^..... loc is pointing to D point
+ * @brief Get the weights of the window pixels, for a position at @p frac pixels after the pixel middlePosition.
  */
-template <typename xy_locator, typename SrcP>
-void getPixelsPointers(const xy_locator& loc, const point2<std::ptrdiff_t>& p0, const int& windowWidth,
-                       const int& imageWidth, const EParamFilterOutOfImage& outOfImageProcess, std::vector<SrcP>& src)
+template <typename Sampler, typename Weight>
+void computeWeights(Sampler& sampler, const RESAMPLING_CORE_TYPE frac, const std::size_t middlePosition,
+                    Weight* weights, const boost::false_type /*isTabulated*/)
 {
-    int middlePosition = floor((src.size() - 1) * 0.5);
-
-    if((p0.x < 0) || (p0.x > imageWidth - 1))
+    for(std::size_t i = 0; i < sampler._windowSize; i++)
     {
-        switch(outOfImageProcess)
-        {
-            case eParamFilterOutBlack:
-            {
-                src.at(middlePosition) = get_black<SrcP>();
-                break;
-            }
-            case eParamFilterOutTransparency:
-            {
-                src.at(middlePosition) = SrcP(0);
-                break;
-            }
-            case eParamFilterOutCopy:
-            {
-                src.at(middlePosition) = loc.x()[(p0.x < 0) ? (-p0.x) : -1 - p0.x + imageWidth];
-                break;
-            }
-            case eParamFilterOutMirror:
-            {
-                src.at(middlePosition) = SrcP(0);
-                break;
-            }
-        }
+        RESAMPLING_CORE_TYPE distance = -frac - middlePosition + i;
+        sampler(distance, weights[i]);
     }
-    else
+}
+
+template <typename Sampler, typename Weight>
+void computeWeights(Sampler& sampler, const RESAMPLING_CORE_TYPE frac, const std::size_t /*middlePosition*/,
+                    Weight* weights, const boost::true_type /*isTabulated*/)
+{
+    sampler._weightTable->getWeights(frac, weights);
+}
+
+/**
+ * @brief Weighted sum of the pixels inside the image.
+ */
+template <typename XIterator, typename Weight, typename DstP>
+void filterPixels(XIterator it, const Weight* weights, const std::size_t windowSize, DstP& dst)
+{
+    typedef typename std::iterator_traits<XIterator>::value_type SrcP;
+    for(std::size_t i = 0; i < windowSize; ++i, ++it)
+        add_dst_mul_src<SrcP, Weight, DstP>()(*it, weights[i], dst);
+}
+
+/// Float RGBA, with the channels kept in registers
+inline void filterPixels(const rgba32f_pixel_t* it, const bits64f* weights, const std::size_t windowSize,
+                         rgba32f_pixel_t& dst)
+{
+    float r = dst[0], g = dst[1], b = dst[2], a = dst[3];
+    for(std::size_t i = 0; i < windowSize; ++i, ++it)
     {
-        src.at(middlePosition) = *loc;
+        const bits64f weight = weights[i];
+        r += float((*it)[0] * weight);
+        g += float((*it)[1] * weight);
+        b += float((*it)[2] * weight);
+        a += float((*it)[3] * weight);
     }
+    dst = rgba32f_pixel_t(r, g, b, a);
+}
+
+inline void filterPixels(rgba32f_pixel_t* it, const bits64f* weights, const std::size_t windowSize,
+                         rgba32f_pixel_t& dst)
+{
+    filterPixels(static_cast<const rgba32f_pixel_t*>(it), weights, windowSize, dst);
+}
+
+/**
+ * @brief Weighted sum of the window pixels of the row @p y, starting at the column @p x0.
+ *
+ * Columns outside of the image are black, transparent or a copy of the closest border pixel (mirror is not
+ * implemented and gives transparent pixels).
+ */
+template <typename SrcView, typename Weight, typename DstP>
+void filterRow(const SrcView& src, const std::ptrdiff_t x0, const std::ptrdiff_t y, const Weight* weights,
+               const std::size_t windowSize, const EParamFilterOutOfImage outOfImageProcess, DstP& dst)
+{
+    typedef typename SrcView::value_type SrcP;
+    typedef add_dst_mul_src<SrcP, Weight, DstP> AddDstMulSrc;
+
+    const std::ptrdiff_t width = src.width();
+    typename SrcView::x_iterator it = src.row_begin(y);
 
-    // from center to left
-    for(int i = middlePosition - 1; i > -1; i--)
+    DstP mp(0);
+    if(x0 >= 0 && x0 + static_cast<std::ptrdiff_t>(windowSize) <= width)
     {
-        if((p0.x - (middlePosition - i) > -1))
-        {
-            if((p0.x - (middlePosition - i) < imageWidth))
-            {
-                src.at(i) = loc.x()[-(middlePosition - i)];
-            }
-            else
-            {
-                switch(outOfImageProcess)
-                {
-                    case eParamFilterOutBlack:
-                    {
-                        src.at(i) = get_black<SrcP>();
-                        break;
-                    }
-                    case eParamFilterOutTransparency:
-                    {
-                        src.at(i) = SrcP(0);
-                        break;
-                    }
-                    case eParamFilterOutCopy:
-                    {
-                        src.at(i) = src.at(i + 1);
-                        break;
-                    }
-                    case eParamFilterOutMirror:
-                    {
-                        src.at(i) = SrcP(0);
-                        break;
-                    }
-                };
-            }
-        }
-        else
-        {
-            switch(outOfImageProcess)
-            {
-                case eParamFilterOutBlack:
-                {
-                    src.at(i) = get_black<SrcP>();
-                    break;
-                }
-                case eParamFilterOutTransparency:
-                {
-                    src.at(i) = SrcP(0);
-                    break;
-                }
-                case eParamFilterOutCopy:
-                {
-                    src.at(i) = src.at(i + 1);
-                    break;
-                }
-                case eParamFilterOutMirror:
-                {
-                    src.at(i) = SrcP(0);
-                    break;
-                }
-            };
-        }
+        filterPixels(it + x0, weights, windowSize, mp);
     }
-
-    // from center to right
-    for(int i = middlePosition + 1; i < (int)src.size(); i++)
+    else
     {
-        if((p0.x - (middlePosition - i) < imageWidth))
+        const SrcP outPixel = (outOfImageProcess == eParamFilterOutBlack) ? get_black<SrcP>() : SrcP(0);
+        for(std::size_t i = 0; i < windowSize; ++i)
         {
-            if(p0.x - (middlePosition - i) < 0)
-            {
-                switch(outOfImageProcess)
-                {
-                    case eParamFilterOutBlack:
-                    {
-                        src.at(i) = get_black<SrcP>();
-                        break;
-                    }
-                    case eParamFilterOutTransparency:
-                    {
-                        src.at(i) = SrcP(0);
-                        break;
-                    }
-                    case eParamFilterOutCopy:
-                    {
-                        src.at(i) = src.at(i - 1);
-                        break;
-                    }
-                    case eParamFilterOutMirror:
-                    {
-                        src.at(i) = SrcP(0);
-                        break;
-                    }
-                };
-            }
+            const std::ptrdiff_t x = x0 + static_cast<std::ptrdiff_t>(i);
+            if(x >= 0 && x < width)
+                AddDstMulSrc()(it[x], weights[i], mp);
+            else if(outOfImageProcess == eParamFilterOutCopy)
+                AddDstMulSrc()(it[(x < 0) ? 0 : width - 1], weights[i], mp);
             else
-            {
-                src.at(i) = loc.x()[-(middlePosition - i)];
-            }
-        }
-        else
-        {
-            switch(outOfImageProcess)
-            {
-                case eParamFilterOutBlack:
-                {
-                    src.at(i) = get_black<SrcP>();
-                    break;
-                }
-                case eParamFilterOutTransparency:
-                {
-                    src.at(i) = SrcP(0);
-                    break;
-                }
-                case eParamFilterOutCopy:
-                {
-                    src.at(i) = src.at(i - 1);
-                    break;
-                }
-                case eParamFilterOutMirror:
-                {
-                    src.at(i) = SrcP(0);
-                    break;
-                }
-            };
+                AddDstMulSrc()(outPixel, weights[i], mp);
         }
     }
+    dst = mp;
 }
-
-template <typename SrcP, typename Weight, typename DstP>
-struct process1Dresampling
-{
-    void operator()(const std::vector<SrcP>& src, const std::vector<Weight>& weight, DstP& dst) const
-    {
-        DstP mp(0);
-        for(std::size_t i = 0; i < src.size(); i++)
-            details::add_dst_mul_src<SrcP, Weight, DstP>()(src.at(i), weight.at(i), mp);
-        dst = mp;
-    }
-};
-
-/// @todo specialization for SIMD
-// template <typename F>
-// struct process1Dresampling
-//{
-//	void operator()( const std::vector<rgba32f_t> src, const std::vector<F> weight, rgba32f_t & dst ) const
-//	{
-//		//...
-//	}
-//};
 }
 
+/**
+ * @brief Sample the source view at the position @p p with a separable filter.
+ *
+ * The window of pixels, the weights and the rows filtered horizontally are kept in fixed size arrays, so no memory
+ * is allocated for each pixel. The weights of a tabulated_sampler come from its precomputed table.
+ *
+ * @return false if the window of the sampler is bigger than details::kMaxWindowSize.
+ */
 template <typename Sampler, typename DstP, typename SrcView, typename F>
 bool sample(Sampler& sampler, const SrcView& src, const point2<F>& p, DstP& result,
             const EParamFilterOutOfImage outOfImageProcess)
@@ -260,14 +179,18 @@ bool sample(Sampler& sampler, const SrcView& src, const point2<F>& p, DstP& resu
     typedef typename SrcView::value_type SrcP;
     typedef typename floating_pixel_from_view<SrcView>::type SrcC; // PixelFloat;
     typedef typename boost::gil::bits64f Weight;
-    typedef typename SrcView::xy_locator xy_locator;
+    typedef typename boost::is_base_of<tabulated_sampler, Sampler>::type IsTabulated;
 
-    // xWeights and yWeights are weights for in relation of the distance to each point
-    std::vector<Weight> xWeights, yWeights;
+    const std::size_t windowSize = sampler._windowSize;
+    BOOST_ASSERT(windowSize <= details::kMaxWindowSize);
+    if(windowSize > details::kMaxWindowSize)
+        return false;
 
-    SrcC mp(0);
-    std::vector<SrcP> ptr;
-    std::vector<SrcC> xProcessed;
+    // xWeights and yWeights are weights for in relation of the distance to each point
+    Weight xWeights[details::kMaxWindowSize];
+    Weight yWeights[details::kMaxWindowSize];
+    // rows of the window filtered horizontally
+    SrcC xProcessed[details::kMaxWindowSize];
 
     /*
      * pTL is the closest integer coordinate top left from p
@@ -279,220 +202,84 @@ bool sample(Sampler& sampler, const SrcView& src, const point2<F>& p, DstP& resu
      */
     point2<std::ptrdiff_t> pTL(ifloor(p));
 
-    // loc is the point in the source view
-    xy_locator loc = src.xy_at(pTL.x, pTL.y);
     // frac is the distance between the point pTL and the current point
     point2<RESAMPLING_CORE_TYPE> frac(p.x - pTL.x, p.y - pTL.y);
 
-    // assign Weights vector to the window size of the sampler
-    xWeights.assign(sampler._windowSize, 0);
-    yWeights.assign(sampler._windowSize, 0);
-
-    ptr.assign(sampler._windowSize, SrcP(0));
-    xProcessed.assign(sampler._windowSize, SrcC(0));
-
     // compute the middle position on the filter
-    std::size_t middlePosition = floor((sampler._windowSize - 1.0) * 0.5);
+    const std::size_t middlePosition = floor((windowSize - 1.0) * 0.5);
 
     // get weights for each pixels
-    for(size_t i = 0; i < sampler._windowSize; i++)
-    {
-        RESAMPLING_CORE_TYPE distancex = -frac.x - middlePosition + i;
-        sampler(distancex, xWeights.at(i));
-        RESAMPLING_CORE_TYPE distancey = -frac.y - middlePosition + i;
-        sampler(distancey, yWeights.at(i));
-    }
-    /*
-            for( int i=0; i<xWeights.size(); i++ )
-            {
-                    std::cout << xWeights.at(i) << "\t" ;
-            }
-            std::cout << std::endl;
-            */
+    details::computeWeights(sampler, frac.x, middlePosition, xWeights, IsTabulated());
+    details::computeWeights(sampler, frac.y, middlePosition, yWeights, IsTabulated());
+
+    const std::ptrdiff_t x0 = pTL.x - static_cast<std::ptrdiff_t>(middlePosition);
+    const std::ptrdiff_t height = src.height();
+
     // first process the middle point
     // if it's mirrored, we need to copy the center point
-    if((pTL.y < 0.0) || (pTL.y > (int)(src.height() - 1.0)))
+    if((pTL.y < 0) || (pTL.y > height - 1))
     {
-        if(pTL.y < 0.0) // under the image
+        switch(outOfImageProcess)
         {
-            switch(outOfImageProcess)
+            case eParamFilterOutBlack:
             {
-                case eParamFilterOutBlack:
-                {
-                    xProcessed.at(middlePosition) = get_black<DstP>();
-                    break;
-                }
-                case eParamFilterOutTransparency:
-                {
-                    xProcessed.at(middlePosition) = SrcP(0);
-                    break;
-                }
-                case eParamFilterOutCopy:
-                {
-                    loc.y() -= pTL.y;
-                    details::getPixelsPointers(loc, pTL, sampler._windowSize, src.width(), outOfImageProcess, ptr);
-                    details::process1Dresampling<SrcP, Weight, SrcC>()(ptr, xWeights, xProcessed.at(middlePosition));
-                    loc.y() += pTL.y;
-                    break;
-                }
-                case eParamFilterOutMirror:
-                {
-                    xProcessed.at(middlePosition) = SrcP(1);
-                    break;
-                }
+                xProcessed[middlePosition] = get_black<DstP>();
+                break;
             }
-        }
-        else // upper the image
-        {
-            // TUTTLE_LOG_INFO( src.height() << " @@ " << (pTL.y - src.height() ) );
-            switch(outOfImageProcess)
+            case eParamFilterOutTransparency:
             {
-                case eParamFilterOutBlack:
-                {
-                    xProcessed.at(middlePosition) = get_black<DstP>();
-                    break;
-                }
-                case eParamFilterOutTransparency:
-                {
-                    xProcessed.at(middlePosition) = SrcP(0);
-                    break;
-                }
-                case eParamFilterOutCopy:
-                {
-                    loc.y() -= pTL.y - src.height() + 1.0;
-                    details::getPixelsPointers(loc, pTL, sampler._windowSize, src.width(), outOfImageProcess, ptr);
-                    details::process1Dresampling<SrcP, Weight, SrcC>()(ptr, xWeights, xProcessed.at(middlePosition));
-                    loc.y() += pTL.y - src.height() + 1.0;
-                    break;
-                }
-                case eParamFilterOutMirror:
-                {
-                    xProcessed.at(middlePosition) = SrcP(1);
-                    break;
-                }
+                xProcessed[middlePosition] = SrcP(0);
+                break;
+            }
+            case eParamFilterOutCopy:
+            {
+                details::filterRow(src, x0, (pTL.y < 0) ? 0 : height - 1, xWeights, windowSize, outOfImageProcess,
+                                   xProcessed[middlePosition]);
+                break;
+            }
+            case eParamFilterOutMirror:
+            {
+                xProcessed[middlePosition] = SrcP(1);
+                break;
             }
         }
     }
     else
     {
-        details::getPixelsPointers(loc, pTL, sampler._windowSize, src.width(), outOfImageProcess, ptr);
-        details::process1Dresampling<SrcP, Weight, SrcC>()(ptr, xWeights, xProcessed.at(middlePosition));
+        details::filterRow(src, x0, pTL.y, xWeights, windowSize, outOfImageProcess, xProcessed[middlePosition]);
     }
 
     // from center to bottom
-    for(int i = middlePosition - 1; i > -1; i--)
+    for(std::ptrdiff_t i = static_cast<std::ptrdiff_t>(middlePosition) - 1; i > -1; i--)
     {
-        if((int)(pTL.y - (middlePosition - i)) < (int)src.height())
-        {
-            if((int)(pTL.y - (middlePosition - i)) < 0)
-            {
-                switch(outOfImageProcess)
-                {
-                    case eParamFilterOutBlack:
-                    {
-                        xProcessed.at(i) = get_black<DstP>();
-                        break;
-                    }
-                    case eParamFilterOutTransparency:
-                    {
-                        xProcessed.at(i) = SrcP(0);
-                        break;
-                    }
-                    case eParamFilterOutCopy:
-                    {
-                        xProcessed.at(i) = xProcessed.at(i + 1);
-                        break;
-                    }
-                    case eParamFilterOutMirror:
-                    {
-                        xProcessed.at(i) = xProcessed.at(i + 1);
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                loc.y() -= (middlePosition - i);
-                details::getPixelsPointers(loc, pTL, sampler._windowSize, src.width(), outOfImageProcess, ptr);
-                details::process1Dresampling<SrcP, Weight, SrcC>()(ptr, xWeights, xProcessed.at(i));
-                loc.y() += (middlePosition - i);
-            }
-        }
+        const std::ptrdiff_t y = pTL.y - (static_cast<std::ptrdiff_t>(middlePosition) - i);
+        if(y >= 0 && y < height)
+            details::filterRow(src, x0, y, xWeights, windowSize, outOfImageProcess, xProcessed[i]);
+        else if(outOfImageProcess == eParamFilterOutBlack)
+            xProcessed[i] = get_black<DstP>();
+        else if(outOfImageProcess == eParamFilterOutTransparency)
+            xProcessed[i] = SrcP(0);
         else
-        {
-            switch(outOfImageProcess)
-            {
-                case eParamFilterOutBlack:
-                {
-                    xProcessed.at(i) = get_black<DstP>();
-                    break;
-                }
-                case eParamFilterOutTransparency:
-                {
-                    xProcessed.at(i) = SrcP(0);
-                    break;
-                }
-                case eParamFilterOutCopy:
-                {
-                    xProcessed.at(i) = xProcessed.at(i + 1);
-                    break;
-                }
-                case eParamFilterOutMirror:
-                {
-                    xProcessed.at(i) = xProcessed.at(i + 1);
-                    break;
-                }
-            }
-        }
+            xProcessed[i] = xProcessed[i + 1];
     }
 
     // from center to top
-    for(int i = middlePosition + 1; i < (int)sampler._windowSize; i++)
+    for(std::ptrdiff_t i = static_cast<std::ptrdiff_t>(middlePosition) + 1; i < static_cast<std::ptrdiff_t>(windowSize); i++)
     {
-        if((int)(pTL.y + (i - middlePosition)) < (int)src.height())
-        {
-            if((int)(pTL.y + (i - middlePosition)) < 0)
-            {
-                xProcessed.at(i) = xProcessed.at(i - 1);
-            }
-            else
-            {
-                loc.y() -= (middlePosition - i);
-                details::getPixelsPointers(loc, pTL, sampler._windowSize, src.width(), outOfImageProcess, ptr);
-                details::process1Dresampling<SrcP, Weight, SrcC>()(ptr, xWeights, xProcessed.at(i));
-                loc.y() += (middlePosition - i);
-            }
-        }
+        const std::ptrdiff_t y = pTL.y + (i - static_cast<std::ptrdiff_t>(middlePosition));
+        if(y >= 0 && y < height)
+            details::filterRow(src, x0, y, xWeights, windowSize, outOfImageProcess, xProcessed[i]);
+        else if(y >= height && outOfImageProcess == eParamFilterOutBlack)
+            xProcessed[i] = get_black<DstP>();
+        else if(y >= height && outOfImageProcess == eParamFilterOutTransparency)
+            xProcessed[i] = SrcP(0);
         else
-        {
-            switch(outOfImageProcess)
-            {
-                case eParamFilterOutBlack:
-                {
-                    xProcessed.at(i) = get_black<DstP>();
-                    break;
-                }
-                case eParamFilterOutTransparency:
-                {
-                    xProcessed.at(i) = SrcP(0);
-                    break;
-                }
-                case eParamFilterOutCopy:
-                {
-                    xProcessed.at(i) = xProcessed.at(i - 1);
-                    break;
-                }
-                case eParamFilterOutMirror:
-                {
-                    xProcessed.at(i) = xProcessed.at(i - 1);
-                    break;
-                }
-            }
-        }
+            xProcessed[i] = xProcessed[i - 1];
     }
 
     // vertical process
-    details::process1Dresampling<SrcC, Weight, SrcC>()(xProcessed, yWeights, mp);
+    SrcC mp(0);
+    details::filterPixels(xProcessed, yWeights, windowSize, mp);
 
     // Convert from floating point average value to the destination type
     color_convert(mp, result);
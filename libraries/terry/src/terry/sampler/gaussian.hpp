@@ -12,22 +12,24 @@ namespace sampler
 
 // from http://avisynth.org/mediawiki/Resampling#Gaussian_resampler
 
-struct gaussian_sampler
+struct gaussian_sampler : public tabulated_sampler
 {
     const size_t _windowSize;
-    RESAMPLING_CORE_TYPE _sigma;
+    const RESAMPLING_CORE_TYPE _sigma;
 
     gaussian_sampler()
         : _windowSize(4.0)
         , // size = 3.0
         _sigma(1.0)
     {
+        buildWeightTable(*this);
     }
 
     gaussian_sampler(size_t windowSize, size_t sigma)
         : _windowSize(windowSize + 1)
         , _sigma(sigma)
     {
+        buildWeightTable(*this);
     }
 
     template <typename Weight>
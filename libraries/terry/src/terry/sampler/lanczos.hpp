@@ -39,7 +39,7 @@ namespace sampler
 //          sin(xpi / filter_size) / (xpi / filter_size);  // sinc(x/filter_size)
 //}
 
-struct lanczos_sampler
+struct lanczos_sampler : public tabulated_sampler
 {
     const size_t _windowSize;
     const RESAMPLING_CORE_TYPE _sharpen;
@@ -48,6 +48,7 @@ struct lanczos_sampler
         : _windowSize(filterSize * 2)
         , _sharpen(sharpen)
     {
+        buildWeightTable(*this);
     }
 
     RESAMPLING_CORE_TYPE sinc(RESAMPLING_CORE_TYPE x)
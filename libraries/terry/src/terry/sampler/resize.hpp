@@ -0,0 +1,229 @@
+#ifndef _TERRY_SAMPLER_RESIZE_HPP_
+#define _TERRY_SAMPLER_RESIZE_HPP_
+
+#include <terry/math/Rect.hpp>
+
+#include <terry/sampler/details.hpp>
+#include <terry/sampler/sampler.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace terry
+{
+namespace sampler
+{
+
+/**
+ * @brief Precomputed weights of the source pixels contributing to each destination pixel of an axis aligned resize.
+ *
+ * The pixel centers are aligned: the destination pixel @c d is at the source position
+ * (d + 0.5) * srcSize / dstSize - 0.5.
+ * When downscaling, the filter is stretched by the reduction ratio so each source pixel contributes to the result,
+ * instead of sampling the source at the destination positions only (which aliases).
+ * The weights are normalized and the pixels outside of the image are resolved when building the table:
+ * copy and mirror modes point to pixels inside the image, black and transparency modes keep an outside weight.
+ */
+class contribution_table
+{
+public:
+    typedef boost::gil::bits64f Weight;
+
+    template <typename Sampler>
+    contribution_table(Sampler sampler, const std::size_t srcSize, const std::size_t dstSize,
+                       const EParamFilterOutOfImage outOfImageProcess)
+        : _first(dstSize, 0)
+        , _count(dstSize, 0)
+        , _outWeight(dstSize, 0.0)
+    {
+        BOOST_ASSERT(srcSize > 0);
+        const double ratio = srcSize / double(dstSize);
+        const double filterScale = std::max(ratio, 1.0);
+        const double radius = sampler._windowSize * 0.5 * filterScale;
+        _windowSize = static_cast<std::size_t>(std::ceil(2.0 * radius)) + 1;
+        _weights.resize(dstSize * _windowSize, 0.0);
+
+        const std::ptrdiff_t size = srcSize;
+        std::vector<Weight> rawWeights(_windowSize);
+        std::vector<std::ptrdiff_t> rawPixels(_windowSize);
+        for(std::size_t d = 0; d < dstSize; ++d)
+        {
+            const double center = (d + 0.5) * ratio - 0.5;
+            const std::ptrdiff_t first = static_cast<std::ptrdiff_t>(std::floor(center - radius)) + 1;
+            const std::size_t rawCount = std::min(
+                static_cast<std::size_t>(std::floor(center + radius) - first + 1), _windowSize);
+
+            // source pixel of each filter position, -1 for the pixels outside of the image
+            Weight sum = 0.0;
+            std::ptrdiff_t begin = size;
+            std::ptrdiff_t end = 0;
+            for(std::size_t i = 0; i < rawCount; ++i)
+            {
+                const std::ptrdiff_t x = first + i;
+                sampler(RESAMPLING_CORE_TYPE((x - center) / filterScale), rawWeights[i]);
+                sum += rawWeights[i];
+                rawPixels[i] = mapOutOfImage(x, size, outOfImageProcess);
+                if(rawPixels[i] >= 0)
+                {
+                    begin = std::min(begin, rawPixels[i]);
+                    end = std::max(end, rawPixels[i] + 1);
+                }
+            }
+            if(begin >= end)
+                begin = end = 0;
+            BOOST_ASSERT(end - begin <= std::ptrdiff_t(_windowSize));
+
+            Weight* weights = &_weights[d * _windowSize];
+            const Weight norm = (sum != 0.0) ? 1.0 / sum : 1.0;
+            for(std::size_t i = 0; i < rawCount; ++i)
+            {
+                if(rawPixels[i] >= 0)
+                    weights[rawPixels[i] - begin] += rawWeights[i] * norm;
+                else
+                    _outWeight[d] += rawWeights[i] * norm;
+            }
+            // the filter may be null at the ends of its window (nearest neighbor, bilinear)
+            std::size_t count = end - begin;
+            std::size_t skip = 0;
+            while(skip < count && weights[skip] == 0.0)
+                ++skip;
+            while(count > skip && weights[count - 1] == 0.0)
+                --count;
+            std::copy(weights + skip, weights + count, weights);
+            std::fill(weights + count - skip, weights + _windowSize, 0.0);
+            _first[d] = begin + skip;
+            _count[d] = count - skip;
+        }
+    }
+
+    std::size_t windowSize() const { return _windowSize; }
+
+    /// First source pixel contributing to the destination pixel @p d
+    std::ptrdiff_t first(const std::size_t d) const { return _first[d]; }
+    /// Number of source pixels contributing to the destination pixel @p d, all inside of the source image
+    std::size_t count(const std::size_t d) const { return _count[d]; }
+    const Weight* weights(const std::size_t d) const { return &_weights[d * _windowSize]; }
+    /// Weight of the pixels outside of the source image, with black and transparency modes
+    Weight outWeight(const std::size_t d) const { return _outWeight[d]; }
+
+private:
+    /// Source pixel used for the position @p x, -1 if it is outside of the image and has no source pixel
+    static std::ptrdiff_t mapOutOfImage(const std::ptrdiff_t x, const std::ptrdiff_t size,
+                                        const EParamFilterOutOfImage outOfImageProcess)
+    {
+        if(x >= 0 && x < size)
+            return x;
+        switch(outOfImageProcess)
+        {
+            case eParamFilterOutCopy:
+                return (x < 0) ? 0 : size - 1;
+            case eParamFilterOutMirror:
+            {
+                const std::ptrdiff_t mirrored = (x < 0) ? -x - 1 : 2 * size - x - 1;
+                return std::min(std::max(mirrored, std::ptrdiff_t(0)), size - 1);
+            }
+            case eParamFilterOutBlack:
+            case eParamFilterOutTransparency:
+                break;
+        }
+        return -1;
+    }
+
+private:
+    std::size_t _windowSize;
+    std::vector<std::ptrdiff_t> _first;
+    std::vector<std::size_t> _count;
+    std::vector<Weight> _outWeight;
+    std::vector<Weight> _weights; ///< windowSize weights for each destination pixel
+};
+
+/**
+ * @brief Resize the source view into the destination view with two separable passes.
+ *
+ * The rows are filtered horizontally into a ring of windowSize rows of floating point pixels,
+ * then each destination row is the weighted sum of the rows of its vertical window.
+ * A source row is filtered once for all the destination rows of @p procWindow using it.
+ */
+template <typename SrcView, typename DstView, typename Progress>
+void resize_separable_progress(const SrcView& src_view, const DstView& dst_view, const contribution_table& xTable,
+                               const contribution_table& yTable, const terry::Rect<std::ssize_t>& procWindow,
+                               const EParamFilterOutOfImage outOfImageProcess, Progress& p)
+{
+    typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+    typedef contribution_table::Weight Weight;
+    typedef details::add_dst_mul_src<SrcC, Weight, SrcC> AddRow;
+
+    const std::size_t width = procWindow.x2 - procWindow.x1;
+    const std::size_t nbRows = yTable.windowSize();
+    if(width == 0)
+        return;
+
+    // pixels outside of the image with black and transparency modes
+    SrcC outPixel(0);
+    if(outOfImageProcess == eParamFilterOutBlack)
+        outPixel = get_black<SrcC>();
+    const bool addOutPixel = (outOfImageProcess == eParamFilterOutBlack);
+
+    std::vector<SrcC> rows(nbRows * width);
+    std::vector<std::ptrdiff_t> rowInSlot(nbRows, -1);
+    std::vector<SrcC> dstRow(width);
+
+    for(std::ssize_t y = procWindow.y1; y < procWindow.y2; ++y)
+    {
+        const std::ptrdiff_t firstRow = yTable.first(y);
+        const std::size_t rowCount = yTable.count(y);
+
+        // horizontal pass on the rows not filtered yet
+        for(std::size_t r = 0; r < rowCount; ++r)
+        {
+            const std::ptrdiff_t srcY = firstRow + r;
+            const std::size_t slot = srcY % nbRows;
+            if(rowInSlot[slot] == srcY)
+                continue;
+            rowInSlot[slot] = srcY;
+
+            typename SrcView::x_iterator srcIt = src_view.row_begin(srcY);
+            SrcC* row = &rows[slot * width];
+            for(std::size_t x = 0; x < width; ++x)
+            {
+                const std::size_t dstX = procWindow.x1 + x;
+                SrcC mp(0);
+                details::filterPixels(srcIt + xTable.first(dstX), xTable.weights(dstX), xTable.count(dstX), mp);
+                if(addOutPixel)
+                    AddRow()(outPixel, xTable.outWeight(dstX), mp);
+                row[x] = mp;
+            }
+        }
+
+        // vertical pass
+        std::fill(dstRow.begin(), dstRow.end(), SrcC(0));
+        const Weight* yWeights = yTable.weights(y);
+        for(std::size_t r = 0; r < rowCount; ++r)
+        {
+            const SrcC* row = &rows[((firstRow + r) % nbRows) * width];
+            const Weight weight = yWeights[r];
+            for(std::size_t x = 0; x < width; ++x)
+                AddRow()(row[x], weight, dstRow[x]);
+        }
+        if(addOutPixel && yTable.outWeight(y) != 0.0)
+        {
+            // the rows outside of the image are made of outside pixels
+            for(std::size_t x = 0; x < width; ++x)
+                AddRow()(outPixel, yTable.outWeight(y), dstRow[x]);
+        }
+
+        typename DstView::x_iterator dstIt = dst_view.row_begin(y) + procWindow.x1;
+        for(std::size_t x = 0; x < width; ++x, ++dstIt)
+            color_convert(dstRow[x], *dstIt);
+
+        if(p.progressForward(width))
+            return;
+    }
+}
+}
+}
+
+#endif
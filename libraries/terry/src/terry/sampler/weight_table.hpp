@@ -0,0 +1,91 @@
+#ifndef _TERRY_SAMPLER_WEIGHT_TABLE_HPP_
+#define _TERRY_SAMPLER_WEIGHT_TABLE_HPP_
+
+#include "sampler.hpp"
+
+#include <boost/gil/channel.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace terry
+{
+namespace sampler
+{
+
+/**
+ * @brief Weights of a sampler precomputed for regularly spaced sub-pixel phases.
+ *
+ * The weights of a position between two phases are linearly interpolated.
+ * They are the same as the sampler ones for phases multiple of 1/nbPhases (0, 0.5, 0.25...),
+ * and differ by less than 2e-5 otherwise with the Lanczos and BC filters.
+ */
+class weight_table
+{
+public:
+    typedef boost::gil::bits64f Weight;
+    static const std::size_t nbPhases = 256;
+
+    template <typename Sampler>
+    explicit weight_table(Sampler& sampler)
+        : _windowSize(sampler._windowSize)
+        , _weights((nbPhases + 1) * sampler._windowSize)
+    {
+        const std::size_t middlePosition = std::floor((_windowSize - 1.0) * 0.5);
+        for(std::size_t phase = 0; phase <= nbPhases; ++phase)
+        {
+            const RESAMPLING_CORE_TYPE frac = phase / RESAMPLING_CORE_TYPE(nbPhases);
+            for(std::size_t i = 0; i < _windowSize; ++i)
+            {
+                RESAMPLING_CORE_TYPE distance = -frac - middlePosition + i;
+                sampler(distance, _weights[phase * _windowSize + i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the weights of the window pixels for a position at @p frac pixels after the window pixel middlePosition.
+     * @param[in] frac in [0, 1)
+     */
+    void getWeights(const RESAMPLING_CORE_TYPE frac, Weight* weights) const
+    {
+        const RESAMPLING_CORE_TYPE position = frac * nbPhases;
+        const std::size_t phase = std::min(static_cast<std::size_t>(position), nbPhases - 1);
+        const Weight t = position - phase;
+        const Weight* w0 = &_weights[phase * _windowSize];
+        const Weight* w1 = w0 + _windowSize;
+        if(t == 0)
+        {
+            std::copy(w0, w1, weights);
+            return;
+        }
+        for(std::size_t i = 0; i < _windowSize; ++i)
+            weights[i] = w0[i] + t * (w1[i] - w0[i]);
+    }
+
+private:
+    const std::size_t _windowSize;
+    std::vector<Weight> _weights; ///< nbPhases + 1 rows of windowSize weights
+};
+
+/**
+ * @brief Base of the samplers whose weights come from a weight_table instead of being evaluated for each pixel.
+ * The table is shared by the copies of the sampler.
+ */
+struct tabulated_sampler
+{
+    boost::shared_ptr<const weight_table> _weightTable;
+
+protected:
+    template <typename Sampler>
+    void buildWeightTable(Sampler& sampler)
+    {
+        _weightTable.reset(new weight_table(sampler));
+    }
+};
+}
+}
+
+#endif
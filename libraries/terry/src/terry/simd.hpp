@@ -0,0 +1,84 @@
+#ifndef _TERRY_SIMD_HPP_
+#define _TERRY_SIMD_HPP_
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TERRY_SIMD_X86 1
+// functions using AVX2 are compiled for it, and only called if the CPU supports it
+#define TERRY_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define TERRY_SIMD_X86 1
+#define TERRY_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace terry
+{
+
+/// Instruction sets used by the vectorized code
+enum ESimdLevel
+{
+    eSimdNone = 0,
+    eSimdSSE2, ///< all x86-64 CPUs
+    eSimdAVX2  ///< AVX2 and FMA
+};
+
+inline ESimdLevel detect_simd_level()
+{
+#if defined(TERRY_SIMD_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return eSimdAVX2;
+    return eSimdSSE2;
+#elif defined(TERRY_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuid(info, 7);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    // the OS saves the AVX registers
+    if(fma && avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+        return eSimdAVX2;
+    return eSimdSSE2;
+#else
+    return eSimdNone;
+#endif
+}
+
+/**
+ * @brief Instruction set limited by the name of the environment variable TERRY_SIMD:
+ * "none", "sse2" or "avx2". An unknown name doesn't limit it.
+ */
+inline ESimdLevel limit_simd_level(const ESimdLevel level, const char* name)
+{
+    if(name == NULL)
+        return level;
+    ESimdLevel limit = level;
+    if(std::strcmp(name, "none") == 0)
+        limit = eSimdNone;
+    else if(std::strcmp(name, "sse2") == 0)
+        limit = eSimdSSE2;
+    else if(std::strcmp(name, "avx2") == 0)
+        limit = eSimdAVX2;
+    return limit < level ? limit : level;
+}
+
+/**
+ * @brief Instruction set used by the vectorized code, chosen once on the running CPU.
+ * The environment variable TERRY_SIMD ("none", "sse2" or "avx2") limits it, to compare the results or the timings.
+ * The level is a local static initialized by a function call: its initialization is thread safe with C++11,
+ * and with gcc and clang in C++98 (-fthreadsafe-statics, their default).
+ */
+inline ESimdLevel simd_level()
+{
+    static const ESimdLevel level = limit_simd_level(detect_simd_level(), std::getenv("TERRY_SIMD"));
+    return level;
+}
+}
+
+#endif
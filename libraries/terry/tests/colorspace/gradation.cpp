@@ -0,0 +1,96 @@
+#include <terry/globals.hpp>
+#include <terry/colorspace/gradation_lut.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+/// Every value of an integer channel gives exactly the analytic conversion
+template <typename Channel, class TIN, class TOUT>
+void checkIntegerLut(const TIN& in, const TOUT& out)
+{
+    using namespace terry::color;
+    gradation_lut<Channel> lut;
+    lut.build(in, out);
+    const channel_color_gradation_t<Channel, TIN, TOUT> convert(in, out);
+    const std::size_t nbValues = std::size_t(boost::gil::channel_traits<Channel>::max_value()) + 1;
+    std::size_t nbErrors = 0;
+    for(std::size_t i = 0; i < nbValues; ++i)
+    {
+        Channel expected;
+        convert(Channel(i), expected);
+        if(lut(Channel(i)) != expected)
+            ++nbErrors;
+    }
+    BOOST_CHECK_EQUAL(nbErrors, std::size_t(0));
+}
+
+/// Float values of the whole table range, and outside, are within the documented error
+template <class TIN, class TOUT>
+void checkFloatLut(const TIN& in, const TOUT& out)
+{
+    using namespace terry::color;
+    using boost::gil::bits32f;
+    gradation_lut<bits32f> lut;
+    lut.build(in, out);
+    const gradation_float_function_t<TIN, TOUT> convert(in, out);
+
+    double maxError = 0.0;
+    // 2^-16 to 2^10, with a step of a few mantissa lsb not multiple of the segments
+    for(boost::uint32_t bits = boost::uint32_t(127 - 16) << 23; bits < boost::uint32_t(127 + 10) << 23; bits += 1237)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        const float expected = convert(value);
+        if(!(std::fabs(expected) <= std::numeric_limits<float>::max()))
+            continue;
+        const double error =
+            std::fabs(float(lut(bits32f(value))) - expected) / std::max(std::fabs(expected), 1.0f / 16.0f);
+        maxError = std::max(maxError, error);
+    }
+    BOOST_CHECK_LE(maxError, 1.1e-6);
+
+    // negative values use the analytic conversion, when it is defined
+    const float negative = convert(-0.5f);
+    if(negative == negative)
+        BOOST_CHECK_EQUAL(float(lut(bits32f(-0.5f))), negative);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(terry_colorspace_gradation_lut)
+
+BOOST_AUTO_TEST_CASE(gradation_lut_integer_exact)
+{
+    using namespace terry::color;
+    checkIntegerLut<boost::gil::bits8>(gradation::sRGB(), gradation::Linear());
+    checkIntegerLut<boost::gil::bits8>(gradation::Linear(), gradation::Rec709());
+    checkIntegerLut<boost::gil::bits16>(gradation::Linear(), gradation::sRGB());
+    checkIntegerLut<boost::gil::bits16>(gradation::Cineon(), gradation::Linear());
+    checkIntegerLut<boost::gil::bits16>(gradation::Panalog(), gradation::Gamma(2.2));
+}
+
+BOOST_AUTO_TEST_CASE(gradation_lut_float_error)
+{
+    using namespace terry::color;
+    checkFloatLut(gradation::sRGB(), gradation::Linear());
+    checkFloatLut(gradation::Linear(), gradation::sRGB());
+    checkFloatLut(gradation::Rec709(), gradation::Linear());
+    checkFloatLut(gradation::Linear(), gradation::Rec709());
+    checkFloatLut(gradation::Cineon(), gradation::Linear());
+    checkFloatLut(gradation::Linear(), gradation::Cineon());
+    checkFloatLut(gradation::Panalog(), gradation::Linear());
+    checkFloatLut(gradation::Linear(), gradation::Panalog());
+    checkFloatLut(gradation::AlexaV3LogC(), gradation::Linear());
+    checkFloatLut(gradation::Linear(), gradation::AlexaV3LogC());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+#include <terry/globals.hpp>
+#include <terry/colorspace/gradation.hpp>
+#include <terry/colorspace/transform_chain.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+typedef terry::color::color_transform_chain Chain;
+typedef Chain::Matrix33 Matrix33;
+
+/// Largest difference between the coefficients of two matrices
+double maxDifference(const Matrix33& a, const Matrix33& b)
+{
+    double diff = 0.0;
+    for(std::size_t i = 0; i < 3; ++i)
+        for(std::size_t j = 0; j < 3; ++j)
+            diff = std::max(diff, std::fabs(a(i, j) - b(i, j)));
+    return diff;
+}
+
+/// Rgb values of the whole range of a float image, a few outside [0, 1]
+std::vector<float> testValues()
+{
+    std::vector<float> values;
+    for(int r = 0; r <= 4; ++r)
+        for(int g = 0; g <= 4; ++g)
+            for(int b = 0; b <= 4; ++b)
+            {
+                values.push_back(r * 0.3f - 0.1f);
+                values.push_back(g * 0.25f + 0.01f);
+                values.push_back(b * 0.2f);
+            }
+    return values;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(terry_colorspace_transform_chain)
+
+BOOST_AUTO_TEST_CASE(compile_merges_matrices_in_order)
+{
+    // two matrices which don't commute: the second one is applied to the result of the first one
+    const Matrix33 a = Chain::matrix(1, 2, 0, 0, 1, 0, 0, 0, 1);
+    const Matrix33 b = Chain::matrix(1, 0, 0, 0, 1, 0, 3, 0, 1);
+    Chain chain;
+    chain.addMatrix(a);
+    chain.addMatrix(b);
+    chain.compile();
+    BOOST_CHECK_EQUAL(chain.nbSteps(), std::size_t(1));
+
+    // b * a * (1, 1, 1) = b * (3, 1, 1) = (3, 1, 10), a * b * (1, 1, 1) would be (3, 1, 4)
+    float values[3] = {1.0f, 1.0f, 1.0f};
+    chain.apply(values, 1);
+    BOOST_CHECK_CLOSE(values[0], 3.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(values[1], 1.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(values[2], 10.0f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(compile_removes_identities)
+{
+    using namespace terry::color;
+    const Matrix33 m = Chain::rgb_to_YPbPr();
+    {
+        Chain chain;
+        chain.addMatrix(Chain::identity());
+        chain.addMatrix(m);
+        chain.addMatrix(Chain::inverse(m));
+        chain.compile();
+        BOOST_CHECK_EQUAL(chain.nbSteps(), std::size_t(0));
+    }
+    {
+        // a gradation between the matrices stops the merge
+        Chain chain;
+        chain.addMatrix(m);
+        chain.addGradation(gradation::sRGB(), gradation::Linear());
+        chain.addMatrix(Chain::inverse(m));
+        chain.addMatrix(Chain::identity());
+        chain.compile();
+        BOOST_CHECK_EQUAL(chain.nbSteps(), std::size_t(3));
+    }
+    {
+        // same gradation in and out
+        Chain chain;
+        chain.addGradation(gradation::Linear(), gradation::Linear());
+        chain.compile();
+        BOOST_CHECK_EQUAL(chain.nbSteps(), std::size_t(0));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_and_inverse_round_trip)
+{
+    using namespace terry::color;
+    // encoded YUV to linear XYZ with a white balance, then back
+    const Matrix33 balance = Chain::diagonal(0.85027254, 1.02490389, 1.38509774);
+    Chain chain;
+    chain.addMatrix(Chain::inverse(Chain::rgb_to_yuv()));
+    chain.addGradation(gradation::sRGB(), gradation::Linear());
+    chain.addMatrix(balance);
+    chain.addMatrix(Chain::rgb_to_XYZ());
+    chain.addMatrix(Chain::inverse(Chain::rgb_to_XYZ()));
+    chain.addMatrix(Chain::inverse(balance));
+    chain.addGradation(gradation::Linear(), gradation::sRGB());
+    chain.addMatrix(Chain::rgb_to_yuv());
+    chain.compile();
+    BOOST_CHECK_EQUAL(chain.nbSteps(), std::size_t(4));
+
+    // yuv values of the rgb test values
+    Chain toYuv;
+    toYuv.addMatrix(Chain::rgb_to_yuv());
+    std::vector<float> yuv = testValues();
+    toYuv.apply(&yuv.front(), yuv.size() / 3);
+
+    std::vector<float> values = yuv;
+    chain.apply(&values.front(), values.size() / 3);
+    double maxError = 0.0;
+    for(std::size_t i = 0; i < values.size(); ++i)
+        maxError = std::max(maxError, double(std::fabs(values[i] - yuv[i])));
+    BOOST_CHECK_SMALL(maxError, 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(layout_matrices)
+{
+    // the conversions of layout::yuv_t, both directions
+    BOOST_CHECK_SMALL(maxDifference(Chain::rgb_to_yuv(), Chain::matrix(0.299, 0.587, 0.114, -0.14713, -0.28886, 0.436,
+                                                                       0.615, -0.51499, -0.10001)),
+                      1e-12);
+    BOOST_CHECK_SMALL(maxDifference(Chain::inverse(Chain::rgb_to_yuv()),
+                                    Chain::matrix(1.0, 0.0, 1.13983, 1.0, -0.39465, -0.58060, 1.0, 2.03211, 0.0)),
+                      5e-5);
+
+    // the conversions of layout::YPbPr_t, both directions
+    BOOST_CHECK_SMALL(maxDifference(Chain::rgb_to_YPbPr(), Chain::matrix(0.299, 0.587, 0.114, -0.168736, -0.331264, 0.5,
+                                                                         0.5, -0.418688, -0.081312)),
+                      1e-12);
+    BOOST_CHECK_SMALL(maxDifference(Chain::inverse(Chain::rgb_to_YPbPr()),
+                                    Chain::matrix(1.0, 0.0, 1.402, 1.0, -0.344136, -0.714136, 1.0, 1.772, 0.0)),
+                      5e-6);
+
+    // XYZ: Y is the Rec709 luminance of color/components.hpp, and white is the D65 white point
+    const Matrix33 xyz = Chain::rgb_to_XYZ();
+    BOOST_CHECK_SMALL(xyz(1, 0) - 0.2126, 1e-4);
+    BOOST_CHECK_SMALL(xyz(1, 1) - 0.7152, 1e-4);
+    BOOST_CHECK_SMALL(xyz(1, 2) - 0.0722, 1e-4);
+    BOOST_CHECK_SMALL(xyz(0, 0) + xyz(0, 1) + xyz(0, 2) - 0.95047, 1e-5);
+    BOOST_CHECK_SMALL(xyz(1, 0) + xyz(1, 1) + xyz(1, 2) - 1.0, 1e-5);
+    BOOST_CHECK_SMALL(xyz(2, 0) + xyz(2, 1) + xyz(2, 2) - 1.08883, 1e-5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,207 @@
+#include <terry/globals.hpp>
+#include <terry/filter/convolve.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+/// Separable correlation computed pixel by pixel, with the positions of the boundary option
+float referenceCorrelation(const terry::rgba32f_view_t& src, const terry::filter::kernel_1d<float>& ker,
+                           const std::ptrdiff_t x, const std::ptrdiff_t y, const std::size_t channel,
+                           const terry::filter::convolve_boundary_option option)
+{
+    using terry::filter::detail::extend_position;
+    float result = 0.0f;
+    for(std::size_t j = 0; j < ker.size(); ++j)
+    {
+        const std::ptrdiff_t yy = extend_position(y - std::ptrdiff_t(ker.left_size()) + j, src.height(), option);
+        if(yy < 0)
+            continue;
+        for(std::size_t i = 0; i < ker.size(); ++i)
+        {
+            const std::ptrdiff_t xx = extend_position(x - std::ptrdiff_t(ker.left_size()) + i, src.width(), option);
+            if(xx >= 0)
+                result += ker[j] * ker[i] * src(xx, yy)[channel];
+        }
+    }
+    return result;
+}
+
+void fillImage(const terry::rgba32f_view_t& view)
+{
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+            for(std::size_t c = 0; c < 4; ++c)
+                view(x, y)[c] = std::sin(0.7f * x + 1.3f * y + c) + ((x + y) % 3);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(terry_filter_correlate)
+
+BOOST_AUTO_TEST_CASE(simd_level_environment)
+{
+    using namespace terry;
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdAVX2, NULL), eSimdAVX2);
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdAVX2, "none"), eSimdNone);
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdAVX2, "sse2"), eSimdSSE2);
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdAVX2, "avx2"), eSimdAVX2);
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdAVX2, "unknown"), eSimdAVX2);
+    // the variable doesn't enable an instruction set missing on the CPU
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdSSE2, "avx2"), eSimdSSE2);
+    BOOST_CHECK_EQUAL(limit_simd_level(eSimdNone, "sse2"), eSimdNone);
+}
+
+BOOST_AUTO_TEST_CASE(weighted_sum_simd_levels)
+{
+    using namespace terry::filter::detail;
+    const float weights[] = {0.1f, 0.25f, 0.3f, 0.25f, 0.1f};
+    std::vector<float> line(64);
+    for(std::size_t i = 0; i < line.size(); ++i)
+        line[i] = std::cos(0.3f * i);
+    const float* srcs[5];
+    for(std::size_t k = 0; k < 5; ++k)
+        srcs[k] = &line[k];
+
+    for(std::size_t size = 0; size <= 40; ++size)
+    {
+        std::vector<float> scalar(size + 1), sse2(size + 1), avx2(size + 1);
+        weighted_sum(srcs, weights, 5, size, &scalar.front(), eSimdNone);
+        weighted_sum(srcs, weights, 5, size, &sse2.front(), eSimdSSE2);
+        weighted_sum(srcs, weights, 5, size, &avx2.front(), simd_level());
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            BOOST_CHECK_CLOSE(scalar[i] + 2.0f, sse2[i] + 2.0f, 1e-4);
+            BOOST_CHECK_CLOSE(scalar[i] + 2.0f, avx2[i] + 2.0f, 1e-4);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(correlate_rows_cols_float)
+{
+    using namespace terry::filter;
+    terry::rgba32f_image_t srcImage(71, 53);
+    const terry::rgba32f_view_t src = view(srcImage);
+    fillImage(src);
+
+    kernel_1d<float> ker(9, 4);
+    for(std::size_t i = 0; i < ker.size(); ++i)
+        ker[i] = 0.05f * (i + 1);
+
+    const convolve_boundary_option options[] = {convolve_option_extend_zero, convolve_option_extend_constant,
+                                                convolve_option_extend_mirror};
+    for(std::size_t o = 0; o < 3; ++o)
+    {
+        // a tile touching the right and bottom borders, then the whole image
+        const terry::point2<std::ptrdiff_t> tl(40, 30);
+        terry::rgba32f_image_t tileImage(src.width() - tl.x, src.height() - tl.y);
+        const terry::rgba32f_view_t tile = view(tileImage);
+        correlate_rows_cols<terry::rgba32f_pixel_t, std::allocator>(src, ker, ker, tile, tl, options[o]);
+
+        terry::rgba32f_image_t fullImage(src.dimensions());
+        const terry::rgba32f_view_t full = view(fullImage);
+        correlate_rows_cols<terry::rgba32f_pixel_t, std::allocator>(src, ker, ker, full,
+                                                                    terry::point2<std::ptrdiff_t>(0, 0), options[o]);
+
+        for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+        {
+            for(std::ptrdiff_t x = 0; x < src.width(); ++x)
+            {
+                for(std::size_t c = 0; c < 4; ++c)
+                {
+                    const float expected = referenceCorrelation(src, ker, x, y, c, options[o]);
+                    BOOST_REQUIRE_SMALL(full(x, y)[c] - expected, 1e-3f);
+                    if(x >= tl.x && y >= tl.y)
+                        BOOST_REQUIRE_SMALL(tile(x - tl.x, y - tl.y)[c] - expected, 1e-3f);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(correlate_cols_16bits)
+{
+    using namespace terry::filter;
+    terry::rgba32f_image_t srcImage(33, 27);
+    const terry::rgba32f_view_t src = view(srcImage);
+    fillImage(src);
+    terry::rgba16_image_t src16Image(src.dimensions());
+    const terry::rgba16_view_t src16 = view(src16Image);
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+        for(std::ptrdiff_t x = 0; x < src.width(); ++x)
+            for(std::size_t c = 0; c < 4; ++c)
+                src16(x, y)[c] = static_cast<boost::uint16_t>(1000.0f * (src(x, y)[c] + 1.0f));
+
+    kernel_1d<float> ker(5, 2);
+    const float values[] = {0.1f, 0.2f, 0.4f, 0.2f, 0.1f};
+    std::copy(values, values + 5, ker.begin());
+
+    terry::rgba16_image_t dstImage(src.dimensions());
+    const terry::rgba16_view_t dst = view(dstImage);
+    correlate_cols<terry::rgba16_pixel_t>(src16, ker, dst, terry::point2<std::ptrdiff_t>(0, 0),
+                                          convolve_option_extend_mirror);
+
+    // the sum is rounded once
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < src.width(); ++x)
+        {
+            for(std::size_t c = 0; c < 4; ++c)
+            {
+                float expected = 0.0f;
+                for(std::size_t k = 0; k < 5; ++k)
+                {
+                    const std::ptrdiff_t yy = detail::extend_position(y - 2 + k, src.height(), convolve_option_extend_mirror);
+                    expected += values[k] * src16(x, yy)[c];
+                }
+                BOOST_REQUIRE_SMALL(float(dst(x, y)[c]) - std::floor(expected + 0.5f), 1.0f);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(correlate_cols_extend_padded)
+{
+    using namespace terry::filter;
+    // the view is inside a bigger image, the rows above and below it are the padding
+    const std::ptrdiff_t padding = 6;
+    terry::rgba32f_image_t paddedImage(37, 29);
+    const terry::rgba32f_view_t padded = view(paddedImage);
+    fillImage(padded);
+    const terry::rgba32f_view_t src =
+        subimage_view(padded, 0, padding, padded.width(), padded.height() - 2 * padding);
+
+    kernel_1d<float> ker(9, 4);
+    for(std::size_t i = 0; i < ker.size(); ++i)
+        ker[i] = 0.05f * (i + 1);
+
+    terry::rgba32f_image_t dstImage(src.dimensions());
+    const terry::rgba32f_view_t dst = view(dstImage);
+    correlate_cols<terry::rgba32f_pixel_t>(src, ker, dst, terry::point2<std::ptrdiff_t>(0, 0),
+                                           convolve_option_extend_padded);
+
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < src.width(); ++x)
+        {
+            for(std::size_t c = 0; c < 4; ++c)
+            {
+                float expected = 0.0f;
+                for(std::size_t k = 0; k < ker.size(); ++k)
+                    expected += ker[k] * padded(x, padding + y - 4 + k)[c];
+                BOOST_REQUIRE_SMALL(dst(x, y)[c] - expected, 1e-3f);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
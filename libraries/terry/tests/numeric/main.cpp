@@ -0,0 +1,87 @@
+#include <terry/globals.hpp>
+#include <terry/algorithm/reduce.hpp>
+#include <terry/algorithm/transform_pixels.hpp>
+#include <terry/numeric/minmax.hpp>
+#include <terry/numeric/moments.hpp>
+
+#include <boost/gil/image.hpp>
+
+#include <cmath>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_numeric_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_numeric_reduce)
+
+BOOST_AUTO_TEST_CASE(channel_moments_merge)
+{
+    using terry::numeric::channel_moments;
+
+    // large mean compared to the deviations
+    std::vector<double> values(2 * 1000);
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        values[2 * i] = 1e6 + std::sin(0.1 * i) + ((i % 10 == 0) ? 3.0 : 0.0);
+        values[2 * i + 1] = 0.5 * i;
+    }
+    const channel_moments<2> all(&values.front(), 1000);
+
+    // blocks of different sizes, as the rows of the bands
+    channel_moments<2> merged;
+    for(std::size_t begin = 0, size = 1; begin < 1000; begin += size, size = size % 37 + 5)
+        merged.merge(channel_moments<2>(&values[2 * begin], std::min(size, 1000 - begin)));
+
+    BOOST_CHECK_EQUAL(merged._count, 1000.0);
+    for(std::size_t c = 0; c < 2; ++c)
+    {
+        BOOST_CHECK_CLOSE(merged.mean(c), all.mean(c), 1e-9);
+        BOOST_CHECK_CLOSE(merged.variance(c), all.variance(c), 1e-7);
+        BOOST_CHECK_CLOSE(merged.skewness(c) + 10.0, all.skewness(c) + 10.0, 1e-7);
+        BOOST_CHECK_CLOSE(merged.kurtosis(c) + 10.0, all.kurtosis(c) + 10.0, 1e-7);
+    }
+    // uniform distribution on [0, 499.5]
+    BOOST_CHECK_CLOSE(all.mean(1), 249.75, 1e-9);
+    BOOST_CHECK_CLOSE(all.kurtosis(1), -1.2, 0.1);
+    BOOST_CHECK_SMALL(all.skewness(1), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_pixels_minmax)
+{
+    using namespace terry;
+    using namespace terry::numeric;
+
+    rgba32f_image_t image(67, 45);
+    const rgba32f_view_t view = boost::gil::view(image);
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+            for(std::size_t c = 0; c < 4; ++c)
+                view(x, y)[c] = std::sin(0.37f * x * (c + 1) + 0.11f * y);
+
+    pixel_minmax_by_channel_t<rgba32f_pixel_t> expected(view(0, 0));
+    algorithm::transform_pixels(view, expected);
+
+    algorithm::band_reduction<algorithm::pixel_row_reducer<rgba32f_view_t, pixel_minmax_by_channel_t<rgba32f_pixel_t> > >
+        reduction(algorithm::pixel_row_reducer<rgba32f_view_t, pixel_minmax_by_channel_t<rgba32f_pixel_t> >(
+                      view, pixel_minmax_by_channel_t<rgba32f_pixel_t>(view(0, 0))),
+                  0, view.height());
+    BOOST_CHECK_EQUAL(reduction.nbBands(), 3U);
+    // the bands may be reduced in any order
+    for(std::size_t band = reduction.nbBands(); band-- > 0;)
+        reduction.reduceBand(band);
+    const pixel_minmax_by_channel_t<rgba32f_pixel_t> result = reduction.result()._reducer;
+
+    const pixel_minmax_by_channel_t<rgba32f_pixel_t> result1 =
+        algorithm::reduce_pixels(view, pixel_minmax_by_channel_t<rgba32f_pixel_t>(view(0, 0)));
+
+    for(std::size_t c = 0; c < 4; ++c)
+    {
+        BOOST_CHECK_EQUAL(result.min[c], expected.min[c]);
+        BOOST_CHECK_EQUAL(result.max[c], expected.max[c]);
+        BOOST_CHECK_EQUAL(result1.min[c], expected.min[c]);
+        BOOST_CHECK_EQUAL(result1.max[c], expected.max[c]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+#include <terry/globals.hpp>
+#include <terry/sampler/all.hpp>
+#include <terry/sampler/resize.hpp>
+
+#include <cmath>
+#include <iostream>
+
+#define BOOST_TEST_MODULE terry_sampler_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_sampler_tests_suite01)
+
+template <typename Sampler>
+void checkWeightTable(Sampler sampler, const double tolerance)
+{
+    const std::size_t middlePosition = std::floor((sampler._windowSize - 1.0) * 0.5);
+    std::vector<terry::sampler::weight_table::Weight> weights(sampler._windowSize);
+
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        const RESAMPLING_CORE_TYPE frac = i / RESAMPLING_CORE_TYPE(1000);
+        sampler._weightTable->getWeights(frac, &weights[0]);
+        for(std::size_t w = 0; w < sampler._windowSize; ++w)
+        {
+            terry::sampler::weight_table::Weight expected;
+            sampler(-frac - middlePosition + w, expected);
+            BOOST_CHECK_SMALL(weights[w] - expected, tolerance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(weight_table)
+{
+    checkWeightTable(terry::sampler::bicubic_sampler(), 2e-5);
+    checkWeightTable(terry::sampler::catrom_sampler(), 2e-5);
+    checkWeightTable(terry::sampler::mitchell_sampler(), 2e-5);
+    checkWeightTable(terry::sampler::lanczos3_sampler(), 2e-5);
+    checkWeightTable(terry::sampler::lanczos12_sampler(), 2e-5);
+    checkWeightTable(terry::sampler::lanczos_sampler(4, 1.0), 2e-5);
+
+    // phases multiple of 1/nbPhases are exact
+    terry::sampler::lanczos3_sampler lanczos;
+    terry::sampler::weight_table::Weight weights[6];
+    lanczos._weightTable->getWeights(0.25, weights);
+    for(std::size_t w = 0; w < 6; ++w)
+    {
+        terry::sampler::weight_table::Weight expected;
+        lanczos(-0.25f - 2 + w, expected);
+        BOOST_CHECK_EQUAL(weights[w], expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sample_pixel_positions)
+{
+    terry::rgba32f_image_t image(16, 16);
+    terry::rgba32f_view_t view = boost::gil::view(image);
+    for(int y = 0; y < view.height(); ++y)
+        for(int x = 0; x < view.width(); ++x)
+            view(x, y) = terry::rgba32f_pixel_t(x, y, x * y, 1.0f);
+
+    // on a pixel, the Lanczos and bilinear weights are 1 for this pixel and 0 for the others
+    terry::sampler::lanczos3_sampler lanczos;
+    terry::sampler::bilinear_sampler bilinear;
+    for(int y = 0; y < view.height(); ++y)
+    {
+        for(int x = 0; x < view.width(); ++x)
+        {
+            terry::rgba32f_pixel_t result;
+            BOOST_CHECK(terry::sampler::sample(lanczos, view, boost::gil::point2<double>(x, y), result,
+                                               terry::sampler::eParamFilterOutCopy));
+            BOOST_CHECK_SMALL(float(result[0]) - float(view(x, y)[0]), 1e-3f);
+            BOOST_CHECK_SMALL(float(result[2]) - float(view(x, y)[2]), 1e-3f);
+
+            BOOST_CHECK(terry::sampler::sample(bilinear, view, boost::gil::point2<double>(x, y), result,
+                                               terry::sampler::eParamFilterOutBlack));
+            BOOST_CHECK_EQUAL(float(result[1]), float(view(x, y)[1]));
+        }
+    }
+
+    // bilinear between 4 pixels
+    terry::rgba32f_pixel_t result;
+    terry::sampler::sample(bilinear, view, boost::gil::point2<double>(2.5, 3.25), result,
+                           terry::sampler::eParamFilterOutBlack);
+    BOOST_CHECK_CLOSE(float(result[0]), 2.5f, 1e-4);
+    BOOST_CHECK_CLOSE(float(result[1]), 3.25f, 1e-4);
+}
+
+struct NoProgress
+{
+    bool progressForward(const int) { return false; }
+};
+
+BOOST_AUTO_TEST_CASE(contribution_table)
+{
+    using terry::sampler::contribution_table;
+
+    // 4K to HD: the Lanczos filter is stretched over twice more source pixels
+    const contribution_table table(terry::sampler::lanczos3_sampler(), 3840, 1920, terry::sampler::eParamFilterOutCopy);
+    BOOST_CHECK_EQUAL(table.windowSize(), 13u);
+    for(std::size_t d = 0; d < 1920; ++d)
+    {
+        contribution_table::Weight sum = 0;
+        for(std::size_t i = 0; i < table.count(d); ++i)
+            sum += table.weights(d)[i];
+        BOOST_CHECK_CLOSE(sum, 1.0, 1e-9);
+        BOOST_CHECK(table.first(d) >= 0);
+        BOOST_CHECK(table.first(d) + table.count(d) <= 3840u);
+    }
+
+    // halving with the nearest neighbor filter averages pairs of pixels
+    const contribution_table box(terry::sampler::nearest_neighbor_sampler(), 8, 4, terry::sampler::eParamFilterOutBlack);
+    for(std::size_t d = 0; d < 4; ++d)
+    {
+        BOOST_CHECK_EQUAL(box.first(d), std::ptrdiff_t(2 * d));
+        BOOST_CHECK_EQUAL(box.count(d), 2u);
+        BOOST_CHECK_EQUAL(box.weights(d)[0], 0.5);
+        BOOST_CHECK_EQUAL(box.weights(d)[1], 0.5);
+        BOOST_CHECK_EQUAL(box.outWeight(d), 0.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(resize_separable)
+{
+    terry::rgba32f_image_t srcImage(64, 32);
+    terry::rgba32f_view_t src = boost::gil::view(srcImage);
+    for(int y = 0; y < src.height(); ++y)
+        for(int x = 0; x < src.width(); ++x)
+            src(x, y) = terry::rgba32f_pixel_t(x, y, (x + y) % 2, 1.0f);
+
+    terry::rgba32f_image_t dstImage(16, 8);
+    terry::rgba32f_view_t dst = boost::gil::view(dstImage);
+    const terry::sampler::lanczos3_sampler lanczos;
+    const terry::sampler::contribution_table xTable(lanczos, 64, 16, terry::sampler::eParamFilterOutCopy);
+    const terry::sampler::contribution_table yTable(lanczos, 32, 8, terry::sampler::eParamFilterOutCopy);
+    NoProgress progress;
+    terry::sampler::resize_separable_progress(src, dst, xTable, yTable, terry::Rect<std::ssize_t>(0, 0, 16, 8),
+                                              terry::sampler::eParamFilterOutCopy, progress);
+
+    for(int y = 0; y < dst.height(); ++y)
+    {
+        for(int x = 0; x < dst.width(); ++x)
+        {
+            // away from the borders, the ramps keep their values at the pixel centers
+            if(x > 2 && x < dst.width() - 3)
+                BOOST_CHECK_SMALL(float(dst(x, y)[0]) - float((x + 0.5) * 4 - 0.5), 1e-3f);
+            if(y > 2 && y < dst.height() - 3)
+                BOOST_CHECK_SMALL(float(dst(x, y)[1]) - float((y + 0.5) * 4 - 0.5), 1e-3f);
+            // the checkerboard is filtered to its average instead of aliasing
+            BOOST_CHECK_SMALL(float(dst(x, y)[2]) - 0.5f, 0.05f);
+            BOOST_CHECK_CLOSE(float(dst(x, y)[3]), 1.0f, 1e-4);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,409 @@
+#include "Benchmark.hpp"
+
+#include <tuttle/common/exceptions.hpp>
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/chrono/chrono.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <exception>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+namespace tuttle
+{
+namespace bench
+{
+
+namespace
+{
+
+BenchCase makeCase(const std::string& name, const ECaseType type)
+{
+    BenchCase c;
+    c._name = name;
+    c._type = type;
+    return c;
+}
+
+BenchCase processCase(const std::string& name, const NodeSpec& node)
+{
+    BenchCase c = makeCase(name, eCaseTypeProcess);
+    c._nodes.push_back(node);
+    return c;
+}
+
+void addIoCases(std::vector<BenchCase>& cases, const std::string& format, const std::string& extension)
+{
+    BenchCase write = makeCase("write." + format, eCaseTypeWrite);
+    write._writer = NodeSpec("tuttle." + format + "writer");
+    write._extension = extension;
+    cases.push_back(write);
+
+    BenchCase read = makeCase("read." + format, eCaseTypeRead);
+    read._nodes.push_back(NodeSpec("tuttle." + format + "reader"));
+    read._writer = write._writer;
+    read._extension = extension;
+    cases.push_back(read);
+}
+
+/**
+ * @brief Half float EXR files for each storage and compression of the writer.
+ */
+void addExrWriteCases(std::vector<BenchCase>& cases)
+{
+    const char* storages[] = {"scanline", "tiles", "tilesmipmap"};
+    const char* compressions[] = {"none", "rle", "zips", "zip", "piz", "pxr24", "b44", "b44a"};
+    for(std::size_t storage = 0; storage < sizeof(storages) / sizeof(const char*); ++storage)
+    {
+        for(std::size_t compression = 0; compression < sizeof(compressions) / sizeof(const char*); ++compression)
+        {
+            const std::string name = std::string("write.exr.") + storages[storage] + "." + compressions[compression];
+            BenchCase write = makeCase(name, eCaseTypeWrite);
+            write._writer = NodeSpec("tuttle.exrwriter")
+                                .param("bitDepth=0") // 16f
+                                .param("storage=" + boost::lexical_cast<std::string>(storage))
+                                .param("compression=" + boost::lexical_cast<std::string>(compression));
+            write._extension = "exr";
+            cases.push_back(write);
+        }
+    }
+}
+
+const char* caseTypeName(const ECaseType type)
+{
+    switch(type)
+    {
+        case eCaseTypeGenerator:
+            return "generator";
+        case eCaseTypeProcess:
+            return "process";
+        case eCaseTypeWrite:
+            return "write";
+        case eCaseTypeRead:
+            return "read";
+    }
+    return "";
+}
+
+std::string explicitConversion(const std::string& bitDepth)
+{
+    if(bitDepth == "8i")
+        return "1";
+    if(bitDepth == "16i")
+        return "2";
+    if(bitDepth == "32f")
+        return "3";
+    BOOST_THROW_EXCEPTION(exception::Value() << exception::user() + "Unrecognized bit depth \"" + bitDepth + "\".");
+}
+
+std::string configKey(const BenchConfig& config)
+{
+    std::ostringstream os;
+    os << config._width << "x" << config._height << "_" << config._bitDepth << "_" << config._nbThreads;
+    return os.str();
+}
+
+double median(std::vector<double> values)
+{
+    if(values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    const std::size_t middle = values.size() / 2;
+    if(values.size() % 2)
+        return values[middle];
+    return 0.5 * (values[middle - 1] + values[middle]);
+}
+
+std::string jsonString(const std::string& s)
+{
+    std::ostringstream os;
+    os << '"';
+    BOOST_FOREACH(const char c, s)
+    {
+        switch(c)
+        {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20)
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+                else
+                    os << c;
+        }
+    }
+    os << '"';
+    return os.str();
+}
+}
+
+double BenchResult::median() const
+{
+    return bench::median(_seconds);
+}
+
+double BenchResult::megapixelsPerSecond() const
+{
+    const double seconds = median() - _sourceSeconds;
+    if(!_ok || seconds <= 0.0)
+        return 0.0;
+    return double(_config._width) * double(_config._height) * 1e-6 / seconds;
+}
+
+std::vector<BenchCase> defaultCases()
+{
+    std::vector<BenchCase> cases;
+
+    const char* generators[] = {"checkerboard", "colorbars", "ramp", "constant"};
+    BOOST_FOREACH(const char* generator, generators)
+    {
+        BenchCase c = makeCase(std::string("generator.") + generator, eCaseTypeGenerator);
+        c._nodes.push_back(NodeSpec(std::string("tuttle.") + generator));
+        cases.push_back(c);
+    }
+
+    cases.push_back(processCase("invert", NodeSpec("tuttle.invert")));
+    cases.push_back(processCase("gamma", NodeSpec("tuttle.gamma").param("master=2.2")));
+    cases.push_back(processCase("colorgradation", NodeSpec("tuttle.colorgradation").param("in=sRGB").param("out=Linear")));
+    cases.push_back(processCase("colorspace", NodeSpec("tuttle.colorspace").param("inGradationLaw=sRGB")));
+    cases.push_back(processCase("blur.gaussian", NodeSpec("tuttle.blur").param("size=10,10").param("algorithm=0")));
+    cases.push_back(processCase("blur.box", NodeSpec("tuttle.blur").param("size=10,10").param("algorithm=1")));
+    // the size of the blur is the variance of the gaussian
+    const int sigmas[] = {2, 8, 32, 64, 128};
+    BOOST_FOREACH(const int sigma, sigmas)
+    {
+        const std::string sigmaName = boost::lexical_cast<std::string>(sigma);
+        const std::string variance = boost::lexical_cast<std::string>(sigma * sigma);
+        const NodeSpec blur = NodeSpec("tuttle.blur").param("size=" + variance + "," + variance);
+        cases.push_back(processCase("blur.gaussian.sigma" + sigmaName, NodeSpec(blur).param("algorithm=0")));
+        cases.push_back(processCase("blur.box.sigma" + sigmaName, NodeSpec(blur).param("algorithm=1")));
+    }
+    cases.push_back(processCase("convolution", NodeSpec("tuttle.convolution")));
+    cases.push_back(processCase("sobel", NodeSpec("tuttle.sobel")));
+    cases.push_back(processCase("resize", NodeSpec("tuttle.resize").param("mode=scale").param("scale=0.5,0.5")));
+    cases.push_back(processCase("flip", NodeSpec("tuttle.flip").param("flip=1")));
+    cases.push_back(processCase("normalize", NodeSpec("tuttle.normalize")));
+
+    {
+        BenchCase c = makeCase("chain.grade", eCaseTypeProcess);
+        c._nodes.push_back(NodeSpec("tuttle.colorgradation").param("in=sRGB").param("out=Linear"));
+        c._nodes.push_back(NodeSpec("tuttle.gamma").param("master=2.2"));
+        c._nodes.push_back(NodeSpec("tuttle.invert"));
+        cases.push_back(c);
+    }
+    {
+        BenchCase c = makeCase("chain.edges", eCaseTypeProcess);
+        c._nodes.push_back(NodeSpec("tuttle.blur").param("size=2,2"));
+        c._nodes.push_back(NodeSpec("tuttle.sobel"));
+        cases.push_back(c);
+    }
+    {
+        BenchCase c = makeCase("chain.geometry", eCaseTypeProcess);
+        c._nodes.push_back(NodeSpec("tuttle.resize").param("mode=scale").param("scale=0.5,0.5"));
+        c._nodes.push_back(NodeSpec("tuttle.flip").param("flip=1"));
+        cases.push_back(c);
+    }
+
+    addIoCases(cases, "png", "png");
+    addIoCases(cases, "exr", "exr");
+    addExrWriteCases(cases);
+    addIoCases(cases, "oiio", "tif");
+
+    return cases;
+}
+
+Benchmark::Benchmark(const std::size_t nbWarmup, const std::size_t nbRepetitions,
+                     const boost::filesystem::path& ioDirectory, const std::string& sourcePluginId)
+    : _nbWarmup(nbWarmup)
+    , _nbRepetitions(std::max(nbRepetitions, std::size_t(1)))
+    , _ioDirectory(ioDirectory)
+    , _sourcePluginId(sourcePluginId)
+{
+}
+
+NodeSpec Benchmark::generator(const std::string& pluginId, const BenchConfig& config) const
+{
+    NodeSpec node(pluginId);
+    node.param("mode=1");
+    node.param("size=" + boost::lexical_cast<std::string>(config._width) + "," +
+               boost::lexical_cast<std::string>(config._height));
+    node.param("explicitConversion=" + explicitConversion(config._bitDepth));
+    return node;
+}
+
+boost::filesystem::path Benchmark::ioFile(const BenchCase& benchCase, const BenchConfig& config) const
+{
+    return _ioDirectory / ("tuttle-bench_" + benchCase._writer._pluginId + "_" + configKey(config) + "." +
+                           benchCase._extension);
+}
+
+std::vector<double> Benchmark::time(const std::vector<NodeSpec>& nodes, const BenchConfig& config) const
+{
+    using namespace tuttle::host;
+    typedef boost::chrono::steady_clock Clock;
+
+    Graph graph;
+    std::vector<Graph::Node*> graphNodes;
+    BOOST_FOREACH(const NodeSpec& spec, nodes)
+    {
+        Graph::Node& node = graph.createNode(spec._pluginId);
+        BOOST_FOREACH(const std::string& param, spec._params)
+        {
+            const std::size_t equal = param.find('=');
+            node.getParam(param.substr(0, equal)).setValueFromExpression(param.substr(equal + 1));
+        }
+        graphNodes.push_back(&node);
+    }
+    if(graphNodes.size() > 1)
+        graph.connect(graphNodes);
+
+    const ComputeOptions options(0);
+    std::vector<double> seconds;
+    for(std::size_t i = 0; i < _nbWarmup + _nbRepetitions; ++i)
+    {
+        // new caches for each compute: nothing is reused from the previous one
+        memory::MemoryCache outputCache;
+        memory::MemoryCache internCache;
+        const Clock::time_point begin = Clock::now();
+        if(!graph.compute(outputCache, *graphNodes.back(), options, internCache))
+            BOOST_THROW_EXCEPTION(exception::Failed() << exception::user("The compute failed."));
+        const Clock::time_point end = Clock::now();
+        if(i >= _nbWarmup)
+            seconds.push_back(boost::chrono::duration<double>(end - begin).count());
+    }
+    return seconds;
+}
+
+double Benchmark::sourceSeconds(const BenchConfig& config)
+{
+    const std::string key = configKey(config);
+    std::map<std::string, double>::const_iterator it = _sourceSeconds.find(key);
+    if(it != _sourceSeconds.end())
+        return it->second;
+    const double seconds = median(time(std::vector<NodeSpec>(1, generator(_sourcePluginId, config)), config));
+    _sourceSeconds[key] = seconds;
+    return seconds;
+}
+
+BenchResult Benchmark::run(const BenchCase& benchCase, const BenchConfig& config)
+{
+    BenchResult result;
+    result._name = benchCase._name;
+    result._type = benchCase._type;
+    result._config = config;
+    try
+    {
+        std::vector<NodeSpec> nodes;
+        switch(benchCase._type)
+        {
+            case eCaseTypeGenerator:
+            {
+                nodes.push_back(generator(benchCase._nodes.front()._pluginId, config));
+                break;
+            }
+            case eCaseTypeProcess:
+            {
+                nodes.push_back(generator(_sourcePluginId, config));
+                nodes.insert(nodes.end(), benchCase._nodes.begin(), benchCase._nodes.end());
+                result._sourceSeconds = sourceSeconds(config);
+                break;
+            }
+            case eCaseTypeWrite:
+            {
+                nodes.push_back(generator(_sourcePluginId, config));
+                nodes.push_back(benchCase._writer);
+                nodes.back().param("filename=" + ioFile(benchCase, config).string());
+                result._sourceSeconds = sourceSeconds(config);
+                break;
+            }
+            case eCaseTypeRead:
+            {
+                // the file written by the write case, or written now if this case runs alone
+                const boost::filesystem::path file = ioFile(benchCase, config);
+                if(!boost::filesystem::exists(file))
+                {
+                    std::vector<NodeSpec> writeNodes(1, generator(_sourcePluginId, config));
+                    writeNodes.push_back(benchCase._writer);
+                    writeNodes.back().param("filename=" + file.string());
+                    Benchmark(0, 1, _ioDirectory, _sourcePluginId).time(writeNodes, config);
+                }
+                nodes = benchCase._nodes;
+                nodes.back().param("filename=" + file.string());
+                break;
+            }
+        }
+        result._seconds = time(nodes, config);
+        result._ok = true;
+    }
+    catch(const boost::exception& e)
+    {
+        result._error = boost::diagnostic_information(e);
+    }
+    catch(const std::exception& e)
+    {
+        result._error = e.what();
+    }
+    catch(...)
+    {
+        result._error = "Unknown error.";
+    }
+    return result;
+}
+
+void writeJson(std::ostream& os, const std::vector<BenchResult>& results, const std::size_t nbWarmup,
+               const std::size_t nbRepetitions)
+{
+    char date[32];
+    const std::time_t now = std::time(NULL);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    os << std::setprecision(9);
+    os << "{\n";
+    os << "  \"date\": " << jsonString(date) << ",\n";
+    os << "  \"hardwareThreads\": " << boost::thread::hardware_concurrency() << ",\n";
+    os << "  \"warmup\": " << nbWarmup << ",\n";
+    os << "  \"repeat\": " << nbRepetitions << ",\n";
+    os << "  \"results\": [";
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& r = results[i];
+        os << (i ? "," : "") << "\n    {\n";
+        os << "      \"name\": " << jsonString(r._name) << ",\n";
+        os << "      \"type\": " << jsonString(caseTypeName(r._type)) << ",\n";
+        os << "      \"width\": " << r._config._width << ",\n";
+        os << "      \"height\": " << r._config._height << ",\n";
+        os << "      \"bitDepth\": " << jsonString(r._config._bitDepth) << ",\n";
+        os << "      \"threads\": " << r._config._nbThreads << ",\n";
+        os << "      \"ok\": " << (r._ok ? "true" : "false") << ",\n";
+        if(!r._ok)
+            os << "      \"error\": " << jsonString(r._error) << ",\n";
+        os << "      \"seconds\": [";
+        for(std::size_t s = 0; s < r._seconds.size(); ++s)
+            os << (s ? ", " : "") << r._seconds[s];
+        os << "],\n";
+        os << "      \"median\": " << r.median() << ",\n";
+        os << "      \"sourceMedian\": " << r._sourceSeconds << ",\n";
+        os << "      \"megapixelsPerSecond\": " << r.megapixelsPerSecond() << "\n";
+        os << "    }";
+    }
+    os << "\n  ]\n}\n";
+}
+}
+}
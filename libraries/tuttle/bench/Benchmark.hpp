@@ -0,0 +1,133 @@
+#ifndef _TUTTLE_BENCH_BENCHMARK_HPP_
+#define _TUTTLE_BENCH_BENCHMARK_HPP_
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle
+{
+namespace bench
+{
+
+/**
+ * @brief A node of a benchmarked graph: plugin identifier and parameters as "name=expression".
+ */
+struct NodeSpec
+{
+    NodeSpec() {}
+    explicit NodeSpec(const std::string& pluginId)
+        : _pluginId(pluginId)
+    {
+    }
+    NodeSpec& param(const std::string& nameAndExpression)
+    {
+        _params.push_back(nameAndExpression);
+        return *this;
+    }
+
+    std::string _pluginId;
+    std::vector<std::string> _params;
+};
+
+enum ECaseType
+{
+    eCaseTypeGenerator = 0, ///< a generator alone
+    eCaseTypeProcess,       ///< the source generator followed by the nodes
+    eCaseTypeWrite,         ///< the source generator followed by a writer into the io directory
+    eCaseTypeRead           ///< a reader of the file written by the same writer, the missing file is written untimed
+};
+
+/**
+ * @brief A linear graph to time.
+ */
+struct BenchCase
+{
+    std::string _name;
+    ECaseType _type;
+    std::vector<NodeSpec> _nodes;
+    /// read and write cases: writer of the file, and extension of the file
+    NodeSpec _writer;
+    std::string _extension;
+};
+
+/**
+ * @brief Resolution, bit depth and number of threads of a run.
+ */
+struct BenchConfig
+{
+    int _width;
+    int _height;
+    std::string _bitDepth; ///< "8i", "16i" or "32f"
+    std::size_t _nbThreads; ///< 0 for all the hardware threads
+};
+
+struct BenchResult
+{
+    BenchResult()
+        : _ok(false)
+        , _sourceSeconds(0.0)
+    {
+    }
+
+    double median() const;
+    double megapixelsPerSecond() const;
+
+    std::string _name;
+    ECaseType _type;
+    BenchConfig _config;
+    bool _ok;
+    std::string _error;
+    std::vector<double> _seconds; ///< each timed repetition
+    double _sourceSeconds;        ///< median of the source generator alone, for process and write cases
+};
+
+/**
+ * @brief Default cases: the generators, the common process plugins, a few chains, and the io plugins.
+ */
+std::vector<BenchCase> defaultCases();
+
+/**
+ * @brief Time graphs built from generators with Graph::compute.
+ *
+ * Each measure is a full compute of frame 0, without any memory or disk cache between the computes,
+ * after the warm-up computes (plugin loading, first allocations).
+ */
+class Benchmark
+{
+public:
+    Benchmark(const std::size_t nbWarmup, const std::size_t nbRepetitions, const boost::filesystem::path& ioDirectory,
+              const std::string& sourcePluginId = "tuttle.colorbars");
+
+    BenchResult run(const BenchCase& benchCase, const BenchConfig& config);
+
+private:
+    /// Compute the nodes nbWarmup + nbRepetitions times, the last ones timed
+    std::vector<double> time(const std::vector<NodeSpec>& nodes, const BenchConfig& config) const;
+    /// Median time of the source generator alone, measured once by configuration
+    double sourceSeconds(const BenchConfig& config);
+    /// Parameters of a generator for the configuration
+    NodeSpec generator(const std::string& pluginId, const BenchConfig& config) const;
+    boost::filesystem::path ioFile(const BenchCase& benchCase, const BenchConfig& config) const;
+
+private:
+    std::size_t _nbWarmup;
+    std::size_t _nbRepetitions;
+    boost::filesystem::path _ioDirectory;
+    std::string _sourcePluginId;
+    std::map<std::string, double> _sourceSeconds;
+};
+
+/**
+ * @brief Write the results as a JSON document, with the description of the machine and of the run.
+ */
+void writeJson(std::ostream& os, const std::vector<BenchResult>& results, const std::size_t nbWarmup,
+               const std::size_t nbRepetitions);
+}
+}
+
+#endif
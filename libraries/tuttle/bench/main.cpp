@@ -0,0 +1,174 @@
+#include "Benchmark.hpp"
+
+#include <tuttle/host/Core.hpp>
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+
+void usage()
+{
+    std::cout << "Usage: tuttle-bench [options]\n"
+                 "Time graphs of generators and process plugins with Graph::compute, and write the results as JSON.\n"
+                 "  --resolutions <WxH,...>  default 1920x1080,3840x2160\n"
+                 "  --bitdepths <8i,16i,32f> default 8i,16i,32f\n"
+                 "  --threads <n,...>        number of threads of each run, 0 for all the cores (default 1,0)\n"
+                 "  --warmup <n>             untimed computes before the measures (default 1)\n"
+                 "  --repeat <n>             timed computes (default 5)\n"
+                 "  --filter <substring>     only the cases whose name contains the substring\n"
+                 "  --io-dir <directory>     files of the readers and writers (default /dev/shm, or the temp directory)\n"
+                 "  --output <file.json>     default the standard output\n"
+                 "  --list                   print the names of the cases\n";
+}
+
+std::vector<std::string> splitList(const std::string& s)
+{
+    std::vector<std::string> values;
+    boost::algorithm::split(values, s, boost::algorithm::is_any_of(","));
+    return values;
+}
+}
+
+int main(int argc, char** argv)
+{
+    using namespace tuttle::bench;
+
+    std::vector<std::string> resolutions = splitList("1920x1080,3840x2160");
+    std::vector<std::string> bitDepths = splitList("8i,16i,32f");
+    std::vector<std::string> threads = splitList("1,0");
+    std::size_t nbWarmup = 1;
+    std::size_t nbRepetitions = 5;
+    std::string filter;
+    std::string outputFilename;
+    boost::filesystem::path ioDirectory =
+        boost::filesystem::is_directory("/dev/shm") ? "/dev/shm" : boost::filesystem::temp_directory_path();
+    bool list = false;
+
+    try
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if(arg == "--help" || arg == "-h")
+            {
+                usage();
+                return EXIT_SUCCESS;
+            }
+            if(arg == "--list")
+            {
+                list = true;
+                continue;
+            }
+            if(i + 1 >= argc)
+            {
+                usage();
+                return EXIT_FAILURE;
+            }
+            const std::string value = argv[++i];
+            if(arg == "--resolutions")
+                resolutions = splitList(value);
+            else if(arg == "--bitdepths")
+                bitDepths = splitList(value);
+            else if(arg == "--threads")
+                threads = splitList(value);
+            else if(arg == "--warmup")
+                nbWarmup = boost::lexical_cast<std::size_t>(value);
+            else if(arg == "--repeat")
+                nbRepetitions = boost::lexical_cast<std::size_t>(value);
+            else if(arg == "--filter")
+                filter = value;
+            else if(arg == "--io-dir")
+                ioDirectory = value;
+            else if(arg == "--output")
+                outputFilename = value;
+            else
+            {
+                usage();
+                return EXIT_FAILURE;
+            }
+        }
+
+        std::vector<BenchCase> cases;
+        BOOST_FOREACH(const BenchCase& c, defaultCases())
+        {
+            if(c._name.find(filter) != std::string::npos)
+                cases.push_back(c);
+        }
+        if(list)
+        {
+            BOOST_FOREACH(const BenchCase& c, cases)
+                std::cout << c._name << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        std::vector<BenchConfig> configs;
+        BOOST_FOREACH(const std::string& threadsValue, threads)
+        {
+            BOOST_FOREACH(const std::string& resolution, resolutions)
+            {
+                BOOST_FOREACH(const std::string& bitDepth, bitDepths)
+                {
+                    const std::size_t x = resolution.find('x');
+                    BenchConfig config;
+                    config._width = boost::lexical_cast<int>(resolution.substr(0, x));
+                    config._height = boost::lexical_cast<int>(resolution.substr(x + 1));
+                    config._bitDepth = bitDepth;
+                    config._nbThreads = boost::lexical_cast<std::size_t>(threadsValue);
+                    configs.push_back(config);
+                }
+            }
+        }
+
+        tuttle::host::Core& core = tuttle::host::core();
+        core.getPreferences().setMemoryCacheMaxSize(0);
+        core.preload();
+
+        Benchmark benchmark(nbWarmup, nbRepetitions, ioDirectory);
+        std::vector<BenchResult> results;
+        std::size_t nbThreads = std::size_t(-1);
+        BOOST_FOREACH(const BenchConfig& config, configs)
+        {
+            if(config._nbThreads != nbThreads)
+            {
+                nbThreads = config._nbThreads;
+                core.getPreferences().setNbThreads(nbThreads);
+                core.resetThreadPool();
+            }
+            BOOST_FOREACH(const BenchCase& c, cases)
+            {
+                results.push_back(benchmark.run(c, config));
+                const BenchResult& r = results.back();
+                std::cerr << c._name << " " << config._width << "x" << config._height << " " << config._bitDepth
+                          << " threads=" << config._nbThreads << ": ";
+                if(r._ok)
+                    std::cerr << r.median() << "s" << std::endl;
+                else
+                    std::cerr << "error" << std::endl;
+            }
+        }
+
+        if(outputFilename.empty())
+            writeJson(std::cout, results, nbWarmup, nbRepetitions);
+        else
+        {
+            std::ofstream output(outputFilename.c_str());
+            writeJson(output, results, nbWarmup, nbRepetitions);
+        }
+    }
+    catch(...)
+    {
+        TUTTLE_LOG_CURRENT_EXCEPTION;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -27,3 +27,27 @@ def testOutputMemoryCache():
 	print('imgRes:', dir( imgRes ))
 	print('FullName:', imgRes.getFullName())
 	print('MemorySize:', imgRes.getMemorySize())
+
+
+def testNodeResultsMemoryCache():
+
+	preferences = tuttle.core().getPreferences()
+	preferences.setMemoryCacheMaxSize( 64 * 1024 * 1024 )
+	internCache = tuttle.core().getMemoryCache()
+	internCache.resetCounters()
+
+	nodes = [
+			tuttle.NodeInit( "tuttle.checkerboard", format="PAL", explicitConversion="8i" ),
+			tuttle.NodeInit( "tuttle.blur", size=.2 ),
+			tuttle.NodeInit( "tuttle.invert" ),
+		]
+	tuttle.compute( tuttle.MemoryCache(), nodes )
+	assert_equal( 0, internCache.getHitCount() )
+	assert internCache.getResultsMemorySize() > 0
+
+	# the blur result is reused, only the final node is processed again
+	tuttle.compute( tuttle.MemoryCache(), nodes )
+	assert_equal( 1, internCache.getHitCount() )
+
+	preferences.setMemoryCacheMaxSize( 0 )
+	internCache.clearAll()
@@ -0,0 +1,49 @@
+from pyTuttle import tuttle
+import os
+import shutil
+import tempfile
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def cachedFiles(rootDir):
+	files = []
+	for dirpath, dirnames, filenames in os.walk(rootDir):
+		files.extend([f for f in filenames if f.endswith(".tuttlecache")])
+	return files
+
+
+def testRenderDiskCache():
+
+	cacheDir = tempfile.mkdtemp( prefix="renderDiskCacheTest-" )
+	preferences = tuttle.core().getPreferences()
+	preferences.setRenderDiskCachePathStr( cacheDir )
+	try:
+		nodes = [
+				tuttle.NodeInit( "tuttle.checkerboard", format="PAL", explicitConversion="8i" ),
+				tuttle.NodeInit( "tuttle.blur", size=.2 ),
+				tuttle.NodeInit( "tuttle.invert" ),
+			]
+		outputCache = tuttle.MemoryCache()
+		tuttle.compute( outputCache, nodes )
+		# only the blur result is saved: the reader and the final node are always processed
+		assert_equal( 1, len(cachedFiles(cacheDir)) )
+
+		# loaded from the disk cache
+		outputCacheFromDisk = tuttle.MemoryCache()
+		tuttle.compute( outputCacheFromDisk, nodes )
+		assert_equal( 1, len(cachedFiles(cacheDir)) )
+		assert_equal( outputCache.get(0).getMemorySize(), outputCacheFromDisk.get(0).getMemorySize() )
+
+		# files above the disk budget are removed at the end of the render
+		preferences.setRenderDiskCacheMaxSize( 1 )
+		tuttle.compute( tuttle.MemoryCache(), nodes )
+		assert_equal( 0, len(cachedFiles(cacheDir)) )
+	finally:
+		preferences.setRenderDiskCachePathStr( "" )
+		preferences.setRenderDiskCacheMaxSize( 0 )
+		shutil.rmtree( cacheDir )
@@ -1,6 +1,9 @@
 #ifndef _TUTTLE_HOST_CORE_COMPUTEOPTIONS_HPP_
 #define _TUTTLE_HOST_CORE_COMPUTEOPTIONS_HPP_
 
+#include "MemoryReport.hpp"
+#include "Tracer.hpp"
+
 #include <tuttle/common/utils/global.hpp>
 
 #include <ofxCore.h>
@@ -9,6 +12,7 @@
 
 #include <tuttle/common/atomic.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <limits>
 #include <list>
@@ -107,8 +111,14 @@ public:
         _continueOnError = other._continueOnError;
         _continueOnMissingFile = other._continueOnMissingFile;
         _forceIdentityNodesProcess = other._forceIdentityNodesProcess;
+        _incrementalSetup = other._incrementalSetup;
+        _fusePointwiseNodes = other._fusePointwiseNodes;
         _returnBuffers = other._returnBuffers;
         _isInteractive = other._isInteractive;
+        _nbParallelFrames = other._nbParallelFrames;
+        _tracer = other._tracer;
+        _traceFilename = other._traceFilename;
+        _memoryReport = other._memoryReport;
 
         // don't modify the abort status?
         //_abort.store( false, boost::memory_order_relaxed );
@@ -126,6 +136,9 @@ private:
         setColorEnable(false);
         setIsInteractive(false);
         setForceIdentityNodesProcess(false);
+        setIncrementalSetup(true);
+        setFusePointwiseNodes(false);
+        setNbParallelFrames(1);
     }
 
 public:
@@ -242,6 +255,76 @@ public:
     }
     bool getForceIdentityNodesProcess() const { return _forceIdentityNodesProcess; }
 
+    /**
+     * @brief Reuse the graph at time of the previous frame when the nodes need the same times relative to the frame,
+     * only updating the times. Disable it to rebuild the graph at each frame.
+     */
+    This& setIncrementalSetup(const bool v = true)
+    {
+        _incrementalSetup = v;
+        return *this;
+    }
+    bool getIncrementalSetup() const { return _incrementalSetup; }
+
+    /**
+     * @brief Render the chains of pointwise nodes in the same buffer, all the nodes of the chain band by band,
+     * instead of writing and reading a full image between each node.
+     * The intermediate results of these chains are not kept in the result cache.
+     */
+    This& setFusePointwiseNodes(const bool v = true)
+    {
+        _fusePointwiseNodes = v;
+        return *this;
+    }
+    bool getFusePointwiseNodes() const { return _fusePointwiseNodes; }
+
+    /**
+     * @brief Number of frames rendered at the same time.
+     * Each frame in flight works on its own copy of the nodes and all of them share the MemoryPool.
+     * Set 0 to use the number of hardware threads.
+     */
+    This& setNbParallelFrames(const std::size_t v = 0)
+    {
+        _nbParallelFrames = v;
+        return *this;
+    }
+    std::size_t getNbParallelFrames() const { return _nbParallelFrames; }
+
+    /**
+     * @brief Record the spans of the compute into @p tracer: setup, frames, visitors, render actions,
+     * allocations and results found in cache. Set a NULL tracer to disable the tracing.
+     */
+    This& setTracer(const boost::shared_ptr<Tracer>& tracer)
+    {
+        _tracer = tracer;
+        return *this;
+    }
+    const boost::shared_ptr<Tracer>& getTracer() const { return _tracer; }
+
+    /**
+     * @brief Write the trace in the Chrome trace event format to @p filename at the end of each compute.
+     * Creates a tracer if there is none. An empty filename disables the export.
+     */
+    This& setTraceFilename(const std::string& filename)
+    {
+        _traceFilename = filename;
+        if(!filename.empty() && !_tracer)
+            _tracer.reset(new Tracer());
+        return *this;
+    }
+    const std::string& getTraceFilename() const { return _traceFilename; }
+
+    /**
+     * @brief Add the memory used by each frame to @p report: predicted and measured peaks,
+     * and the owners of the buffers at the peak. Set a NULL report to disable it.
+     */
+    This& setMemoryReport(const boost::shared_ptr<MemoryReport>& report)
+    {
+        _memoryReport = report;
+        return *this;
+    }
+    const boost::shared_ptr<MemoryReport>& getMemoryReport() const { return _memoryReport; }
+
     /**
      * @brief The application would like to abort the process (from another thread).
      */
@@ -253,38 +336,51 @@ public:
 
     /**
     * @brief A handle to follow the progress (start, end...) of the compute
+    * The handle calls are serialized, even when frames are rendered in parallel.
     */
     void setProgressHandle(boost::shared_ptr<IProgressHandle> progressHandle) { _progressHandle = progressHandle; }
     bool isProgressHandleSet() const { return _progressHandle.get() != NULL; }
     void beginSequenceHandle() const
     {
-        if(isProgressHandleSet())
-            _progressHandle->beginSequence();
+        if(!isProgressHandleSet())
+            return;
+        boost::mutex::scoped_lock locker(_progressHandleMutex);
+        _progressHandle->beginSequence();
     }
     void beginFrameHandle() const
     {
-        if(isProgressHandleSet())
-            _progressHandle->beginFrame();
+        if(!isProgressHandleSet())
+            return;
+        boost::mutex::scoped_lock locker(_progressHandleMutex);
+        _progressHandle->beginFrame();
     }
     void setupAtTimeHandle() const
     {
-        if(isProgressHandleSet())
-            _progressHandle->setupAtTime();
+        if(!isProgressHandleSet())
+            return;
+        boost::mutex::scoped_lock locker(_progressHandleMutex);
+        _progressHandle->setupAtTime();
     }
     void processAtTimeHandle() const
     {
-        if(isProgressHandleSet())
-            _progressHandle->processAtTime();
+        if(!isProgressHandleSet())
+            return;
+        boost::mutex::scoped_lock locker(_progressHandleMutex);
+        _progressHandle->processAtTime();
     }
     void endFrameHandle() const
     {
-        if(isProgressHandleSet())
-            _progressHandle->endFrame();
+        if(!isProgressHandleSet())
+            return;
+        boost::mutex::scoped_lock locker(_progressHandleMutex);
+        _progressHandle->endFrame();
     }
     void endSequenceHandle() const
     {
-        if(isProgressHandleSet())
-            _progressHandle->endSequence();
+        if(!isProgressHandleSet())
+            return;
+        boost::mutex::scoped_lock locker(_progressHandleMutex);
+        _progressHandle->endSequence();
     }
 
 private:
@@ -298,12 +394,20 @@ private:
     bool _continueOnError;
     bool _continueOnMissingFile;
     bool _forceIdentityNodesProcess;
+    bool _incrementalSetup;
+    bool _fusePointwiseNodes;
     bool _returnBuffers;
     bool _isInteractive;
+    std::size_t _nbParallelFrames;
 
     boost::atomic_bool _abort;
 
+    boost::shared_ptr<Tracer> _tracer;
+    std::string _traceFilename;
+    boost::shared_ptr<MemoryReport> _memoryReport;
+
     boost::shared_ptr<IProgressHandle> _progressHandle;
+    mutable boost::mutex _progressHandleMutex; ///< frames rendered in parallel notify the handle from several threads
 };
 }
 }
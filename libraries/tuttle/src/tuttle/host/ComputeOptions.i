@@ -3,6 +3,7 @@
 %include <boost_shared_ptr.i>
 %include <std_list.i>
 %include <std_string.i>
+%include <std_vector.i>
 
 
 %{
@@ -10,6 +11,8 @@
 %}
 
 %shared_ptr(tuttle::host::IProgressHandle)
+%shared_ptr(tuttle::host::Tracer)
+%shared_ptr(tuttle::host::MemoryReport)
 
 namespace std {
 %template(TimeRangeList) list<tuttle::host::TimeRange>;
@@ -36,5 +39,13 @@ namespace host {
 }
 
 
+%include <tuttle/host/memory/IMemoryPool.i>
+
+namespace std {
+%template(BufferUsageVector) vector<tuttle::host::memory::BufferUsage>;
+}
+
+%include <tuttle/host/MemoryReport.hpp>
+%include <tuttle/host/Tracer.hpp>
 %include <tuttle/host/ComputeOptions.hpp>
 
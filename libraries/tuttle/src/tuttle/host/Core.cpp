@@ -1,4 +1,5 @@
 #include "Core.hpp"
+#include "ThreadPool.hpp"
 
 #include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
 #include <tuttle/host/memory/MemoryPool.hpp>
@@ -67,6 +68,22 @@ Core::~Core()
 {
 }
 
+ThreadPool& Core::getThreadPool()
+{
+    boost::mutex::scoped_lock locker(_threadPoolMutex);
+    if(!_threadPool)
+        _threadPool.reset(new ThreadPool(getPreferences().getNbThreads()));
+    return *_threadPool;
+}
+
+void Core::resetThreadPool()
+{
+    boost::mutex::scoped_lock locker(_threadPoolMutex);
+    // the workers of the previous pool are joined before the new ones are created
+    _threadPool.reset();
+    _threadPool.reset(new ThreadPool(getPreferences().getNbThreads()));
+}
+
 void Core::preload(const bool useCache)
 {
     _isPreloaded = true;
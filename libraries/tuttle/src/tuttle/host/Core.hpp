@@ -14,12 +14,16 @@
 
 #include <boost/preprocessor/stringize.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace tuttle
 {
 namespace host
 {
 
+class ThreadPool;
+
 class Core : public Singleton<Core>
 {
 public:
@@ -41,6 +45,11 @@ private:
 
     Preferences _preferences;
 
+#ifndef SWIG
+    boost::scoped_ptr<ThreadPool> _threadPool;
+    boost::mutex _threadPoolMutex;
+#endif
+
 public:
     ofx::OfxhPluginCache& getPluginCache() { return _pluginCache; }
     const ofx::OfxhPluginCache& getPluginCache() const { return _pluginCache; }
@@ -62,6 +71,19 @@ public:
     memory::IMemoryCache& getMemoryCache() { return _memoryCache; }
     const memory::IMemoryCache& getMemoryCache() const { return _memoryCache; }
 
+#ifndef SWIG
+    /**
+     * @brief Threads shared by all renders, created on first use with Preferences::getNbThreads().
+     */
+    ThreadPool& getThreadPool();
+
+    /**
+     * @brief Create the threads again with the current Preferences::getNbThreads().
+     * Must not be called during a render.
+     */
+    void resetThreadPool();
+#endif
+
 public:
     ofx::imageEffect::OfxhImageEffectPlugin* getImageEffectPluginById(const std::string& id, int vermaj = -1,
                                                                       int vermin = -1)
@@ -1,5 +1,6 @@
 #include "Graph.hpp"
 #include "Node.hpp"
+#include "Tracer.hpp"
 #include "graph/ProcessGraph.hpp"
 
 #include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
@@ -20,6 +21,39 @@ namespace tuttle
 namespace host
 {
 
+namespace
+{
+
+/**
+ * @brief Write the trace of the compute at the end of the scope, also when the compute has failed.
+ */
+class TraceExport
+{
+public:
+    explicit TraceExport(const ComputeOptions& options)
+        : _options(options)
+    {
+    }
+    ~TraceExport()
+    {
+        if(!_options.getTracer() || _options.getTraceFilename().empty())
+            return;
+        try
+        {
+            _options.getTracer()->exportChromeTrace(_options.getTraceFilename());
+        }
+        catch(...)
+        {
+            TUTTLE_LOG_ERROR("[Graph compute] Unable to write the trace " << quotes(_options.getTraceFilename())
+                                                                            << ".");
+        }
+    }
+
+private:
+    const ComputeOptions& _options;
+};
+}
+
 Graph::Graph()
 {
 }
@@ -363,6 +397,10 @@ bool Graph::compute(memory::IMemoryCache& memoryCache, const NodeListArg& nodes,
     graph::exportAsDOT("graph.dot", _graph);
 #endif
 
+    const TraceExport traceExport(options);
+    const TraceScope traceScope(options.getTracer().get());
+    const TraceSpan trace("graph", "compute");
+
     graph::ProcessGraph procGraph(options, *this, nodes.getNodes(), internMemoryCache);
     return procGraph.process(memoryCache);
 }
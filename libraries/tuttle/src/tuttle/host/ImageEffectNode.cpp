@@ -3,6 +3,7 @@
 
 // ofx host
 #include <tuttle/host/Core.hpp> // for core().getMemoryCache()
+#include <tuttle/host/Tracer.hpp>
 #include <tuttle/host/attribute/ClipImage.hpp>
 #include <tuttle/host/attribute/allParams.hpp>
 #include <tuttle/host/graph/ProcessEdgeAtTime.hpp>
@@ -20,6 +21,7 @@
 #include <tuttle/host/ofx/property/OfxhSet.hpp>
 #include <tuttle/host/ofx/attribute/OfxhClip.hpp>
 #include <tuttle/host/ofx/attribute/OfxhParam.hpp>
+#include <tuttle/host/ofx/attribute/OfxhParamString.hpp>
 
 // ofx
 #include <ofxCore.h>
@@ -29,6 +31,8 @@
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
@@ -139,6 +143,23 @@ std::size_t ImageEffectNode::getLocalHashAtTime(const OfxTime time) const
     return seed;
 }
 
+bool ImageEffectNode::hasFileIdentityAtTime(const OfxTime time) const
+{
+    // the files of a writer are its outputs
+    if(getContext() == kOfxImageEffectContextWriter)
+        return true;
+    BOOST_FOREACH(const ofx::attribute::OfxhParam& param, getParamSet().getParamVector())
+    {
+        // like the hash at time, only the params changing the images
+        if(!param.getEvaluateOnChange())
+            continue;
+        const ofx::attribute::OfxhParamString* paramString = dynamic_cast<const ofx::attribute::OfxhParamString*>(&param);
+        if(paramString && !paramString->hasFileIdentityAtTime(time))
+            return false;
+    }
+    return true;
+}
+
 /**
  * @return 1 to abort processing
  */
@@ -813,28 +834,35 @@ void ImageEffectNode::preProcess_infos(const graph::ProcessVertexAtTimeData& vDa
                                        graph::ProcessVertexAtTimeInfo& nodeInfos) const
 {
     //	TUTTLE_LOG_INFO( "preProcess_infos: " << getName() );
-    const OfxRectD rod = vData._apiImageEffect._renderRoD;
-    const std::size_t bitDepth = this->getOutputClip().getBitDepth(); // value in bytes
-    const std::size_t nbComponents = getOutputClip().getNbComponents();
-    nodeInfos._memory = std::ceil((rod.x2 - rod.x1) * (rod.y2 - rod.y1) * nbComponents * bitDepth);
+    // size of the output image allocated by the process, see attribute::Image
+    const OfxRectD roi = vData._apiImageEffect._renderRoI;
+    const attribute::ClipImage& clip = getOutputClip();
+    double par = clip.getPixelAspectRatio();
+    if(par == 0.0)
+        par = 1.0;
+    const std::size_t width = static_cast<std::size_t>(std::max(std::ceil(roi.x2 / par) - std::floor(roi.x1 / par), 0.0));
+    const std::size_t height = static_cast<std::size_t>(std::max(std::ceil(roi.y2) - std::floor(roi.y1), 0.0));
+    nodeInfos._memory = width * height * clip.getPixelMemorySize();
 }
 
-void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
+OfxRectI ImageEffectNode::getRenderWindow(const graph::ProcessVertexAtTimeData& vData) const
+{
+    double par = this->getOutputClip().getPixelAspectRatio();
+    if(par == 0.0)
+        par = 1.0;
+    const OfxRectI renderWindow = {boost::numeric_cast<int>(std::floor(vData._apiImageEffect._renderRoI.x1 / par)),
+                                   boost::numeric_cast<int>(std::floor(vData._apiImageEffect._renderRoI.y1)),
+                                   boost::numeric_cast<int>(std::ceil(vData._apiImageEffect._renderRoI.x2 / par)),
+                                   boost::numeric_cast<int>(std::ceil(vData._apiImageEffect._renderRoI.y2))};
+    return renderWindow;
+}
+
+void ImageEffectNode::beginProcess(graph::ProcessVertexAtTimeData& vData, std::list<memory::CACHE_ELEMENT>& neededDatas,
+                                   const memory::IPoolDataPtr& outputData)
 {
     try
     {
         memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
-        // keep the hand on all needed datas during the process function
-        std::list<memory::CACHE_ELEMENT> allNeededDatas;
-
-        double par = this->getOutputClip().getPixelAspectRatio();
-        if(par == 0.0)
-            par = 1.0;
-        const OfxRectI renderWindow = {boost::numeric_cast<int>(std::floor(vData._apiImageEffect._renderRoI.x1 / par)),
-                                       boost::numeric_cast<int>(std::floor(vData._apiImageEffect._renderRoI.y1)),
-                                       boost::numeric_cast<int>(std::ceil(vData._apiImageEffect._renderRoI.x2 / par)),
-                                       boost::numeric_cast<int>(std::ceil(vData._apiImageEffect._renderRoI.y2))};
-        //		TUTTLE_LOG_VAR( TUTTLE_INFO, roi );
 
         //		INode::ClipTimesSetMap timesSetMap = this->getFramesNeeded( vData._time );
 
@@ -876,7 +904,7 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
                                                                  " not in memory cache (identifier:" +
                                                                  quotes(clip.getClipIdentifier()) + ").");
             }
-            allNeededDatas.push_back(imageCache);
+            neededDatas.push_back(imageCache);
         }
 
         TUTTLE_LOG_INFO("[Node Process] Acquire needed output clip images");
@@ -889,18 +917,63 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
                 memory::CACHE_ELEMENT imageCache(new attribute::Image(clip, vData._time, vData._apiImageEffect._renderRoI,
                                                                       attribute::Image::eImageOrientationFromBottomToTop,
                                                                       0));
-                imageCache->setPoolData(core().getMemoryPool().allocate(imageCache->getMemorySize()));
+                if(outputData.get() == NULL)
+                {
+                    imageCache->setPoolData(core().getMemoryPool().allocate(
+                        imageCache->getMemorySize(), memory::BufferOwner(getName(), clip.getName(), vData._time)));
+                }
+                else
+                {
+                    if(outputData->size() < imageCache->getMemorySize())
+                    {
+                        BOOST_THROW_EXCEPTION(exception::Memory()
+                                              << exception::dev() + "Buffer too small for the output clip " +
+                                                     quotes(clip.getFullName()) + " (" + outputData->size() + " < " +
+                                                     imageCache->getMemorySize() + ").");
+                    }
+                    // render in place, in the buffer of a previous node
+                    imageCache->setPoolData(outputData);
+                }
                 memoryCache.put(clip.getClipIdentifier(), vData._time, imageCache);
 
-                allNeededDatas.push_back(imageCache);
+                neededDatas.push_back(imageCache);
             }
         }
+    }
+    catch(boost::exception& e)
+    {
+        e << exception::time(vData._time) << exception::pluginIdentifier(this->getPlugin().getIdentifier())
+          << exception::nodeName(this->getName());
+        throw;
+    }
+}
 
+void ImageEffectNode::renderProcess(graph::ProcessVertexAtTimeData& vData, const OfxRectI& renderWindow)
+{
+    try
+    {
         TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action");
 
-        renderAction(vData._time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale);
+        {
+            const TraceSpan trace("node", "renderAction", getName());
+            renderAction(vData._time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale);
+        }
 
         TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action - End");
+    }
+    catch(boost::exception& e)
+    {
+        e << exception::time(vData._time) << exception::pluginIdentifier(this->getPlugin().getIdentifier())
+          << exception::nodeName(this->getName());
+        throw;
+    }
+}
+
+void ImageEffectNode::endProcess(graph::ProcessVertexAtTimeData& vData)
+{
+    try
+    {
+        memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
 
         debugOutputImage(vData._time);
 
@@ -970,6 +1043,16 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
     }
 }
 
+void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
+{
+    // keep the hand on all needed datas during the process function
+    std::list<memory::CACHE_ELEMENT> allNeededDatas;
+
+    beginProcess(vData, allNeededDatas);
+    renderProcess(vData, getRenderWindow(vData));
+    endProcess(vData);
+}
+
 void ImageEffectNode::postProcess(graph::ProcessVertexAtTimeData& vData)
 {
     //	TUTTLE_LOG_INFO( "postProcess: " << getName() );
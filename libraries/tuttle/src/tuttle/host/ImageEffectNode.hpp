@@ -7,11 +7,14 @@
 #include <tuttle/host/attribute/ClipImage.hpp>
 #include <tuttle/host/graph/ProcessVertexData.hpp>
 #include <tuttle/host/graph/ProcessVertexAtTimeData.hpp>
+#include <tuttle/host/memory/IMemoryCache.hpp>
 
 #include <tuttle/host/ofx/OfxhImageEffectNode.hpp>
 
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <list>
+
 namespace tuttle
 {
 namespace host
@@ -111,6 +114,12 @@ public:
 
     std::size_t getLocalHashAtTime(const OfxTime time) const;
 
+    /**
+     * @brief All the files read by the node at @p time exist, so the hash at time identifies their content
+     * by their last write time and size. False if a file path is not resolved by the host (like a sequence "@").
+     */
+    bool hasFileIdentityAtTime(const OfxTime time) const;
+
     OfxRectD getRegionOfDefinition(const OfxTime time) const { return getData(time)._apiImageEffect._renderRoD; }
 
     OfxRangeD getTimeDomain() const { return getData()._timeDomain; }
@@ -143,6 +152,25 @@ public:
     void endSequence(graph::ProcessVertexData& vData);
     /// @}
 
+#ifndef SWIG
+    /// @group Steps of process(), to render several nodes in the same buffer
+    /// @{
+    /**
+     * @brief Acquire the input images and create the output image.
+     * @param[out] neededDatas the images to keep until the end of the process
+     * @param[in] outputData buffer of the output image, allocated from the memory pool if null
+     */
+    void beginProcess(graph::ProcessVertexAtTimeData& vData, std::list<memory::CACHE_ELEMENT>& neededDatas,
+                      const memory::IPoolDataPtr& outputData = memory::IPoolDataPtr());
+    /// @brief Pixels of the output image to render, computed from the RoI.
+    OfxRectI getRenderWindow(const graph::ProcessVertexAtTimeData& vData) const;
+    /// @brief Render the pixels of @p renderWindow, which may be a part of the render window.
+    void renderProcess(graph::ProcessVertexAtTimeData& vData, const OfxRectI& renderWindow);
+    /// @brief Release the input images and declare the future usages of the output image.
+    void endProcess(graph::ProcessVertexAtTimeData& vData);
+    /// @}
+#endif
+
     std::ostream& print(std::ostream& os) const;
 
     friend std::ostream& operator<<(std::ostream& os, const This& v);
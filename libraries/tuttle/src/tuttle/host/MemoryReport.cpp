@@ -0,0 +1,117 @@
+#include "MemoryReport.hpp"
+
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+
+namespace tuttle
+{
+namespace host
+{
+
+namespace
+{
+
+void writeJsonString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    BOOST_FOREACH(const char c, s)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+        else
+            os << c;
+    }
+    os << '"';
+}
+}
+
+void MemoryReport::clear()
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _frames.clear();
+}
+
+std::size_t MemoryReport::getNbFrames() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _frames.size();
+}
+
+FrameMemoryUsage MemoryReport::getFrame(const std::size_t index) const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    if(index >= _frames.size())
+        BOOST_THROW_EXCEPTION(exception::Value() << exception::user() + "No frame " + index + " in the memory report.");
+    return _frames[index];
+}
+
+std::size_t MemoryReport::getPeakUsedMemorySize() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    std::size_t peak = 0;
+    BOOST_FOREACH(const FrameMemoryUsage& frame, _frames)
+    {
+        peak = std::max(peak, frame._poolPeakUsed);
+    }
+    return peak;
+}
+
+std::size_t MemoryReport::getPredictedPeakMemorySize() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    std::size_t peak = 0;
+    BOOST_FOREACH(const FrameMemoryUsage& frame, _frames)
+    {
+        peak = std::max(peak, frame._predictedPeak);
+    }
+    return peak;
+}
+
+void MemoryReport::addFrame(const FrameMemoryUsage& frame)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _frames.push_back(frame);
+}
+
+void MemoryReport::exportJson(std::ostream& os) const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    os << "{\"frames\":[";
+    for(std::size_t i = 0; i < _frames.size(); ++i)
+    {
+        const FrameMemoryUsage& frame = _frames[i];
+        os << (i ? ",\n" : "\n") << "{\"time\":" << frame._time << ",\"predictedPeak\":" << frame._predictedPeak
+           << ",\"poolPeakUsed\":" << frame._poolPeakUsed << ",\"poolPeakAllocated\":" << frame._poolPeakAllocated
+           << ",\"cachePeak\":" << frame._cachePeak << ",\"peakBuffers\":[";
+        for(std::size_t b = 0; b < frame._peakBuffers.size(); ++b)
+        {
+            const memory::BufferUsage& buffer = frame._peakBuffers[b];
+            os << (b ? "," : "") << "{\"node\":";
+            writeJsonString(os, buffer._owner._node);
+            os << ",\"clip\":";
+            writeJsonString(os, buffer._owner._clip);
+            os << ",\"time\":" << buffer._owner._time << ",\"size\":" << buffer._size << "}";
+        }
+        os << "]}";
+    }
+    os << "\n]}\n";
+}
+
+void MemoryReport::exportJson(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str());
+    if(!file)
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to write the memory report.")
+                                                << exception::filename(filename));
+    exportJson(file);
+}
+}
+}
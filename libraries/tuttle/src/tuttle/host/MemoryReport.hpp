@@ -0,0 +1,80 @@
+#ifndef _TUTTLE_HOST_MEMORYREPORT_HPP_
+#define _TUTTLE_HOST_MEMORYREPORT_HPP_
+
+#include <tuttle/host/memory/IMemoryPool.hpp>
+
+#include <ofxCore.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace tuttle
+{
+namespace host
+{
+
+/**
+ * @brief Memory used to render a frame.
+ */
+struct FrameMemoryUsage
+{
+    FrameMemoryUsage()
+        : _time(0)
+        , _predictedPeak(0)
+        , _poolPeakUsed(0)
+        , _poolPeakAllocated(0)
+        , _cachePeak(0)
+    {
+    }
+
+    OfxTime _time;
+    std::size_t _predictedPeak;     ///< images of the nodes, predicted from their RoI before the render
+    std::size_t _poolPeakUsed;      ///< high-water mark of the memory used in the MemoryPool
+    std::size_t _poolPeakAllocated; ///< high-water mark of the memory allocated by the MemoryPool, used or not
+    std::size_t _cachePeak;         ///< high-water mark of the images kept by the intern MemoryCache
+    std::vector<memory::BufferUsage> _peakBuffers; ///< buffers used at the peak of the MemoryPool, with their owners
+};
+
+/**
+ * @brief Memory used by each frame of a compute, to know which nodes held which buffers at the peak.
+ *
+ * The MemoryPool is shared by all the frames rendered in parallel: its peak for a frame is measured since the
+ * beginning of the last frame started, and may include the buffers of the other frames in flight.
+ */
+class MemoryReport : private boost::noncopyable
+{
+public:
+    MemoryReport() {}
+
+    void clear();
+
+    std::size_t getNbFrames() const;
+    /// Copy of the usage of the frame @p index, in the order of the end of the frames
+    FrameMemoryUsage getFrame(const std::size_t index) const;
+
+    /// @name Maximum of all the frames
+    /// @{
+    std::size_t getPeakUsedMemorySize() const;
+    std::size_t getPredictedPeakMemorySize() const;
+    /// @}
+
+    void exportJson(std::ostream& os) const;
+    void exportJson(const std::string& filename) const;
+
+#ifndef SWIG
+    void addFrame(const FrameMemoryUsage& frame);
+
+private:
+    std::vector<FrameMemoryUsage> _frames;
+    mutable boost::mutex _mutex;
+#endif
+};
+}
+}
+
+#endif
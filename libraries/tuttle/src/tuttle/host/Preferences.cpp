@@ -22,6 +22,12 @@ namespace host
 Preferences::Preferences()
     : _home(buildTuttleHome())
     , _temp(buildTuttleTemp())
+    , _nbThreads(0)
+    , _poolAllocator(memory::ePoolAllocatorAligned)
+    , _memoryCacheMaxSize(0)
+    , _memoryCachePolicy(memory::eMemoryCachePolicyLRU)
+    , _renderDiskCacheMaxSize(0)
+    , _renderDiskCacheMaxAge(0)
 {
 }
 
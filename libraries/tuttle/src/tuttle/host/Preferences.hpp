@@ -1,9 +1,13 @@
 #ifndef _TUTTLE_HOST_PREFERENCES_HPP_
 #define _TUTTLE_HOST_PREFERENCES_HPP_
 
+#include <tuttle/host/memory/PoolAllocator.hpp>
+#include <tuttle/host/memory/MemoryCachePolicy.hpp>
+
 #include <boost/filesystem/path.hpp>
 
 #include <string>
+#include <cstddef>
 
 namespace tuttle
 {
@@ -15,6 +19,13 @@ class Preferences
 private:
     boost::filesystem::path _home;
     boost::filesystem::path _temp;
+    std::size_t _nbThreads;
+    memory::EPoolAllocator _poolAllocator;
+    std::size_t _memoryCacheMaxSize;
+    memory::EMemoryCachePolicy _memoryCachePolicy;
+    boost::filesystem::path _renderDiskCachePath;
+    std::size_t _renderDiskCacheMaxSize;
+    std::size_t _renderDiskCacheMaxAge;
 
 public:
     Preferences();
@@ -27,6 +38,50 @@ public:
 
     boost::filesystem::path buildTuttleTestPath() const;
 
+    /**
+     * @brief Number of threads used to render (0 means the number of hardware threads).
+     * Set it before the first render, as the thread pool is created once, or call Core::resetThreadPool.
+     */
+    void setNbThreads(const std::size_t nbThreads) { _nbThreads = nbThreads; }
+    std::size_t getNbThreads() const { return _nbThreads; }
+
+    /**
+     * @brief Backing memory of the new buffers allocated by the memory pool.
+     */
+    void setPoolAllocator(const memory::EPoolAllocator allocator) { _poolAllocator = allocator; }
+    memory::EPoolAllocator getPoolAllocator() const { return _poolAllocator; }
+
+    /**
+     * @brief Memory budget of the node results kept by the intern memory cache between frames and renders.
+     * 0 disables it: all intermediate images are released after each frame.
+     */
+    void setMemoryCacheMaxSize(const std::size_t maxSize) { _memoryCacheMaxSize = maxSize; }
+    std::size_t getMemoryCacheMaxSize() const { return _memoryCacheMaxSize; }
+
+    void setMemoryCachePolicy(const memory::EMemoryCachePolicy policy) { _memoryCachePolicy = policy; }
+    memory::EMemoryCachePolicy getMemoryCachePolicy() const { return _memoryCachePolicy; }
+
+    /**
+     * @brief Directory of the node results kept on disk between processes.
+     * An empty path disables it (default).
+     */
+    void setRenderDiskCachePath(const boost::filesystem::path& path) { _renderDiskCachePath = path; }
+    boost::filesystem::path getRenderDiskCachePath() const { return _renderDiskCachePath; }
+    void setRenderDiskCachePathStr(const std::string& path) { setRenderDiskCachePath(path); }
+    std::string getRenderDiskCachePathStr() const { return getRenderDiskCachePath().string(); }
+
+    /**
+     * @brief Disk budget of the render disk cache in bytes, 0 means no limit.
+     */
+    void setRenderDiskCacheMaxSize(const std::size_t maxSize) { _renderDiskCacheMaxSize = maxSize; }
+    std::size_t getRenderDiskCacheMaxSize() const { return _renderDiskCacheMaxSize; }
+
+    /**
+     * @brief Time in seconds after which an unused result is removed from disk, 0 means no limit.
+     */
+    void setRenderDiskCacheMaxAge(const std::size_t maxAge) { _renderDiskCacheMaxAge = maxAge; }
+    std::size_t getRenderDiskCacheMaxAge() const { return _renderDiskCacheMaxAge; }
+
 private:
     boost::filesystem::path buildTuttleHome() const;
     boost::filesystem::path buildTuttleTemp() const;
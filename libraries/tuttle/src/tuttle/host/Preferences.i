@@ -4,6 +4,8 @@
 #include <tuttle/host/Preferences.hpp>
 %}
 
+%include <tuttle/host/memory/PoolAllocator.hpp>
+%include <tuttle/host/memory/MemoryCachePolicy.hpp>
 %include <tuttle/host/Preferences.hpp>
 
 %extend tuttle::host::Preferences
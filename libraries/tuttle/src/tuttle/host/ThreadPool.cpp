@@ -0,0 +1,213 @@
+#include "ThreadPool.hpp"
+
+#include <tuttle/host/exceptions.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/thread/tss.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <algorithm>
+
+namespace tuttle
+{
+namespace host
+{
+
+namespace
+{
+
+/// Task executed by the current thread
+struct TaskInfo
+{
+    TaskInfo()
+        : _inTask(false)
+        , _index(0)
+    {
+    }
+    bool _inTask;
+    unsigned int _index;
+};
+
+boost::thread_specific_ptr<TaskInfo> currentTask;
+
+TaskInfo& getCurrentTask()
+{
+    if(currentTask.get() == NULL)
+        currentTask.reset(new TaskInfo());
+    return *currentTask;
+}
+}
+
+struct ThreadPool::Job
+{
+    Job(TaskFunction func, const unsigned int count, void* customArg)
+        : _func(func)
+        , _customArg(customArg)
+        , _count(count)
+        , _nextIndex(0)
+        , _nbFinished(0)
+    {
+    }
+
+    TaskFunction _func;
+    void* _customArg;
+    const unsigned int _count;
+    unsigned int _nextIndex;     ///< next index to execute
+    unsigned int _nbFinished;    ///< number of indices already executed
+    boost::exception_ptr _error; ///< first exception thrown by a task, rethrown by run()
+};
+
+ThreadPool::ThreadPool(const std::size_t nbThreads)
+    : _stop(false)
+{
+    std::size_t nbWorkers = nbThreads ? nbThreads : boost::thread::hardware_concurrency();
+    // the calling thread also works, so we need one thread less
+    if(nbWorkers > 0)
+        --nbWorkers;
+
+    for(std::size_t i = 0; i < nbWorkers; ++i)
+    {
+        _workers.create_thread(boost::bind(&ThreadPool::workerLoop, this));
+    }
+    TUTTLE_LOG_DEBUG("[Thread pool] " << nbWorkers << " workers");
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        _stop = true;
+    }
+    _jobAvailable.notify_all();
+    _workers.join_all();
+}
+
+void ThreadPool::run(TaskFunction func, const unsigned int count, void* customArg)
+{
+    if(count == 0)
+        return;
+
+    Job job(func, count, customArg);
+    if(count == 1 || _workers.size() == 0)
+    {
+        for(unsigned int i = 0; i < count; ++i)
+            runTask(job, i);
+        if(job._error)
+            boost::rethrow_exception(job._error);
+        return;
+    }
+
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        _jobs.push_back(&job);
+    }
+    _jobAvailable.notify_all();
+
+    // The calling thread works on its own job, so nested calls can't wait for busy workers.
+    unsigned int index;
+    while(claimTask(job, index))
+    {
+        runTask(job, index);
+    }
+
+    boost::mutex::scoped_lock locker(_mutex);
+    while(job._nbFinished < job._count)
+        _jobFinished.wait(locker);
+    if(job._error)
+        boost::rethrow_exception(job._error);
+}
+
+bool ThreadPool::isInTask()
+{
+    return currentTask.get() != NULL && currentTask->_inTask;
+}
+
+bool ThreadPool::getTaskIndex(unsigned int& index)
+{
+    if(!isInTask())
+    {
+        index = 0;
+        return false;
+    }
+    index = currentTask->_index;
+    return true;
+}
+
+void ThreadPool::workerLoop()
+{
+    for(;;)
+    {
+        unsigned int index;
+        Job* job = waitJob(index);
+        if(job == NULL)
+            return;
+        runTask(*job, index);
+    }
+}
+
+ThreadPool::Job* ThreadPool::waitJob(unsigned int& index)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    while(!_stop && _jobs.empty())
+        _jobAvailable.wait(locker);
+    if(_stop)
+        return NULL;
+
+    Job* job = _jobs.front();
+    index = job->_nextIndex++;
+    if(job->_nextIndex == job->_count)
+        _jobs.pop_front();
+    return job;
+}
+
+bool ThreadPool::claimTask(Job& job, unsigned int& index)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    if(job._nextIndex == job._count)
+        return false;
+
+    index = job._nextIndex++;
+    if(job._nextIndex == job._count)
+        _jobs.erase(std::find(_jobs.begin(), _jobs.end(), &job));
+    return true;
+}
+
+void ThreadPool::runTask(Job& job, const unsigned int index)
+{
+    TaskInfo& task = getCurrentTask();
+    const TaskInfo parentTask = task; // in case of nested calls
+    task._inTask = true;
+    task._index = index;
+    boost::exception_ptr error;
+    try
+    {
+        job._func(index, job._count, job._customArg);
+    }
+    catch(...)
+    {
+        error = boost::current_exception();
+    }
+    task = parentTask;
+
+    bool finished;
+    bool firstError = false;
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        if(error && !job._error)
+        {
+            job._error = error;
+            firstError = true;
+        }
+        finished = (++job._nbFinished == job._count);
+    }
+    // only the first error is rethrown to the caller
+    if(error && !firstError)
+        TUTTLE_LOG_ERROR("[Thread pool] Error in task " << index << "." << std::endl
+                                                        << boost::diagnostic_information(error));
+    if(finished)
+        _jobFinished.notify_all();
+}
+}
+}
@@ -0,0 +1,78 @@
+#ifndef _TUTTLE_HOST_THREADPOOL_HPP_
+#define _TUTTLE_HOST_THREADPOOL_HPP_
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <cstddef>
+
+namespace tuttle
+{
+namespace host
+{
+
+/**
+ * @brief Persistent pool of threads, to execute a function N times in parallel without creating threads.
+ *
+ * Each call to run() pushes a job in a shared queue. Idle workers take the pending indices of
+ * any job, and the calling thread executes the indices of its own job while waiting.
+ * So a run() called from inside a task (nested parallelism), or from several threads at
+ * the same time (frames rendered in parallel), always makes progress.
+ */
+class ThreadPool : private boost::noncopyable
+{
+public:
+    typedef void (*TaskFunction)(unsigned int index, unsigned int count, void* customArg);
+
+    /**
+     * @param nbThreads total number of threads working on a job, including the calling thread.
+     *        0 means the number of hardware threads.
+     */
+    explicit ThreadPool(const std::size_t nbThreads = 0);
+    ~ThreadPool();
+
+    /**
+     * @brief Number of threads working on a job, including the calling thread.
+     */
+    std::size_t getNbThreads() const { return _workers.size() + 1; }
+
+    /**
+     * @brief Call @p func for each index in [0, count[ and wait for all of them.
+     * The first exception thrown by a task is rethrown once all the indices are executed.
+     */
+    void run(TaskFunction func, const unsigned int count, void* customArg);
+
+    /**
+     * @brief Is the current thread executing a task?
+     */
+    static bool isInTask();
+
+    /**
+     * @brief Index of the task executed by the current thread.
+     * @return false if the current thread is not executing a task.
+     */
+    static bool getTaskIndex(unsigned int& index);
+
+private:
+    struct Job;
+
+    void workerLoop();
+    Job* waitJob(unsigned int& index);
+    bool claimTask(Job& job, unsigned int& index);
+    void runTask(Job& job, const unsigned int index);
+
+private:
+    std::deque<Job*> _jobs; ///< jobs with indices not yet claimed
+    boost::mutex _mutex;
+    boost::condition_variable _jobAvailable;
+    boost::condition_variable _jobFinished;
+    bool _stop;
+    boost::thread_group _workers;
+};
+}
+}
+
+#endif
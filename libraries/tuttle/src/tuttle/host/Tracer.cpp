@@ -0,0 +1,242 @@
+#include "Tracer.hpp"
+
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace tuttle
+{
+namespace host
+{
+
+namespace
+{
+
+struct TraceContext
+{
+    TraceContext()
+        : _tracer(NULL)
+        , _frame(std::numeric_limits<OfxTime>::quiet_NaN())
+    {
+    }
+    Tracer* _tracer;
+    OfxTime _frame;
+};
+
+boost::thread_specific_ptr<TraceContext> currentContext;
+
+TraceContext& getCurrentContext()
+{
+    if(currentContext.get() == NULL)
+        currentContext.reset(new TraceContext());
+    return *currentContext;
+}
+
+void writeJsonString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    BOOST_FOREACH(const char c, s)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+        else
+            os << c;
+    }
+    os << '"';
+}
+}
+
+Tracer::Tracer()
+    : _origin(Clock::now())
+{
+}
+
+void Tracer::clear()
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _origin = Clock::now();
+    _events.clear();
+    _threadIds.clear();
+}
+
+std::size_t Tracer::getNbEvents() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _events.size();
+}
+
+void Tracer::addSpan(const char* category, const std::string& name, const std::string& node, const OfxTime frame,
+                     const Clock::time_point& begin, const Clock::time_point& end, const std::size_t bytes)
+{
+    Event event;
+    event._category = category;
+    event._name = name;
+    event._node = node;
+    event._frame = frame;
+    event._duration = boost::chrono::duration<double, boost::micro>(end - begin).count();
+    event._bytes = bytes;
+    addEvent(event, begin);
+}
+
+void Tracer::addInstant(const char* category, const std::string& name, const std::string& node, const OfxTime frame)
+{
+    Event event;
+    event._category = category;
+    event._name = name;
+    event._node = node;
+    event._frame = frame;
+    event._duration = -1.0;
+    event._bytes = 0;
+    addEvent(event, Clock::now());
+}
+
+void Tracer::addEvent(Event& event, const Clock::time_point& begin)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    event._timestamp = boost::chrono::duration<double, boost::micro>(begin - _origin).count();
+    event._threadId = getThreadId();
+    _events.push_back(event);
+}
+
+unsigned int Tracer::getThreadId()
+{
+    const boost::thread::id id = boost::this_thread::get_id();
+    std::map<boost::thread::id, unsigned int>::const_iterator it = _threadIds.find(id);
+    if(it != _threadIds.end())
+        return it->second;
+    const unsigned int threadId = static_cast<unsigned int>(_threadIds.size());
+    _threadIds[id] = threadId;
+    return threadId;
+}
+
+void Tracer::exportChromeTrace(std::ostream& os) const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for(unsigned int threadId = 0; threadId < _threadIds.size(); ++threadId)
+    {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+           << ",\"args\":{\"name\":\"tuttle thread " << threadId << "\"}}";
+    }
+    BOOST_FOREACH(const Event& event, _events)
+    {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "{\"name\":";
+        writeJsonString(os, event._name);
+        os << ",\"cat\":\"" << event._category << "\"";
+        if(event._duration < 0.0)
+            os << ",\"ph\":\"i\",\"s\":\"t\"";
+        else
+            os << ",\"ph\":\"X\",\"dur\":" << event._duration;
+        os << ",\"ts\":" << event._timestamp << ",\"pid\":1,\"tid\":" << event._threadId << ",\"args\":{";
+        bool firstArg = true;
+        if(!event._node.empty())
+        {
+            os << "\"node\":";
+            writeJsonString(os, event._node);
+            firstArg = false;
+        }
+        if(event._frame == event._frame) // not NaN
+        {
+            os << (firstArg ? "" : ",") << "\"frame\":" << event._frame;
+            firstArg = false;
+        }
+        if(event._bytes)
+            os << (firstArg ? "" : ",") << "\"bytes\":" << event._bytes;
+        os << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Tracer::exportChromeTrace(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str());
+    if(!file)
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to write the trace file.")
+                                                << exception::filename(filename));
+    exportChromeTrace(file);
+}
+
+Tracer* Tracer::getCurrent()
+{
+    return currentContext.get() == NULL ? NULL : currentContext->_tracer;
+}
+
+OfxTime Tracer::getCurrentFrame()
+{
+    return currentContext.get() == NULL ? std::numeric_limits<OfxTime>::quiet_NaN() : currentContext->_frame;
+}
+
+TraceScope::TraceScope(Tracer* tracer)
+{
+    TraceContext& context = getCurrentContext();
+    _previousTracer = context._tracer;
+    _previousFrame = context._frame;
+    context._tracer = tracer;
+}
+
+TraceScope::TraceScope(Tracer* tracer, const OfxTime frame)
+{
+    TraceContext& context = getCurrentContext();
+    _previousTracer = context._tracer;
+    _previousFrame = context._frame;
+    context._tracer = tracer;
+    context._frame = frame;
+}
+
+TraceScope::~TraceScope()
+{
+    TraceContext& context = getCurrentContext();
+    context._tracer = _previousTracer;
+    context._frame = _previousFrame;
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name)
+    : _tracer(Tracer::getCurrent())
+    , _category(category)
+    , _name(name)
+    , _bytes(0)
+{
+    if(_tracer)
+        _begin = Tracer::Clock::now();
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name, const std::string& node, const std::size_t bytes)
+    : _tracer(Tracer::getCurrent())
+    , _category(category)
+    , _name(name)
+    , _bytes(bytes)
+{
+    if(_tracer)
+    {
+        _node = node;
+        _begin = Tracer::Clock::now();
+    }
+}
+
+TraceSpan::~TraceSpan()
+{
+    if(_tracer)
+        _tracer->addSpan(_category, _name, _node, Tracer::getCurrentFrame(), _begin, Tracer::Clock::now(), _bytes);
+}
+
+void traceInstant(const char* category, const char* name, const std::string& node)
+{
+    if(Tracer* tracer = Tracer::getCurrent())
+        tracer->addInstant(category, name, node, Tracer::getCurrentFrame());
+}
+}
+}
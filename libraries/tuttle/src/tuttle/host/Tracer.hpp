@@ -0,0 +1,135 @@
+#ifndef _TUTTLE_HOST_TRACER_HPP_
+#define _TUTTLE_HOST_TRACER_HPP_
+
+#include <ofxCore.h>
+
+#include <boost/chrono/chrono.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle
+{
+namespace host
+{
+
+/**
+ * @brief Timed spans of a compute, exported in the Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ * The graph passes, the visitors, the render actions of the nodes, the allocations of the MemoryPool and the
+ * results found in cache are recorded with the thread and the frame they belong to.
+ * Only the threads attached to the tracer with a TraceScope record something, so a compute without tracer
+ * only pays a thread local lookup.
+ */
+class Tracer : private boost::noncopyable
+{
+public:
+    Tracer();
+
+    /**
+     * @brief Remove all the events, and restart the clock of the timestamps.
+     */
+    void clear();
+    std::size_t getNbEvents() const;
+
+    void exportChromeTrace(std::ostream& os) const;
+    void exportChromeTrace(const std::string& filename) const;
+
+#ifndef SWIG
+    typedef boost::chrono::steady_clock Clock;
+
+    /**
+     * @brief Add a span from @p begin to @p end.
+     * @param bytes size of the allocation, 0 if the span isn't an allocation
+     */
+    void addSpan(const char* category, const std::string& name, const std::string& node, const OfxTime frame,
+                 const Clock::time_point& begin, const Clock::time_point& end, const std::size_t bytes = 0);
+    /**
+     * @brief Add an event without duration, like a result found in cache.
+     */
+    void addInstant(const char* category, const std::string& name, const std::string& node, const OfxTime frame);
+
+    /**
+     * @brief Tracer attached to the current thread, NULL if none.
+     */
+    static Tracer* getCurrent();
+    /**
+     * @brief Frame rendered by the current thread, NaN outside of a frame.
+     */
+    static OfxTime getCurrentFrame();
+
+private:
+    struct Event
+    {
+        const char* _category;
+        std::string _name;
+        std::string _node;
+        OfxTime _frame;
+        double _timestamp; ///< microseconds since the creation of the tracer
+        double _duration;  ///< microseconds, negative for an instant event
+        unsigned int _threadId;
+        std::size_t _bytes;
+    };
+
+    void addEvent(Event& event, const Clock::time_point& begin);
+    unsigned int getThreadId();
+
+private:
+    Clock::time_point _origin;
+    std::vector<Event> _events;
+    std::map<boost::thread::id, unsigned int> _threadIds; ///< small identifiers, in the order of the first event
+    mutable boost::mutex _mutex;
+#endif
+};
+
+#ifndef SWIG
+/**
+ * @brief Attach a tracer to the current thread, and the frame it renders, until the end of the scope.
+ * A NULL tracer detaches the thread.
+ */
+class TraceScope : private boost::noncopyable
+{
+public:
+    explicit TraceScope(Tracer* tracer);
+    TraceScope(Tracer* tracer, const OfxTime frame);
+    ~TraceScope();
+
+private:
+    Tracer* _previousTracer;
+    OfxTime _previousFrame;
+};
+
+/**
+ * @brief Record a span from the construction to the destruction, if the current thread has a tracer.
+ */
+class TraceSpan : private boost::noncopyable
+{
+public:
+    TraceSpan(const char* category, const char* name);
+    TraceSpan(const char* category, const char* name, const std::string& node, const std::size_t bytes = 0);
+    ~TraceSpan();
+
+private:
+    Tracer* _tracer;
+    const char* _category;
+    const char* _name;
+    std::string _node;
+    std::size_t _bytes;
+    Tracer::Clock::time_point _begin;
+};
+
+/**
+ * @brief Record an instant event, if the current thread has a tracer.
+ */
+void traceInstant(const char* category, const char* name, const std::string& node);
+#endif
+}
+}
+
+#endif
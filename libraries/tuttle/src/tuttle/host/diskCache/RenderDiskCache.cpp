@@ -0,0 +1,295 @@
+#include "RenderDiskCache.hpp"
+
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/host/memory/IMemoryPool.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/common/system/system.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#if defined(__UNIX__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace tuttle
+{
+namespace host
+{
+
+namespace
+{
+
+const char kMagic[8] = {'T', 'U', 'T', 'T', 'L', 'E', 'R', 'C'};
+const boost::uint32_t kVersion = 1;
+
+/// Pixels start on a page boundary, so the mapped data is aligned like the pool buffers
+const std::size_t kHeaderSize = 4096;
+
+struct FileHeader
+{
+    char _magic[8];
+    boost::uint32_t _version;
+    boost::uint32_t _headerSize;
+    boost::uint64_t _key;
+    boost::int32_t _bounds[4];
+    boost::int32_t _components;
+    boost::int32_t _bitDepth;
+    boost::uint64_t _rowBytes;
+    boost::uint64_t _dataSize;
+};
+
+FileHeader buildHeader(const RenderDiskCache::KeyType key, const attribute::Image& image)
+{
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::memcpy(header._magic, kMagic, sizeof(kMagic));
+    header._version = kVersion;
+    header._headerSize = kHeaderSize;
+    header._key = key;
+    const OfxRectI bounds = image.getBounds();
+    header._bounds[0] = bounds.x1;
+    header._bounds[1] = bounds.y1;
+    header._bounds[2] = bounds.x2;
+    header._bounds[3] = bounds.y2;
+    header._components = image.getComponentsType();
+    header._bitDepth = image.getBitDepth();
+    header._rowBytes = image.getRowAbsDistanceBytes();
+    header._dataSize = image.getMemorySize();
+    return header;
+}
+
+#if defined(__UNIX__)
+/**
+ * @brief Image data of a file mapped in memory.
+ * Mapped as private, so a plugin writing in its inputs doesn't modify the cache.
+ */
+class MappedPoolData : public memory::IPoolData
+{
+public:
+    MappedPoolData(char* mapping, const std::size_t mappingSize, const std::size_t offset, const std::size_t size,
+                   const memory::BufferOwner& owner)
+        : _mapping(mapping)
+        , _mappingSize(mappingSize)
+        , _offset(offset)
+        , _size(size)
+        , _refCount(0)
+        , _owner(owner)
+    {
+    }
+
+    ~MappedPoolData() { ::munmap(_mapping, _mappingSize); }
+
+    void addRef() { ++_refCount; }
+    void release()
+    {
+        if(--_refCount == 0)
+            delete this;
+    }
+
+    char* data() { return _mapping + _offset; }
+    const char* data() const { return _mapping + _offset; }
+    const std::size_t size() const { return _size; }
+    const std::size_t reservedSize() const { return _size; }
+    void setSize(const std::size_t newSize) { assert(newSize <= _size); }
+    const memory::BufferOwner& getOwner() const { return _owner; }
+
+private:
+    char* const _mapping;
+    const std::size_t _mappingSize;
+    const std::size_t _offset;
+    const std::size_t _size;
+    int _refCount;
+    memory::BufferOwner _owner;
+};
+
+memory::IPoolDataPtr loadData(const boost::filesystem::path& filepath, const FileHeader& expected,
+                              const memory::BufferOwner& owner)
+{
+    const int fd = ::open(filepath.string().c_str(), O_RDONLY);
+    if(fd < 0)
+        return memory::IPoolDataPtr();
+
+    memory::IPoolDataPtr data;
+    FileHeader header;
+    struct stat fileStat;
+    if(::fstat(fd, &fileStat) == 0 && static_cast<std::size_t>(fileStat.st_size) == kHeaderSize + expected._dataSize &&
+       ::pread(fd, &header, sizeof(FileHeader), 0) == static_cast<ssize_t>(sizeof(FileHeader)) &&
+       std::memcmp(&header, &expected, sizeof(FileHeader)) == 0)
+    {
+        const std::size_t mappingSize = fileStat.st_size;
+        void* mapping = ::mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED)
+        {
+            data = new MappedPoolData(static_cast<char*>(mapping), mappingSize, kHeaderSize, expected._dataSize, owner);
+        }
+    }
+    ::close(fd);
+    return data;
+}
+#else
+memory::IPoolDataPtr loadData(const boost::filesystem::path& filepath, const FileHeader& expected,
+                              const memory::BufferOwner& owner)
+{
+    std::ifstream file(filepath.string().c_str(), std::ios::in | std::ios::binary);
+    FileHeader header;
+    if(!file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader)) ||
+       std::memcmp(&header, &expected, sizeof(FileHeader)) != 0)
+        return memory::IPoolDataPtr();
+
+    memory::IPoolDataPtr data = core().getMemoryPool().allocate(expected._dataSize, owner);
+    if(!file.seekg(kHeaderSize) || !file.read(data->data(), expected._dataSize))
+        return memory::IPoolDataPtr();
+    return data;
+}
+#endif
+
+/**
+ * @brief Temporary file written by store(), named from the cache file: "<key>.tuttlecache.XXXX-XXXX-XXXX.tmp"
+ */
+bool isTemporaryFile(const boost::filesystem::path& filepath)
+{
+    if(filepath.extension() != ".tmp")
+        return false;
+    // remove ".XXXX-XXXX-XXXX", to get the extension of the cache file
+    return filepath.stem().stem().extension() == RenderDiskCache::s_extension;
+}
+
+struct CachedFile
+{
+    std::time_t _lastWriteTime;
+    boost::uintmax_t _size;
+    boost::filesystem::path _path;
+
+    bool operator<(const CachedFile& other) const { return _lastWriteTime < other._lastWriteTime; }
+};
+}
+
+const std::string RenderDiskCache::s_extension(".tuttlecache");
+
+RenderDiskCache::RenderDiskCache()
+    : _maxDiskSize(0)
+    , _maxAge(0)
+{
+}
+
+void RenderDiskCache::store(const KeyType key, attribute::Image& image)
+{
+    try
+    {
+        const boost::filesystem::path filepath = _diskCacheTranslator.create(key).replace_extension(s_extension);
+        // Write in a temporary file and rename it, so other processes never read an incomplete file.
+        const boost::filesystem::path tmpFilepath =
+            boost::filesystem::unique_path(filepath.string() + ".%%%%-%%%%-%%%%.tmp");
+
+        const FileHeader header = buildHeader(key, image);
+        std::vector<char> headerData(kHeaderSize, 0);
+        std::memcpy(&headerData[0], &header, sizeof(FileHeader));
+        {
+            std::ofstream file(tmpFilepath.string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            file.write(&headerData[0], kHeaderSize);
+            file.write(image.getCharPixelData(), header._dataSize);
+            if(!file)
+            {
+                file.close();
+                boost::system::error_code error;
+                boost::filesystem::remove(tmpFilepath, error);
+                TUTTLE_LOG_WARNING("[Render disk cache] Unable to write " << tmpFilepath);
+                return;
+            }
+        }
+        boost::filesystem::rename(tmpFilepath, filepath);
+    }
+    catch(const boost::filesystem::filesystem_error& e)
+    {
+        TUTTLE_LOG_WARNING("[Render disk cache] " << e.what());
+    }
+}
+
+bool RenderDiskCache::load(const KeyType key, attribute::Image& image, const memory::BufferOwner& owner) const
+{
+    const boost::filesystem::path filepath = keyToPath(key);
+    memory::IPoolDataPtr data = loadData(filepath, buildHeader(key, image), owner);
+    if(!data)
+        return false;
+
+    image.setPoolData(data);
+
+    // the file is recently used
+    boost::system::error_code error;
+    boost::filesystem::last_write_time(filepath, std::time(NULL), error);
+    return true;
+}
+
+void RenderDiskCache::cleanUp() const
+{
+    if(!isEnabled() || (_maxAge == 0 && _maxDiskSize == 0))
+        return;
+
+    const std::time_t now = std::time(NULL);
+    std::vector<CachedFile> files;
+    boost::uintmax_t diskSize = 0;
+    std::size_t nbRemoved = 0;
+
+    boost::system::error_code error;
+    for(boost::filesystem::recursive_directory_iterator it(getRootDir(), error), itEnd; !error && it != itEnd;
+        it.increment(error))
+    {
+        // never touch the files which are not created by the cache, the root may be shared
+        const bool isTemporary = isTemporaryFile(it->path());
+        if(!boost::filesystem::is_regular_file(it->status()) ||
+           (it->path().extension() != s_extension && !isTemporary))
+            continue;
+
+        CachedFile file;
+        file._path = it->path();
+        file._lastWriteTime = boost::filesystem::last_write_time(file._path, error);
+        file._size = boost::filesystem::file_size(file._path, error);
+        if(error)
+        {
+            error.clear();
+            continue;
+        }
+        // also removes temporary files of interrupted processes
+        if(_maxAge != 0 && now - file._lastWriteTime > _maxAge)
+        {
+            nbRemoved += boost::filesystem::remove(file._path, error);
+            error.clear();
+            continue;
+        }
+        if(isTemporary)
+            continue;
+        diskSize += file._size;
+        files.push_back(file);
+    }
+
+    if(_maxDiskSize != 0 && diskSize > _maxDiskSize)
+    {
+        std::sort(files.begin(), files.end());
+        BOOST_FOREACH(const CachedFile& file, files)
+        {
+            if(diskSize <= _maxDiskSize)
+                break;
+            if(boost::filesystem::remove(file._path, error))
+            {
+                diskSize -= file._size;
+                ++nbRemoved;
+            }
+            error.clear();
+        }
+    }
+    TUTTLE_LOG_DEBUG("[Render disk cache] " << nbRemoved << " files removed, " << diskSize << " bytes used");
+}
+}
+}
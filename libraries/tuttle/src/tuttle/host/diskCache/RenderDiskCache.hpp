@@ -0,0 +1,103 @@
+#ifndef _TUTTLEOFX_HOST_RENDERDISKCACHE_HPP_
+#define _TUTTLEOFX_HOST_RENDERDISKCACHE_HPP_
+
+#include <tuttle/host/diskCache/DiskCacheTranslator.hpp>
+#include <tuttle/host/memory/IMemoryPool.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <string>
+#include <cstddef>
+#include <ctime>
+
+namespace tuttle
+{
+namespace host
+{
+namespace attribute
+{
+class Image;
+}
+
+/**
+ * @brief Node results saved on your HDD, to reuse them between processes.
+ *
+ * Each file contains the pixels of one image, addressed by the hash of the node that computed it
+ * (the node hash at time combined with the render RoI and scale).
+ * The hash includes the last write time and size of the files read by the nodes, so only the results of nodes
+ * whose files all exist are kept: a file re-rendered at the same path gives a new key.
+ * Files are mapped in memory when possible, so a result is loaded without copy.
+ *
+ * The last write time of a file is updated when it is used, so the oldest files are the least
+ * recently used ones. cleanUp() removes the files unused since the max age, then the least
+ * recently used ones until the cache fits in the max size.
+ */
+class RenderDiskCache
+{
+public:
+    static const std::string s_extension;
+    typedef DiskCacheTranslator::KeyType KeyType;
+
+public:
+    RenderDiskCache();
+
+    /**
+     * @brief Set the base directory for all cached files. An empty path disables the cache.
+     */
+    void setRootDir(const boost::filesystem::path& rootDir) { _diskCacheTranslator.setRootDir(rootDir); }
+    const boost::filesystem::path& getRootDir() const { return _diskCacheTranslator.getRootDir(); }
+
+    bool isEnabled() const { return !getRootDir().empty(); }
+
+    /**
+     * @brief Size of all cached files in bytes, 0 means no limit.
+     */
+    void setMaxDiskSize(const std::size_t maxSize) { _maxDiskSize = maxSize; }
+    std::size_t getMaxDiskSize() const { return _maxDiskSize; }
+
+    /**
+     * @brief Time in seconds after which an unused file is removed, 0 means no limit.
+     */
+    void setMaxAge(const std::time_t maxAge) { _maxAge = maxAge; }
+    std::time_t getMaxAge() const { return _maxAge; }
+
+    /**
+     * @brief Check if the @p key exists in the cache.
+     */
+    bool contains(const KeyType key) const { return _diskCacheTranslator.contains(keyToPath(key)); }
+
+    /**
+     * @brief Save the pixels of @p image for the @p key.
+     * Errors are only logged, as the render doesn't depend on the cache.
+     */
+    void store(const KeyType key, attribute::Image& image);
+
+    /**
+     * @brief Set the pixels of @p image from the file of the @p key.
+     * @param owner recorded by the MemoryPool for the buffer of the pixels
+     * @return false if the key doesn't exist or if the file doesn't match the layout of @p image.
+     */
+    bool load(const KeyType key, attribute::Image& image,
+              const memory::BufferOwner& owner = memory::BufferOwner()) const;
+
+    /**
+     * @brief Remove the files unused since the max age, then the oldest files above the max size.
+     * Only the cache files and their temporary files are removed, never the other files of the root directory.
+     */
+    void cleanUp() const;
+
+private:
+    boost::filesystem::path keyToPath(const KeyType key) const
+    {
+        return _diskCacheTranslator.keyToAbsolutePath(key).replace_extension(s_extension);
+    }
+
+private:
+    DiskCacheTranslator _diskCacheTranslator;
+    std::size_t _maxDiskSize;
+    std::time_t _maxAge;
+};
+}
+}
+
+#endif
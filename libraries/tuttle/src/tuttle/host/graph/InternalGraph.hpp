@@ -446,7 +446,7 @@ public:
     template <typename Vertex, typename Edge>
     friend std::ostream& operator<<(std::ostream& os, const This& g);
 
-private:
+    /// Needed after changing the keys of the vertices
     void rebuildVertexDescriptorMap();
 
 protected:
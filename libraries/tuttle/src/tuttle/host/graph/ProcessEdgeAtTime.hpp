@@ -32,6 +32,11 @@ public:
 
     inline OfxTime getOutTime() const { return _outTime; }
     inline OfxTime getInTime() const { return _inTime; }
+    inline void setTimes(const OfxTime inTime, const OfxTime outTime)
+    {
+        _inTime = inTime;
+        _outTime = outTime;
+    }
 
 private:
     OfxTime _inTime;
@@ -3,7 +3,21 @@
 #include <tuttle/common/utils/color.hpp>
 #include <tuttle/host/graph/GraphExporter.hpp>
 
+#include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/MemoryReport.hpp>
+#include <tuttle/host/Tracer.hpp>
+
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <set>
 
 #if(TUTTLE_EXPORT_WITH_TIMER)
 #include <boost/timer/timer.hpp>
@@ -18,9 +32,133 @@ namespace graph
 
 const std::string ProcessGraph::_outputId("TUTTLE_FAKE_OUTPUT");
 
+/**
+ * @brief List of frames to render, shared by all the threads rendering frames in parallel.
+ */
+class ProcessGraph::FrameQueue
+{
+public:
+    FrameQueue(const ComputeOptions& options)
+        : _options(options)
+        , _next(0)
+    {
+    }
+
+    void push(const OfxTime time) { _times.push_back(time); }
+    std::size_t size() const { return _times.size(); }
+
+    /**
+     * @brief Get the next frame to render.
+     * @return false if there is no more frame, if the process was aborted or if a frame has failed.
+     */
+    bool pop(OfxTime& time)
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        if(_next >= _times.size() || _error || _options.getAbort())
+            return false;
+        time = _times[_next++];
+        return true;
+    }
+
+    /**
+     * @brief Keep the first error to rethrow it from the main thread, and stop the other threads.
+     */
+    void setError(const boost::exception_ptr& error)
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        if(!_error)
+            _error = error;
+    }
+    boost::exception_ptr getError() const
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        return _error;
+    }
+
+private:
+    const ComputeOptions& _options;
+    std::vector<OfxTime> _times;
+    std::size_t _next;
+    boost::exception_ptr _error;
+    mutable boost::mutex _mutex;
+};
+
+namespace
+{
+
+/// Node results kept by an intern cache between frames
+void configureInternMemoryCache(memory::IMemoryCache& cache)
+{
+    const Preferences& preferences = core().getPreferences();
+    cache.setPolicy(preferences.getMemoryCachePolicy());
+    cache.setMaxMemorySize(preferences.getMemoryCacheMaxSize());
+}
+}
+
+/**
+ * @brief Threads and graphs rendering frames in parallel with the main graph.
+ * On destruction, the threads are joined and the sequence is ended on the started workers,
+ * even if starting the following workers has failed.
+ */
+class ProcessGraph::ParallelWorkers
+{
+public:
+    ParallelWorkers()
+        : _nbStarted(0)
+    {
+    }
+
+    ~ParallelWorkers()
+    {
+        _threads.join_all();
+        for(std::size_t i = 0; i < _nbStarted; ++i)
+        {
+            try
+            {
+                _workers[i].endSequenceNodes();
+            }
+            catch(...)
+            {
+                TUTTLE_LOG_ERROR("[Process render] Error at the end of the sequence of a parallel frames graph."
+                                 << std::endl
+                                 << tuttle::exception::format_current_exception());
+            }
+        }
+    }
+
+    /// Copy @p graph, with its own cache, and begin the sequence of the nodes of the copy
+    void start(const ProcessGraph& graph)
+    {
+        _caches.push_back(new memory::MemoryCache());
+        configureInternMemoryCache(_caches.back());
+        _workers.push_back(new ProcessGraph(graph, _caches.back()));
+        _workers.back().setup();
+        _workers.back().beginSequenceNodes();
+        ++_nbStarted;
+    }
+
+    void launch(memory::IMemoryCache& outCache, FrameQueue& frames)
+    {
+        BOOST_FOREACH(ProcessGraph& worker, _workers)
+        {
+            _threads.create_thread(boost::bind(&ProcessGraph::processFramesInThread, &worker, boost::ref(outCache),
+                                               boost::ref(frames)));
+        }
+    }
+
+    void join() { _threads.join_all(); }
+
+private:
+    boost::ptr_vector<memory::MemoryCache> _caches;
+    boost::ptr_vector<ProcessGraph> _workers;
+    std::size_t _nbStarted; ///< workers whose sequence has begun
+    boost::thread_group _threads;
+};
+
 ProcessGraph::ProcessGraph(const ComputeOptions& options, Graph& userGraph, const std::list<std::string>& outputNodes,
                            memory::IMemoryCache& internMemoryCache)
-    : _instanceCount(userGraph.getInstanceCount())
+    : _renderGraphAtTimeReusable(false)
+    , _instanceCount(userGraph.getInstanceCount())
     , _options(options)
     , _internMemoryCache(internMemoryCache)
     , _procOptions(&_internMemoryCache)
@@ -32,6 +170,20 @@ ProcessGraph::ProcessGraph(const ComputeOptions& options, Graph& userGraph, cons
     updateGraph(userGraph, outputNodes);
 }
 
+ProcessGraph::ProcessGraph(const ProcessGraph& other, memory::IMemoryCache& internMemoryCache)
+    : _renderGraph(other._renderGraph)
+    , _renderGraphAtTimeReusable(false)
+    , _nodes(other._nodes)
+    , _instanceCount(other._instanceCount)
+    , _options(other._options)
+    , _internMemoryCache(internMemoryCache)
+    , _renderDiskCache(other._renderDiskCache)
+    , _procOptions(other._procOptions)
+{
+    _procOptions._internMemoryCache = &_internMemoryCache;
+    cloneNodes();
+}
+
 ProcessGraph::~ProcessGraph()
 {
 }
@@ -89,6 +241,31 @@ void ProcessGraph::relink()
     }
 }
 
+/**
+ * @brief Use our own copy of the nodes instead of the nodes of the original graph.
+ */
+void ProcessGraph::cloneNodes()
+{
+#ifdef PROCESSGRAPH_USE_LINK
+    for(NodeMap::iterator it = _nodes.begin(), itEnd = _nodes.end(); it != itEnd; ++it)
+    {
+        INode* newNode = it->second->clone();
+        newNode->setBeforeRenderCallback(it->second->_beforeRenderCallback);
+        _nodeClones.push_back(newNode);
+        it->second = dynamic_cast<Node*>(newNode);
+    }
+#endif
+
+    BOOST_FOREACH(InternalGraphImpl::vertex_descriptor vd, _renderGraph.getVertices())
+    {
+        Vertex& v = _renderGraph.instance(vd);
+        if(!v.isFake())
+        {
+            v.setProcessNode(_nodes.find(v.getProcessNode().getName())->second);
+        }
+    }
+}
+
 /*
    void removeVertexAndReconnectTo( const VertexDescriptor& v, const VertexDescriptor& other )
    {
@@ -188,6 +365,18 @@ void ProcessGraph::beginSequence(const TimeRange& timeRange)
     _procOptions._renderTimeRange.max = timeRange._end;
     _procOptions._step = timeRange._step;
 
+    configureInternMemoryCache(_internMemoryCache);
+    // node results kept on disk between processes
+    const Preferences& preferences = core().getPreferences();
+    _renderDiskCache.setRootDir(preferences.getRenderDiskCachePath());
+    _renderDiskCache.setMaxDiskSize(preferences.getRenderDiskCacheMaxSize());
+    _renderDiskCache.setMaxAge(preferences.getRenderDiskCacheMaxAge());
+
+    beginSequenceNodes();
+}
+
+void ProcessGraph::beginSequenceNodes()
+{
     TUTTLE_LOG_INFO("[begin sequence] start");
     //	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
     for(NodeMap::iterator it = _nodes.begin(), itEnd = _nodes.end(); it != itEnd; ++it)
@@ -200,6 +389,14 @@ void ProcessGraph::beginSequence(const TimeRange& timeRange)
 void ProcessGraph::endSequence()
 {
     _options.endSequenceHandle();
+    endSequenceNodes();
+
+    if(_renderDiskCache.isEnabled())
+        _renderDiskCache.cleanUp();
+}
+
+void ProcessGraph::endSequenceNodes()
+{
     TUTTLE_LOG_INFO("[Process render] process end sequence");
     //--- END sequence render
     BOOST_FOREACH(NodeMap::value_type& p, _nodes)
@@ -210,6 +407,7 @@ void ProcessGraph::endSequence()
 
 void ProcessGraph::updateGraph(Graph& userGraph, const std::list<std::string>& outputNodes)
 {
+    _renderGraphAtTimeReusable = false;
     _renderGraph.copyTransposed(userGraph.getGraph());
 
     Vertex outputVertex(_procOptions, _outputId);
@@ -243,6 +441,8 @@ void ProcessGraph::setup()
     using namespace boost;
     using namespace boost::graph;
     TUTTLE_LOG_INFO("[Process render] setup");
+    const TraceSpan traceSetup("graph", "setup");
+    _renderGraphAtTimeReusable = false;
 
     // Initialize variables
     //	OfxRectD renderWindow = { 0, 0, 0, 0 };
@@ -281,18 +481,28 @@ void ProcessGraph::setup()
 
     {
         TUTTLE_LOG_INFO("[Process render] Time domain propagation");
+        const TraceSpan trace("visitor", "TimeDomain");
         graph::visitor::TimeDomain<InternalGraphImpl> timeDomainPropagationVisitor(_renderGraph);
         _renderGraph.depthFirstVisit(timeDomainPropagationVisitor, _renderGraph.getVertexDescriptor(_outputId));
     }
 
     {
         TUTTLE_LOG_INFO("[Process render] setup visitors");
-        graph::visitor::Setup1<InternalGraphImpl> setup1Visitor(_renderGraph);
-        _renderGraph.depthFirstVisit(setup1Visitor, _renderGraph.getVertexDescriptor(_outputId));
-        graph::visitor::Setup2<InternalGraphImpl> setup2Visitor(_renderGraph);
-        _renderGraph.depthFirstVisit(setup2Visitor, _renderGraph.getVertexDescriptor(_outputId));
-        graph::visitor::Setup3<InternalGraphImpl> setup3Visitor(_renderGraph);
-        _renderGraph.depthFirstVisit(setup3Visitor, _renderGraph.getVertexDescriptor(_outputId));
+        {
+            const TraceSpan trace("visitor", "Setup1");
+            graph::visitor::Setup1<InternalGraphImpl> setup1Visitor(_renderGraph);
+            _renderGraph.depthFirstVisit(setup1Visitor, _renderGraph.getVertexDescriptor(_outputId));
+        }
+        {
+            const TraceSpan trace("visitor", "Setup2");
+            graph::visitor::Setup2<InternalGraphImpl> setup2Visitor(_renderGraph);
+            _renderGraph.depthFirstVisit(setup2Visitor, _renderGraph.getVertexDescriptor(_outputId));
+        }
+        {
+            const TraceSpan trace("visitor", "Setup3");
+            graph::visitor::Setup3<InternalGraphImpl> setup3Visitor(_renderGraph);
+            _renderGraph.depthFirstVisit(setup3Visitor, _renderGraph.getVertexDescriptor(_outputId));
+        }
     }
 }
 
@@ -335,61 +545,97 @@ std::list<TimeRange> ProcessGraph::computeTimeRange()
     return timeRanges;
 }
 
-void ProcessGraph::setupAtTime(const OfxTime time)
+bool ProcessGraph::GraphAtTimeLayout::hasSameStructure(const GraphAtTimeLayout& other) const
 {
-    _options.setupAtTimeHandle();
-#if(TUTTLE_EXPORT_WITH_TIMER)
-    boost::timer::cpu_timer timer;
-#endif
+    if(_nbVertexTimes != other._nbVertexTimes || _nbEdgeTimes != other._nbEdgeTimes)
+        return false;
+    for(std::size_t i = 0; i < _vertexTimes.size(); ++i)
+    {
+        if(_vertexTimes[i] - _time != other._vertexTimes[i] - other._time)
+            return false;
+    }
+    for(std::size_t i = 0; i < _edgeTimes.size(); ++i)
+    {
+        if(_edgeTimes[i].first - _time != other._edgeTimes[i].first - other._time ||
+           _edgeTimes[i].second - _time != other._edgeTimes[i].second - other._time)
+            return false;
+    }
+    return true;
+}
 
-    TUTTLE_LOG_TRACE("[Setup at time " << time << "] start");
-    graph::visitor::DeployTime<InternalGraphImpl> deployTimeVisitor(_renderGraph, time);
-    _renderGraph.depthFirstVisit(deployTimeVisitor, _renderGraph.getVertexDescriptor(_outputId));
-#if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-    graph::exportDebugAsDOT("graphProcess_c.dot", _renderGraph);
-#endif
+/**
+ * @brief Times deployed on the render graph for the frame @p time.
+ */
+void ProcessGraph::getGraphAtTimeLayout(GraphAtTimeLayout& layout, const OfxTime time)
+{
+    layout._time = time;
+    BOOST_FOREACH(const InternalGraphImpl::vertex_descriptor vd, _renderGraph.getVertices())
+    {
+        const Vertex& v = _renderGraph.instance(vd);
+        layout._nbVertexTimes.push_back(v._data._times.size());
+        layout._vertexTimes.insert(layout._vertexTimes.end(), v._data._times.begin(), v._data._times.end());
+    }
+    BOOST_FOREACH(const InternalGraphImpl::edge_descriptor ed, _renderGraph.getEdges())
+    {
+        const Edge& e = _renderGraph.instance(ed);
+        const std::size_t nbEdgeTimes = layout._edgeTimes.size();
+        BOOST_FOREACH(const Edge::TimeMap::value_type& tm, e._timesNeeded)
+        {
+            BOOST_FOREACH(const OfxTime t2, tm.second)
+            {
+                layout._edgeTimes.push_back(std::make_pair(tm.first, t2));
+            }
+        }
+        layout._nbEdgeTimes.push_back(layout._edgeTimes.size() - nbEdgeTimes);
+    }
+}
 
-    TUTTLE_LOG_TRACE("[Setup at time " << time << "] build render graph");
+/**
+ * @brief Create the graph at time from the render graph, with a vertex for each time needed of each node.
+ */
+void ProcessGraph::buildGraphAtTime(const GraphAtTimeLayout& layout)
+{
+    const OfxTime time = layout._time;
     // create a new graph with time information
     _renderGraphAtTime.clear();
+    _renderGraphAtTimeVertices.clear();
+    _renderGraphAtTimeEdges.clear();
 
+    BOOST_FOREACH(InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraph.getVertices())
     {
-        BOOST_FOREACH(InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraph.getVertices())
+        Vertex& v = _renderGraph.instance(vd);
+        BOOST_FOREACH(const OfxTime t, v._data._times)
         {
-            Vertex& v = _renderGraph.instance(vd);
-            BOOST_FOREACH(const OfxTime t, v._data._times)
-            {
-                TUTTLE_LOG_INFO("[Setup at time " << time << "] add connection from node: " << v << " for time: " << t);
-                _renderGraphAtTime.addVertex(ProcessVertexAtTime(v, t));
-            }
+            TUTTLE_LOG_INFO("[Setup at time " << time << "] add connection from node: " << v << " for time: " << t);
+            _renderGraphAtTimeVertices.push_back(_renderGraphAtTime.addVertex(ProcessVertexAtTime(v, t)));
         }
-        BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraph.getEdges())
+    }
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraph.getEdges())
+    {
+        const Edge& e = _renderGraph.instance(ed);
+        const Vertex& in = _renderGraph.sourceInstance(ed);
+        const Vertex& out = _renderGraph.targetInstance(ed);
+        TUTTLE_LOG_INFO("[Setup at time " << time << "] set connection " << e);
+        BOOST_FOREACH(const Edge::TimeMap::value_type& tm, e._timesNeeded)
         {
-            const Edge& e = _renderGraph.instance(ed);
-            const Vertex& in = _renderGraph.sourceInstance(ed);
-            const Vertex& out = _renderGraph.targetInstance(ed);
-            TUTTLE_LOG_INFO("[Setup at time " << time << "] set connection " << e);
-            BOOST_FOREACH(const Edge::TimeMap::value_type& tm, e._timesNeeded)
+            const VertexAtTime procIn(in, tm.first);
+            BOOST_FOREACH(const OfxTime t2, tm.second)
             {
-                const VertexAtTime procIn(in, tm.first);
-                BOOST_FOREACH(const OfxTime t2, tm.second)
-                {
-                    // TUTTLE_LOG_VAR( TUTTLE_TRACE, tm.first );
-                    // TUTTLE_LOG_VAR( TUTTLE_TRACE, t2 );
-                    const VertexAtTime procOut(out, t2);
+                // TUTTLE_LOG_VAR( TUTTLE_TRACE, tm.first );
+                // TUTTLE_LOG_VAR( TUTTLE_TRACE, t2 );
+                const VertexAtTime procOut(out, t2);
 
-                    const VertexAtTime::Key inKey(procIn.getKey());
-                    const VertexAtTime::Key outKey(procOut.getKey());
+                const VertexAtTime::Key inKey(procIn.getKey());
+                const VertexAtTime::Key outKey(procOut.getKey());
 
-                    // TUTTLE_LOG_VAR( TUTTLE_TRACE, inKey );
-                    // TUTTLE_LOG_VAR( TUTTLE_TRACE, outKey );
-                    // TUTTLE_LOG_VAR( TUTTLE_TRACE, e.getInAttrName() );
+                // TUTTLE_LOG_VAR( TUTTLE_TRACE, inKey );
+                // TUTTLE_LOG_VAR( TUTTLE_TRACE, outKey );
+                // TUTTLE_LOG_VAR( TUTTLE_TRACE, e.getInAttrName() );
 
-                    const EdgeAtTime eAtTime(outKey, inKey, e.getInAttrName());
+                const EdgeAtTime eAtTime(outKey, inKey, e.getInAttrName());
 
-                    _renderGraphAtTime.addEdge(_renderGraphAtTime.getVertexDescriptor(inKey),
-                                               _renderGraphAtTime.getVertexDescriptor(outKey), eAtTime);
-                }
+                _renderGraphAtTimeEdges.push_back(_renderGraphAtTime.addEdge(
+                    _renderGraphAtTime.getVertexDescriptor(inKey), _renderGraphAtTime.getVertexDescriptor(outKey), eAtTime));
             }
         }
     }
@@ -418,14 +664,111 @@ void ProcessGraph::setupAtTime(const OfxTime time)
     }
 
     bakeGraphInformationToNodes(_renderGraphAtTime);
+}
+
+/**
+ * @brief Move the graph at time of the previous frame to the times of @p layout, which has the same structure.
+ * The vertices, edges, degrees and clip connections are kept, only the times and the keys change.
+ */
+void ProcessGraph::updateGraphAtTime(const GraphAtTimeLayout& layout)
+{
+    for(std::size_t i = 0; i < _renderGraphAtTimeVertices.size(); ++i)
+    {
+        _renderGraphAtTime.instance(_renderGraphAtTimeVertices[i]).setTime(layout._vertexTimes[i]);
+    }
+    for(std::size_t i = 0; i < _renderGraphAtTimeEdges.size(); ++i)
+    {
+        _renderGraphAtTime.instance(_renderGraphAtTimeEdges[i])
+            .setTimes(layout._edgeTimes[i].first, layout._edgeTimes[i].second);
+    }
+    _renderGraphAtTime.rebuildVertexDescriptorMap();
+
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+        // the input edges are indexed by their time
+        ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName inEdges;
+        BOOST_FOREACH(const ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdge, vData._inEdges)
+        {
+            inEdges[ProcessVertexAtTimeData::Key(inEdge.first.first, inEdge.second->getInTime())] = inEdge.second;
+        }
+        vData._inEdges.swap(inEdges);
+
+        if(!v.isFake())
+            v.getProcessNode().setProcessDataAtTime(&vData);
+    }
+}
+
+void ProcessGraph::preProcessAtTime(const OfxTime time, const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime)
+{
+    {
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 1");
+        const TraceSpan trace("visitor", "PreProcess1");
+        graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor(_renderGraphAtTime);
+        _renderGraphAtTime.depthFirstVisit(preProcess1Visitor, outputAtTime);
+    }
+
+    {
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 2");
+        const TraceSpan trace("visitor", "PreProcess2");
+        graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor(_renderGraphAtTime);
+        _renderGraphAtTime.depthFirstVisit(preProcess2Visitor, outputAtTime);
+    }
+}
+
+void ProcessGraph::setupAtTime(const OfxTime time)
+{
+    _options.setupAtTimeHandle();
+#if(TUTTLE_EXPORT_WITH_TIMER)
+    boost::timer::cpu_timer timer;
+#endif
+    const TraceSpan traceSetupAtTime("graph", "setupAtTime");
+
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] start");
+    {
+        const TraceSpan trace("visitor", "DeployTime");
+        graph::visitor::DeployTime<InternalGraphImpl> deployTimeVisitor(_renderGraph, time);
+        _renderGraph.depthFirstVisit(deployTimeVisitor, _renderGraph.getVertexDescriptor(_outputId));
+    }
+#if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
+    graph::exportDebugAsDOT("graphProcess_c.dot", _renderGraph);
+#endif
+
+    GraphAtTimeLayout layout;
+    getGraphAtTimeLayout(layout, time);
+    const bool reuseGraphAtTime = _options.getIncrementalSetup() && _renderGraphAtTimeReusable &&
+                                  layout.hasSameStructure(_renderGraphAtTimeLayout);
+    _renderGraphAtTimeReusable = false; // until the graph at time is complete
+    if(reuseGraphAtTime)
+    {
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] update render graph");
+        const TraceSpan trace("graph", "updateGraphAtTime");
+        updateGraphAtTime(layout);
+    }
+    else
+    {
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] build render graph");
+        const TraceSpan trace("graph", "buildGraphAtTime");
+        buildGraphAtTime(layout);
+    }
+    _renderGraphAtTimeLayout = layout;
+    _renderGraphAtTimeReusable = true;
+
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
     graph::exportDebugAsDOT("graphProcessAtTime_a.dot", _renderGraphAtTime);
 #endif
 
+    // The RoD and RoI of the vertices are those of the previous frame when the graph at time is reused,
+    // the identity of the nodes is checked with the RoI of this frame.
+    preProcessAtTime(time, outputAtTime);
+
     if(!_options.getForceIdentityNodesProcess())
     {
         TUTTLE_LOG_TRACE("[Setup at time " << time << "] remove identity nodes");
+        const TraceSpan trace("visitor", "RemoveIdentityNodes");
         // The "Remove identity nodes" step need to be done after preprocess steps, because the RoI need to be computed.
         std::vector<graph::visitor::IdentityNodeConnection<InternalGraphAtTimeImpl> > toRemove;
 
@@ -435,9 +778,12 @@ void ProcessGraph::setupAtTime(const OfxTime time)
         if(toRemove.size())
         {
             graph::visitor::removeIdentityNodes(_renderGraphAtTime, toRemove);
+            _renderGraphAtTimeReusable = false;
 
             // Bake graph information again as the connections have changed.
             bakeGraphInformationToNodes(_renderGraphAtTime);
+            // The RoI requested to the inputs of the removed nodes have changed.
+            preProcessAtTime(time, outputAtTime);
         }
     }
 
@@ -445,18 +791,6 @@ void ProcessGraph::setupAtTime(const OfxTime time)
     graph::exportDebugAsDOT("graphProcessAtTime_b.dot", _renderGraphAtTime);
 #endif
 
-    {
-        TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 1");
-        graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor(_renderGraphAtTime);
-        _renderGraphAtTime.depthFirstVisit(preProcess1Visitor, outputAtTime);
-    }
-
-    {
-        TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 2");
-        graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor(_renderGraphAtTime);
-        _renderGraphAtTime.depthFirstVisit(preProcess2Visitor, outputAtTime);
-    }
-
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
     graph::exportDebugAsDOT("graphProcessAtTime_c.dot", _renderGraphAtTime);
 #endif
@@ -533,19 +867,256 @@ void ProcessGraph::computeHashAtTime(NodeHashContainer& outNodesHash, const OfxT
     TUTTLE_LOG_INFO("[Compute hash at time] end");
 }
 
+/**
+ * @brief Nodes without side effect and with inputs: writers and final nodes are always processed,
+ * and there is no way to know if the source of a reader or a generator has changed.
+ */
+bool ProcessGraph::isResultCacheable(const VertexAtTime& vertex) const
+{
+    const ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+    if(vData._isFinalNode || vData._inEdges.empty())
+        return false;
+    const INode& node = vertex.getProcessNode();
+    if(node.getNodeType() != INode::eNodeTypeImageEffect)
+        return false;
+    return node.asImageEffectNode().getContext() != kOfxImageEffectContextWriter;
+}
+
+/**
+ * @brief The files read by the node and by all its inputs are identified in the hash at time,
+ * so the result of the node can be kept between processes.
+ */
+bool ProcessGraph::hasFileIdentity(const InternalGraphAtTimeImpl::vertex_descriptor vd,
+                                   std::map<InternalGraphAtTimeImpl::vertex_descriptor, bool>& identities) const
+{
+    const std::map<InternalGraphAtTimeImpl::vertex_descriptor, bool>::const_iterator it = identities.find(vd);
+    if(it != identities.end())
+        return it->second;
+
+    const VertexAtTime& v = _renderGraphAtTime.instance(vd);
+    bool identity = v.isFake() || v.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect ||
+                    v.getProcessNode().asImageEffectNode().hasFileIdentityAtTime(v.getProcessDataAtTime()._time);
+    // the graph at time is transposed, the out edges go to the inputs
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getOutEdges(vd))
+    {
+        if(!identity)
+            break;
+        identity = hasFileIdentity(_renderGraphAtTime.target(ed), identities);
+    }
+    identities[vd] = identity;
+    return identity;
+}
+
+/**
+ * @brief Search the node results in the intern memory cache, and disconnect the nodes only needed to compute them.
+ * @param[out] diskCacheKeys nodes whose results can be loaded from and saved in the render disk cache
+ */
+void ProcessGraph::useCachedResults(const OfxTime time, std::map<VertexAtTime::Key, std::size_t>& resultHashes,
+                                    std::map<VertexAtTime::Key, memory::CACHE_ELEMENT>& cachedResults,
+                                    std::set<VertexAtTime::Key>& diskCacheKeys)
+{
+    const TraceSpan traceCache("cache", "useCachedResults");
+    const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
+
+    NodeHashContainer nodesHash;
+    graph::visitor::ComputeHashAtTime<InternalGraphAtTimeImpl> computeHashAtTimeVisitor(_renderGraphAtTime, nodesHash,
+                                                                                        time);
+    _renderGraphAtTime.depthFirstVisit(computeHashAtTimeVisitor, outputAtTime);
+
+    // Without the identity of the files, a file modified at the same path gives the same hash in the next process.
+    std::map<InternalGraphAtTimeImpl::vertex_descriptor, bool> fileIdentities;
+
+    // From the output, stop at the first nodes in cache.
+    bool disconnected = false;
+    std::set<InternalGraphAtTimeImpl::vertex_descriptor> visited;
+    std::vector<InternalGraphAtTimeImpl::vertex_descriptor> toVisit(1, outputAtTime);
+    while(!toVisit.empty())
+    {
+        const InternalGraphAtTimeImpl::vertex_descriptor vd = toVisit.back();
+        toVisit.pop_back();
+        if(!visited.insert(vd).second)
+            continue;
+
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(!v.isFake() && isResultCacheable(v))
+        {
+            // the same node with the same inputs gives a different image with another RoI or scale
+            const ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+            std::size_t hash = nodesHash.getHash(v.getKey());
+            boost::hash_combine(hash, vData._time);
+            boost::hash_combine(hash, vData._apiImageEffect._renderRoI.x1);
+            boost::hash_combine(hash, vData._apiImageEffect._renderRoI.y1);
+            boost::hash_combine(hash, vData._apiImageEffect._renderRoI.x2);
+            boost::hash_combine(hash, vData._apiImageEffect._renderRoI.y2);
+            boost::hash_combine(hash, vData._nodeData->_renderScale.x);
+            boost::hash_combine(hash, vData._nodeData->_renderScale.y);
+            resultHashes[v.getKey()] = hash;
+
+            if(_renderDiskCache.isEnabled() && hasFileIdentity(vd, fileIdentities))
+                diskCacheKeys.insert(v.getKey());
+
+            memory::CACHE_ELEMENT img = _internMemoryCache.getResult(hash);
+            if(img.get() == NULL && diskCacheKeys.count(v.getKey()))
+            {
+                attribute::ClipImage& clip =
+                    v.getProcessNode().asImageEffectNode().getClip(kOfxImageEffectOutputClipName);
+                memory::CACHE_ELEMENT diskImg(new attribute::Image(clip, vData._time, vData._apiImageEffect._renderRoI,
+                                                                   attribute::Image::eImageOrientationFromBottomToTop, 0));
+                if(_renderDiskCache.load(hash, *diskImg,
+                                         memory::BufferOwner(v.getName(), kOfxImageEffectOutputClipName, vData._time)))
+                {
+                    img = diskImg;
+                    traceInstant("cache", "diskCacheHit", v.getName());
+                }
+            }
+            else if(img.get() != NULL)
+                traceInstant("cache", "memoryCacheHit", v.getName());
+            if(img.get() != NULL)
+            {
+                cachedResults[v.getKey()] = img;
+                if(_renderGraphAtTime.getOutDegree(vd) > 0)
+                {
+                    _renderGraphAtTime.clearVertexOutputs(vd);
+                    disconnected = true;
+                }
+                continue;
+            }
+        }
+        BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getOutEdges(vd))
+        {
+            toVisit.push_back(_renderGraphAtTime.target(ed));
+        }
+    }
+
+    if(cachedResults.empty())
+        return;
+
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] " << cachedResults.size() << " nodes in cache");
+    // Warning: We don't remove the vertices to not invalidate vertex_descriptors but only remove edges.
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        if(visited.find(vd) == visited.end() &&
+           (_renderGraphAtTime.getInDegree(vd) > 0 || _renderGraphAtTime.getOutDegree(vd) > 0))
+        {
+            _renderGraphAtTime.clearVertex(vd);
+            disconnected = true;
+        }
+    }
+    if(!disconnected)
+        return;
+
+    // The graph at time can't be updated in place by the next setup.
+    _renderGraphAtTimeReusable = false;
+    // Bake graph information again as the connections have changed.
+    bakeGraphInformationToNodes(_renderGraphAtTime);
+}
+
+bool ProcessGraph::isPointwise(const VertexAtTime& vertex) const
+{
+    if(vertex.isFake())
+        return false;
+    const INode& node = vertex.getProcessNode();
+    if(node.getNodeType() != INode::eNodeTypeImageEffect)
+        return false;
+    return node.asImageEffectNode().isPointwise();
+}
+
+/**
+ * @brief Search the chains of pointwise nodes which can be rendered in the same buffer:
+ * each node of a chain is the only reader of the previous one, on its source clip,
+ * at the same time and with the same RoI and pixel format.
+ * @param[out] chains the nodes of each chain from its first node, by the key of its last node
+ */
+void ProcessGraph::findPointwiseChains(
+    const std::map<VertexAtTime::Key, memory::CACHE_ELEMENT>& cachedResults,
+    std::map<VertexAtTime::Key, std::vector<InternalGraphAtTimeImpl::vertex_descriptor> >& chains)
+{
+    typedef InternalGraphAtTimeImpl::vertex_descriptor VertexDescriptor;
+    const TraceSpan trace("graph", "findPointwiseChains");
+
+    // the input of each node rendered in the buffer of its input
+    std::map<VertexDescriptor, VertexDescriptor> fusedInputs;
+    std::set<VertexDescriptor> fusedOutputs;
+    BOOST_FOREACH(const VertexDescriptor vd, _renderGraphAtTime.getVertices())
+    {
+        const VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        // the graph at time is transposed, the out edges go to the inputs
+        if(!isPointwise(v) || cachedResults.count(v.getKey()) || _renderGraphAtTime.getOutDegree(vd) != 1)
+            continue;
+        const InternalGraphAtTimeImpl::edge_descriptor ed = *_renderGraphAtTime.getOutEdges(vd).first;
+        if(_renderGraphAtTime.instance(ed).getInAttrName() != kOfxSimpleSourceAttributeName)
+            continue;
+        const VertexDescriptor ud = _renderGraphAtTime.target(ed);
+        const VertexAtTime& u = _renderGraphAtTime.instance(ud);
+        if(!isPointwise(u) || cachedResults.count(u.getKey()))
+            continue;
+
+        const ProcessVertexAtTimeData& uData = u.getProcessDataAtTime();
+        const ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+        if(uData._isFinalNode || uData._outDegree != 1 || uData._time != vData._time)
+            continue;
+        const OfxRectD& uRoI = uData._apiImageEffect._renderRoI;
+        const OfxRectD& vRoI = vData._apiImageEffect._renderRoI;
+        if(uRoI.x1 != vRoI.x1 || uRoI.y1 != vRoI.y1 || uRoI.x2 != vRoI.x2 || uRoI.y2 != vRoI.y2)
+            continue;
+        const attribute::ClipImage& uClip = u.getProcessNode().asImageEffectNode().getOutputClip();
+        const attribute::ClipImage& vClip = v.getProcessNode().asImageEffectNode().getOutputClip();
+        if(uClip.getBitDepthString() != vClip.getBitDepthString() ||
+           uClip.getComponentsString() != vClip.getComponentsString() ||
+           uClip.getPixelAspectRatio() != vClip.getPixelAspectRatio())
+            continue;
+
+        fusedInputs[vd] = ud;
+        fusedOutputs.insert(ud);
+    }
+
+    typedef std::map<VertexDescriptor, VertexDescriptor>::value_type FusedInput;
+    BOOST_FOREACH(const FusedInput& fusedInput, fusedInputs)
+    {
+        // build each chain from its last node
+        if(fusedOutputs.count(fusedInput.first))
+            continue;
+        std::vector<VertexDescriptor> chain(1, fusedInput.first);
+        for(std::map<VertexDescriptor, VertexDescriptor>::const_iterator it = fusedInputs.find(fusedInput.first);
+            it != fusedInputs.end(); it = fusedInputs.find(it->second))
+        {
+            chain.push_back(it->second);
+        }
+        std::reverse(chain.begin(), chain.end());
+        TUTTLE_LOG_TRACE("[Pointwise chains] " << chain.size() << " nodes rendered in the buffer of "
+                                               << _renderGraphAtTime.instance(chain.front()).getName());
+        chains[_renderGraphAtTime.instance(fusedInput.first).getKey()] = chain;
+    }
+}
+
+/**
+ * @brief Memory needed by the images of the nodes to render the frame @p time, from their RoI.
+ * It supposes the nodes are rendered in the order of the Process visitor, and ignores the results found in cache.
+ */
+std::size_t ProcessGraph::predictPeakMemoryAtTime(const OfxTime time)
+{
+    graph::visitor::PredictPeakMemory<InternalGraphAtTimeImpl> predictVisitor(_renderGraphAtTime);
+    _renderGraphAtTime.depthFirstVisit(predictVisitor, getOutputVertexAtTime(time));
+    return predictVisitor.getPeak();
+}
+
 void ProcessGraph::processAtTime(memory::IMemoryCache& outCache, const OfxTime time)
 {
     _options.processAtTimeHandle();
 #if(TUTTLE_EXPORT_WITH_TIMER)
     boost::timer::cpu_timer timer;
 #endif
+    const TraceSpan traceProcessAtTime("graph", "processAtTime");
 
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Output node : " << _renderGraph.getVertex(_outputId).getName());
     InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
 
     // Launch a pass of callbacks on the nodes
-    graph::visitor::BeforeRenderCallbackVisitor<InternalGraphAtTimeImpl> callbackRun(_renderGraphAtTime);
-    _renderGraphAtTime.depthFirstVisit(callbackRun, outputAtTime);
+    {
+        const TraceSpan trace("visitor", "BeforeRenderCallback");
+        graph::visitor::BeforeRenderCallbackVisitor<InternalGraphAtTimeImpl> callbackRun(_renderGraphAtTime);
+        _renderGraphAtTime.depthFirstVisit(callbackRun, outputAtTime);
+    }
 
     // do the process
     graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor(_renderGraphAtTime, _internMemoryCache);
@@ -555,11 +1126,36 @@ void ProcessGraph::processAtTime(memory::IMemoryCache& outCache, const OfxTime t
         processVisitor.setOutputMemoryCache(outCache);
     }
 
-    _renderGraphAtTime.depthFirstVisit(processVisitor, outputAtTime);
+    // reuse the node results computed by previous frames or renders
+    graph::visitor::Process<InternalGraphAtTimeImpl>::ResultHashes resultHashes;
+    graph::visitor::Process<InternalGraphAtTimeImpl>::CachedResults cachedResults;
+    graph::visitor::Process<InternalGraphAtTimeImpl>::DiskCacheKeys diskCacheKeys;
+    if(_internMemoryCache.getMaxMemorySize() > 0 || _renderDiskCache.isEnabled())
+    {
+        useCachedResults(time, resultHashes, cachedResults, diskCacheKeys);
+        processVisitor.setCachedResults(resultHashes, cachedResults);
+    }
+    if(_renderDiskCache.isEnabled())
+        processVisitor.setRenderDiskCache(_renderDiskCache, diskCacheKeys);
+
+    graph::visitor::Process<InternalGraphAtTimeImpl>::FusedChains fusedChains;
+    if(_options.getFusePointwiseNodes())
+    {
+        findPointwiseChains(cachedResults, fusedChains);
+        processVisitor.setFusedChains(fusedChains);
+    }
+
+    {
+        const TraceSpan trace("visitor", "Process");
+        _renderGraphAtTime.depthFirstVisit(processVisitor, outputAtTime);
+    }
 
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Post process");
-    graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor(_renderGraphAtTime);
-    _renderGraphAtTime.depthFirstVisit(postProcessVisitor, outputAtTime);
+    {
+        const TraceSpan trace("visitor", "PostProcess");
+        graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor(_renderGraphAtTime);
+        _renderGraphAtTime.depthFirstVisit(postProcessVisitor, outputAtTime);
+    }
 
     ///@todo clean datas...
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Clear data at time");
@@ -573,14 +1169,165 @@ void ProcessGraph::processAtTime(memory::IMemoryCache& outCache, const OfxTime t
         }
     }
 
-    // clear cache at each frame
-    // @todo: remove
+    // Release the intermediate images at each frame, the intern cache keeps the results within its memory budget.
     _internMemoryCache.clearUnused();
 
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size());
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Out cache size: " << outCache.size());
 }
 
+bool ProcessGraph::processFrames(memory::IMemoryCache& outCache, FrameQueue& frames)
+{
+    MemoryReport* const memoryReport = _options.getMemoryReport().get();
+    OfxTime time;
+    while(frames.pop(time))
+    {
+        _options.beginFrameHandle();
+        const TraceScope traceFrame(_options.getTracer().get(), time);
+        const TraceSpan trace("graph", "frame");
+
+        try
+        {
+#if(TUTTLE_EXPORT_WITH_TIMER)
+            boost::timer::cpu_timer setup_timer;
+#endif
+            setupAtTime(time);
+#if(TUTTLE_EXPORT_WITH_TIMER)
+            TUTTLE_LOG_INFO("[process timer] setup " << boost::timer::format(setup_timer.elapsed()));
+#endif
+
+            // With parallel frames, the peak of the shared MemoryPool includes the other frames in flight.
+            FrameMemoryUsage frameMemory;
+            if(memoryReport)
+            {
+                frameMemory._time = time;
+                frameMemory._predictedPeak = predictPeakMemoryAtTime(time);
+                core().getMemoryPool().resetPeak();
+                _internMemoryCache.resetPeak();
+            }
+
+#if(TUTTLE_EXPORT_WITH_TIMER)
+            boost::timer::cpu_timer processAtTime_timer;
+#endif
+            processAtTime(outCache, time);
+#if(TUTTLE_EXPORT_WITH_TIMER)
+            TUTTLE_LOG_INFO("[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()));
+#endif
+
+            if(memoryReport)
+            {
+                const memory::IMemoryPool& pool = core().getMemoryPool();
+                frameMemory._poolPeakUsed = pool.getPeakUsedMemorySize();
+                frameMemory._poolPeakAllocated = pool.getPeakAllocatedMemorySize();
+                frameMemory._peakBuffers = pool.getPeakBuffers();
+                frameMemory._cachePeak = _internMemoryCache.getPeakMemorySize();
+                memoryReport->addFrame(frameMemory);
+            }
+        }
+        catch(tuttle::exception::FileInSequenceNotExist& e) // @todo tuttle: change that.
+        {
+            e << tuttle::exception::time(time);
+            if(_options.getContinueOnError() || _options.getContinueOnMissingFile())
+            {
+                TUTTLE_LOG_WARNING("[Process render] Missing input file at frame " << time << "." << std::endl);
+                TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                                 << std::endl
+                                 << tuttle::exception::format_exception_info(e));
+            }
+            else
+            {
+                TUTTLE_LOG_ERROR("[Process render] Missing input file at frame " << time << "." << std::endl);
+                _options.endFrameHandle();
+                throw;
+            }
+        }
+        catch(::boost::exception& e)
+        {
+            e << tuttle::exception::time(time);
+            if(_options.getContinueOnError())
+            {
+                TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl);
+                TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                                 << std::endl
+                                 << tuttle::exception::format_exception_info(e));
+            }
+            else
+            {
+                TUTTLE_LOG_ERROR("[Process render] Stopped at frame " << time << "." << std::endl);
+                _options.endFrameHandle();
+                throw;
+            }
+        }
+        catch(...)
+        {
+            if(_options.getContinueOnError())
+            {
+                TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl
+                                                                << tuttle::exception::format_current_exception());
+            }
+            else
+            {
+                TUTTLE_LOG_ERROR("[Process render] Error at frame " << time << "." << std::endl);
+                _options.endFrameHandle();
+                throw;
+            }
+        }
+
+        if(_options.getAbort())
+        {
+            TUTTLE_LOG_ERROR("[Process render] PROCESS ABORTED at time " << time << ".");
+            _options.endFrameHandle();
+            return false;
+        }
+        _options.endFrameHandle();
+    }
+
+    if(_options.getAbort())
+    {
+        TUTTLE_LOG_ERROR("[Process render] PROCESS ABORTED before frame rendering.");
+        return false;
+    }
+    return true;
+}
+
+void ProcessGraph::processFramesInThread(memory::IMemoryCache& outCache, FrameQueue& frames)
+{
+    try
+    {
+        processFrames(outCache, frames);
+    }
+    catch(...)
+    {
+        frames.setError(boost::current_exception());
+    }
+}
+
+bool ProcessGraph::processParallelFrames(memory::IMemoryCache& outCache, FrameQueue& frames,
+                                         const std::size_t nbParallelFrames)
+{
+    TUTTLE_LOG_INFO("[Process render] render " << nbParallelFrames << " frames in parallel");
+
+    // This graph renders frames in the current thread, each other thread renders frames
+    // with its own copy of the graph and of the nodes.
+    // The intermediate images are kept in a separate cache per thread, because two frames
+    // may need the same node at the same time, with the policy and the size of the main cache.
+    // The MemoryPool is shared.
+    {
+        ParallelWorkers workers;
+        for(std::size_t i = 1; i < nbParallelFrames; ++i)
+            workers.start(*this);
+
+        workers.launch(outCache, frames);
+        processFramesInThread(outCache, frames);
+        workers.join();
+    }
+
+    if(frames.getError())
+        boost::rethrow_exception(frames.getError());
+
+    return !_options.getAbort();
+}
+
 bool ProcessGraph::process(memory::IMemoryCache& outCache)
 {
 #if(TUTTLE_EXPORT_WITH_TIMER)
@@ -616,117 +1363,47 @@ bool ProcessGraph::process(memory::IMemoryCache& outCache)
     TUTTLE_LOG_TRACE("[Process render] begin timeRange: [" << globalTimeRange._begin << ", " << globalTimeRange._end << "]");
     beginSequence(globalTimeRange);
 
-    // RENDER (at each frame)
+    FrameQueue frames(_options);
     BOOST_FOREACH(const TimeRange& timeRange, timeRanges)
     {
         TUTTLE_LOG_TRACE("[Process render] process timeRange: [" << timeRange._begin << ", " << timeRange._end << ", "
                                                                  << timeRange._step << "]");
-
-        // If someone had asked to abort the process
-        if(_options.getAbort())
-        {
-            TUTTLE_LOG_ERROR("[Process render] PROCESS ABORTED before first frame.");
-            endSequence();
-            _internMemoryCache.clearUnused();
-            return false;
-        }
-
         for(int time = timeRange._begin; time <= timeRange._end; time += timeRange._step)
-        {
-            _options.beginFrameHandle();
+            frames.push(time);
+    }
 
-            try
-            {
-#if(TUTTLE_EXPORT_WITH_TIMER)
-                boost::timer::cpu_timer setup_timer;
-#endif
-                setupAtTime(time);
-#if(TUTTLE_EXPORT_WITH_TIMER)
-                TUTTLE_LOG_INFO("[process timer] setup " << boost::timer::format(setup_timer.elapsed()));
-#endif
+    std::size_t nbParallelFrames = _options.getNbParallelFrames();
+    if(nbParallelFrames == 0)
+        nbParallelFrames = boost::thread::hardware_concurrency();
+    nbParallelFrames = std::min(nbParallelFrames, frames.size());
 
-#if(TUTTLE_EXPORT_WITH_TIMER)
-                boost::timer::cpu_timer processAtTime_timer;
-#endif
-                processAtTime(outCache, time);
-#if(TUTTLE_EXPORT_WITH_TIMER)
-                TUTTLE_LOG_INFO("[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()));
-#endif
-            }
-            catch(tuttle::exception::FileInSequenceNotExist& e) // @todo tuttle: change that.
-            {
-                e << tuttle::exception::time(time);
-                if(_options.getContinueOnError() || _options.getContinueOnMissingFile())
-                {
-                    TUTTLE_LOG_WARNING("[Process render] Missing input file at frame " << time << "." << std::endl);
-                    TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
-                                     << std::endl
-                                     << tuttle::exception::format_exception_info(e));
-                }
-                else
-                {
-                    TUTTLE_LOG_ERROR("[Process render] Missing input file at frame " << time << "." << std::endl);
-                    _options.endFrameHandle();
-                    endSequence();
-                    _renderGraphAtTime.clear();
-                    _internMemoryCache.clearUnused();
-                    throw;
-                }
-            }
-            catch(::boost::exception& e)
-            {
-                e << tuttle::exception::time(time);
-                if(_options.getContinueOnError())
-                {
-                    TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl);
-                    TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
-                                     << std::endl
-                                     << tuttle::exception::format_exception_info(e));
-                }
-                else
-                {
-                    TUTTLE_LOG_ERROR("[Process render] Stopped at frame " << time << "." << std::endl);
-                    _options.endFrameHandle();
-                    endSequence();
-                    _renderGraphAtTime.clear();
-                    _internMemoryCache.clearUnused();
-                    throw;
-                }
-            }
-            catch(...)
-            {
-                if(_options.getContinueOnError())
-                {
-                    TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl
-                                                                    << tuttle::exception::format_current_exception());
-                }
-                else
-                {
-                    TUTTLE_LOG_ERROR("[Process render] Error at frame " << time << "." << std::endl);
-                    _options.endFrameHandle();
-                    endSequence();
-                    _renderGraphAtTime.clear();
-                    _internMemoryCache.clearUnused();
-                    throw;
-                }
-            }
-
-            if(_options.getAbort())
-            {
-                TUTTLE_LOG_ERROR("[Process render] PROCESS ABORTED at time " << time << ".");
-                _options.endFrameHandle();
-                endSequence();
-                _renderGraphAtTime.clear();
-                _internMemoryCache.clearUnused();
-                return false;
-            }
-            _options.endFrameHandle();
-        }
+    // RENDER (at each frame)
+    bool result = false;
+    try
+    {
+        if(nbParallelFrames > 1)
+            result = processParallelFrames(outCache, frames, nbParallelFrames);
+        else
+            result = processFrames(outCache, frames);
+    }
+    catch(...)
+    {
+        endSequence();
+        _renderGraphAtTime.clear();
+        _internMemoryCache.clearUnused();
+        throw;
     }
 
     // End range of frames
     endSequence();
 
+    if(!result)
+    {
+        _renderGraphAtTime.clear();
+        _internMemoryCache.clearUnused();
+        return false;
+    }
+
 #if(TUTTLE_EXPORT_WITH_TIMER)
     TUTTLE_LOG_INFO("[all process timer] " << boost::timer::format(all_process_timer.elapsed()));
 #endif
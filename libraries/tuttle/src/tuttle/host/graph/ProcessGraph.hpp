@@ -10,8 +10,15 @@
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/NodeHashContainer.hpp>
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
+
+#include <boost/ptr_container/ptr_vector.hpp>
 
 #include <string>
+#include <utility>
+#include <vector>
+#include <map>
+#include <set>
 
 /**
  * @brief If there is a define PROCESSGRAPH_USE_LINK, we don't create a copy of all nodes and
@@ -57,11 +64,63 @@ public:
     ~ProcessGraph();
 
 private:
+    class FrameQueue;
+    class ParallelWorkers;
+
+    /**
+     * @brief Times of the graph at time deployed from the render graph,
+     * in the order of creation of the vertices and edges of the graph at time.
+     */
+    struct GraphAtTimeLayout
+    {
+        GraphAtTimeLayout()
+            : _time(0)
+        {
+        }
+
+        /// Same vertices and edges, at the same times relative to the frame
+        bool hasSameStructure(const GraphAtTimeLayout& other) const;
+
+        OfxTime _time;
+        std::vector<std::size_t> _nbVertexTimes; ///< per vertex of the render graph
+        std::vector<OfxTime> _vertexTimes;
+        std::vector<std::size_t> _nbEdgeTimes; ///< per edge of the render graph
+        std::vector<std::pair<OfxTime, OfxTime> > _edgeTimes; ///< input and output times
+    };
+
+    /**
+     * @brief Create a copy of @p other with its own copy of the nodes, to render frames in parallel.
+     */
+    ProcessGraph(const ProcessGraph& other, memory::IMemoryCache& internMemoryCache);
+
     VertexAtTime::Key getOutputKeyAtTime(const OfxTime time);
     InternalGraphAtTimeImpl::vertex_descriptor getOutputVertexAtTime(const OfxTime time);
 
     void relink();
+    void getGraphAtTimeLayout(GraphAtTimeLayout& layout, const OfxTime time);
+    void buildGraphAtTime(const GraphAtTimeLayout& layout);
+    void updateGraphAtTime(const GraphAtTimeLayout& layout);
+    void cloneNodes();
     void bakeGraphInformationToNodes(InternalGraphAtTimeImpl& renderGraphAtTime);
+    void preProcessAtTime(const OfxTime time, const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime);
+
+    void beginSequenceNodes();
+    void endSequenceNodes();
+
+    bool isResultCacheable(const VertexAtTime& vertex) const;
+    bool hasFileIdentity(const InternalGraphAtTimeImpl::vertex_descriptor vd,
+                         std::map<InternalGraphAtTimeImpl::vertex_descriptor, bool>& identities) const;
+    void useCachedResults(const OfxTime time, std::map<VertexAtTime::Key, std::size_t>& resultHashes,
+                          std::map<VertexAtTime::Key, memory::CACHE_ELEMENT>& cachedResults,
+                          std::set<VertexAtTime::Key>& diskCacheKeys);
+    std::size_t predictPeakMemoryAtTime(const OfxTime time);
+    bool isPointwise(const VertexAtTime& vertex) const;
+    void findPointwiseChains(const std::map<VertexAtTime::Key, memory::CACHE_ELEMENT>& cachedResults,
+                             std::map<VertexAtTime::Key, std::vector<InternalGraphAtTimeImpl::vertex_descriptor> >& chains);
+
+    bool processFrames(memory::IMemoryCache& outCache, FrameQueue& frames);
+    void processFramesInThread(memory::IMemoryCache& outCache, FrameQueue& frames);
+    bool processParallelFrames(memory::IMemoryCache& outCache, FrameQueue& frames, const std::size_t nbParallelFrames);
 
 public:
     void updateGraph(Graph& userGraph, const std::list<std::string>& outputNodes);
@@ -80,13 +139,22 @@ public:
 private:
     InternalGraphImpl _renderGraph;
     InternalGraphAtTimeImpl _renderGraphAtTime;
+    /// @name Reuse the graph at time of the previous frame
+    /// @{
+    GraphAtTimeLayout _renderGraphAtTimeLayout;
+    std::vector<InternalGraphAtTimeImpl::vertex_descriptor> _renderGraphAtTimeVertices; ///< in the layout order
+    std::vector<InternalGraphAtTimeImpl::edge_descriptor> _renderGraphAtTimeEdges;     ///< in the layout order
+    bool _renderGraphAtTimeReusable; ///< false if the connections have changed since its creation
+    /// @}
     NodeMap _nodes;
     InstanceCountMap _instanceCount;
+    boost::ptr_vector<INode> _nodeClones; ///< nodes owned by a ProcessGraph rendering frames in parallel
 
     static const std::string _outputId;
 
     const ComputeOptions& _options;
     memory::IMemoryCache& _internMemoryCache;
+    RenderDiskCache _renderDiskCache; ///< node results kept between processes
     ProcessVertexData _procOptions;
 };
 }
@@ -36,6 +36,12 @@ ProcessVertexAtTime::~ProcessVertexAtTime()
 {
 }
 
+void ProcessVertexAtTime::setTime(const OfxTime t)
+{
+    this->_name = _clipName + "_at_" + boost::lexical_cast<std::string>(t);
+    _data._time = t;
+}
+
 std::ostream& ProcessVertexAtTime::exportDotDebug(std::ostream& os) const
 {
     std::ostringstream s;
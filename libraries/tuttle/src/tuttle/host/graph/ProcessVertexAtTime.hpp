@@ -37,6 +37,8 @@ public:
     }
 
     Key getKey() const { return Key(_clipName, _data._time); }
+    /// Move the vertex to another time, the keys of the graph need to be rebuilt
+    void setTime(const OfxTime t);
 
     const ProcessVertexData& getProcessData() const { return *_data._nodeData; }
     ProcessVertexAtTimeData& getProcessDataAtTime() { return _data; }
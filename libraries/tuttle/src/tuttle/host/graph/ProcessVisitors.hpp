@@ -2,8 +2,13 @@
 #define _TUTTLE_HOST_PROCESSVISITORS_HPP_
 
 #include "ProcessVertexData.hpp"
+#include "ProcessVertexAtTimeData.hpp"
 
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/Tracer.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
 
 #include <boost/graph/properties.hpp>
 #include <boost/graph/visitors.hpp>
@@ -13,9 +18,14 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <list>
 #include <vector>
+#include <map>
+#include <set>
 
 namespace tuttle
 {
@@ -714,11 +724,21 @@ class Process : public boost::default_dfs_visitor
 public:
     typedef typename TGraph::GraphContainer GraphContainer;
     typedef typename TGraph::Vertex Vertex;
+    typedef std::map<typename Vertex::Key, std::size_t> ResultHashes;
+    typedef std::map<typename Vertex::Key, memory::CACHE_ELEMENT> CachedResults;
+    typedef std::set<typename Vertex::Key> DiskCacheKeys;
+    typedef std::vector<typename TGraph::vertex_descriptor> FusedChain;
+    typedef std::map<typename Vertex::Key, FusedChain> FusedChains;
 
     Process(TGraph& graph, memory::IMemoryCache& cache)
         : _graph(graph)
         , _cache(cache)
         , _result(NULL)
+        , _resultHashes(NULL)
+        , _cachedResults(NULL)
+        , _diskCache(NULL)
+        , _diskCacheKeys(NULL)
+        , _fusedChains(NULL)
     {
     }
 
@@ -726,6 +746,11 @@ public:
         : _graph(graph)
         , _cache(cache)
         , _result(&result)
+        , _resultHashes(NULL)
+        , _cachedResults(NULL)
+        , _diskCache(NULL)
+        , _diskCacheKeys(NULL)
+        , _fusedChains(NULL)
     {
     }
 
@@ -734,6 +759,43 @@ public:
      */
     void setOutputMemoryCache(memory::IMemoryCache& result) { _result = &result; }
 
+    /**
+     * Keep the output of the nodes with a hash in @p resultHashes as results of the cache,
+     * and use the results of @p cachedResults instead of processing these nodes.
+     */
+    void setCachedResults(const ResultHashes& resultHashes, const CachedResults& cachedResults)
+    {
+        _resultHashes = &resultHashes;
+        _cachedResults = &cachedResults;
+    }
+
+    /**
+     * Also save in @p diskCache the results of the nodes in @p diskCacheKeys.
+     */
+    void setRenderDiskCache(RenderDiskCache& diskCache, const DiskCacheKeys& diskCacheKeys)
+    {
+        _diskCache = &diskCache;
+        _diskCacheKeys = &diskCacheKeys;
+    }
+
+    /**
+     * Render the nodes of each chain of @p fusedChains in the buffer of its first node, band by band,
+     * when visiting the last node of the chain.
+     */
+    void setFusedChains(const FusedChains& fusedChains)
+    {
+        _fusedChains = &fusedChains;
+        _fusedNodes.clear();
+        BOOST_FOREACH(const typename FusedChains::value_type& fusedChain, fusedChains)
+        {
+            BOOST_FOREACH(const typename TGraph::vertex_descriptor vd, fusedChain.second)
+            {
+                if(vd != fusedChain.second.back())
+                    _fusedNodes.insert(_graph.instance(vd).getKey());
+            }
+        }
+    }
+
     template <class VertexDescriptor, class Graph>
     void finish_vertex(VertexDescriptor v, Graph& g)
     {
@@ -744,39 +806,135 @@ public:
         // it's just a link to final nodes
         if(vertex.isFake())
             return;
+        // rendered with the last node of its chain
+        if(_fusedNodes.find(vertex.getKey()) != _fusedNodes.end())
+            return;
 
         // check if abort ?
 
-        // launch the process
-        boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
-        vertex.getProcessNode().process(vertex.getProcessDataAtTime());
-        boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
-        _cumulativeTime += t2 - t1;
-
-        TUTTLE_LOG_TRACE("[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1
-                                      << " (cumul: " << _cumulativeTime << ")" << vertex);
+        const std::string outputIdentifier = vertex._clipName + "." kOfxOutputAttributeName;
+        typename CachedResults::const_iterator cachedResult;
+        if(_cachedResults && (cachedResult = _cachedResults->find(vertex.getKey())) != _cachedResults->end())
+        {
+            TUTTLE_LOG_TRACE("[Process] " << quotes(vertex._name) << " " << vertex._data._time << " in cache");
+            useCachedResult(vertex, outputIdentifier, cachedResult->second);
+        }
+        else
+        {
+            // launch the process
+            boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
+            typename FusedChains::const_iterator fusedChain;
+            if(_fusedChains && (fusedChain = _fusedChains->find(vertex.getKey())) != _fusedChains->end())
+                processFusedChain(fusedChain->second);
+            else
+                vertex.getProcessNode().process(vertex.getProcessDataAtTime());
+            boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
+            _cumulativeTime += t2 - t1;
+
+            TUTTLE_LOG_TRACE("[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1
+                                          << " (cumul: " << _cumulativeTime << ")" << vertex);
+
+            typename ResultHashes::const_iterator resultHash;
+            if(_resultHashes && (resultHash = _resultHashes->find(vertex.getKey())) != _resultHashes->end())
+            {
+                memory::CACHE_ELEMENT img = _cache.get(outputIdentifier, vertex._data._time);
+                _cache.putResult(resultHash->second, img, (t2 - t1).total_microseconds() * 1e-6);
+                if(_diskCache && img.get() && _diskCacheKeys->count(vertex.getKey()))
+                    _diskCache->store(resultHash->second, *img);
+            }
+        }
 
         if(_result && vertex.getProcessDataAtTime()._isFinalNode)
         {
-            memory::CACHE_ELEMENT img = _cache.get(vertex._clipName + "." kOfxOutputAttributeName, vertex._data._time);
+            memory::CACHE_ELEMENT img = _cache.get(outputIdentifier, vertex._data._time);
             if(!img.get())
             {
                 BOOST_THROW_EXCEPTION(exception::Logic()
                                       << exception::user() +
                                              "Output buffer not found in memoryCache at the end of the node process."
-                                      << exception::dev() + vertex._clipName + "." kOfxOutputAttributeName + " at time " +
-                                             vertex._data._time
+                                      << exception::dev() + outputIdentifier + " at time " + vertex._data._time
                                       << exception::nodeName(vertex._name) << exception::time(vertex._data._time));
             }
             _result->put(vertex._clipName, vertex._data._time, img);
         }
     }
 
+private:
+    /**
+     * @brief Render the pointwise nodes of @p chain in the same buffer.
+     * All the nodes render a band of rows before the next band, so the band stays in the processor cache
+     * between the nodes.
+     */
+    void processFusedChain(const FusedChain& chain)
+    {
+        const Vertex& last = _graph.instance(chain.back());
+        const TraceSpan trace("node", "processFusedChain", last.getName());
+
+        // keep the hand on all needed datas during the process of the chain
+        std::list<memory::CACHE_ELEMENT> neededDatas;
+        memory::IPoolDataPtr buffer;
+        bool supportsTiles = true;
+        BOOST_FOREACH(const typename TGraph::vertex_descriptor vd, chain)
+        {
+            Vertex& vertex = _graph.instance(vd);
+            ImageEffectNode& node = vertex.getProcessNode().asImageEffectNode();
+            node.beginProcess(vertex.getProcessDataAtTime(), neededDatas, buffer);
+            // the output image is the last needed data
+            buffer = neededDatas.back()->getPoolData();
+            supportsTiles = supportsTiles && node.supportsTiles();
+        }
+
+        const ImageEffectNode& lastNode = last.getProcessNode().asImageEffectNode();
+        const OfxRectI renderWindow = lastNode.getRenderWindow(last.getProcessDataAtTime());
+        const std::size_t rowBytes = std::max(std::abs(neededDatas.back()->getRowBytes()), 1);
+        const int bandHeight = supportsTiles ? std::max(int(_fusedBandMemorySize / rowBytes), 1)
+                                             : std::max(renderWindow.y2 - renderWindow.y1, 1);
+        for(int y = renderWindow.y1; y < renderWindow.y2; y += bandHeight)
+        {
+            const OfxRectI band = {renderWindow.x1, y, renderWindow.x2, std::min(y + bandHeight, renderWindow.y2)};
+            BOOST_FOREACH(const typename TGraph::vertex_descriptor vd, chain)
+            {
+                Vertex& vertex = _graph.instance(vd);
+                vertex.getProcessNode().asImageEffectNode().renderProcess(vertex.getProcessDataAtTime(), band);
+            }
+        }
+
+        BOOST_FOREACH(const typename TGraph::vertex_descriptor vd, chain)
+        {
+            Vertex& vertex = _graph.instance(vd);
+            vertex.getProcessNode().asImageEffectNode().endProcess(vertex.getProcessDataAtTime());
+        }
+    }
+
+    /**
+     * @brief Do what the node process does with its output, with an image computed before.
+     */
+    void useCachedResult(Vertex& vertex, const std::string& outputIdentifier, const memory::CACHE_ELEMENT& img)
+    {
+        const ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+        _cache.put(outputIdentifier, vData._time, img);
+
+        // declare future usages of the output
+        const std::size_t realOutDegree =
+            vData._outDegree - vData._isFinalNode; // final nodes have a connection to the fake output node.
+        if(realOutDegree > 0)
+            img->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost, realOutDegree);
+    }
+
 private:
     TGraph& _graph;
     memory::IMemoryCache& _cache;
     memory::IMemoryCache* _result;
+    const ResultHashes* _resultHashes;
+    const CachedResults* _cachedResults;
+    RenderDiskCache* _diskCache;
+    const DiskCacheKeys* _diskCacheKeys;
+    const FusedChains* _fusedChains;
+    std::set<typename Vertex::Key> _fusedNodes; ///< nodes of the chains rendered with the last node
     boost::posix_time::time_duration _cumulativeTime;
+
+    /// Size of the bands of the fused chains, a part of the last level cache of the processor
+    static const std::size_t _fusedBandMemorySize = 4 * 1024 * 1024;
 };
 
 template <class TGraph>
@@ -840,6 +998,72 @@ public:
 private:
     TGraph& _graph;
 };
+
+/**
+ * @brief Predict the peak of memory of the Process visitor, from the RoI of the nodes.
+ *
+ * Like the process, each node allocates its output image in the order of the visit, and an image is released when
+ * all the nodes reading it have been processed. The outputs of the final nodes are kept.
+ * Results found in cache are not taken into account, so it's an upper bound of the images allocated by the frame.
+ */
+template <class TGraph>
+class PredictPeakMemory : public boost::default_dfs_visitor
+{
+public:
+    typedef typename TGraph::Vertex Vertex;
+    typedef typename TGraph::vertex_descriptor vertex_descriptor;
+    typedef typename TGraph::edge_descriptor edge_descriptor;
+
+    PredictPeakMemory(TGraph& graph)
+        : _graph(graph)
+        , _memory(0)
+        , _peak(0)
+    {
+    }
+
+    template <class VertexDescriptor, class Graph>
+    void finish_vertex(VertexDescriptor v, Graph& g)
+    {
+        Vertex& vertex = _graph.instance(v);
+        if(vertex.isFake())
+            return;
+
+        const ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+        ProcessVertexAtTimeInfo infos;
+        vertex.getProcessNode().preProcess_infos(vData, vData._time, infos);
+        Output& output = _outputs[v];
+        output._memory = infos._memory;
+        output._readers = vData._outDegree; // the final nodes are also read by the fake output node, never processed
+        _memory += output._memory;
+        _peak = std::max(_peak, _memory);
+
+        BOOST_FOREACH(const edge_descriptor ed, _graph.getOutEdges(v))
+        {
+            typename std::map<vertex_descriptor, Output>::iterator input = _outputs.find(_graph.target(ed));
+            if(input != _outputs.end() && input->second._readers > 0 && --input->second._readers == 0)
+                _memory -= input->second._memory;
+        }
+    }
+
+    std::size_t getPeak() const { return _peak; }
+
+private:
+    struct Output
+    {
+        Output()
+            : _memory(0)
+            , _readers(0)
+        {
+        }
+        std::size_t _memory;
+        std::size_t _readers; ///< nodes not yet processed reading the image
+    };
+
+    TGraph& _graph;
+    std::map<vertex_descriptor, Output> _outputs;
+    std::size_t _memory;
+    std::size_t _peak;
+};
 }
 }
 }
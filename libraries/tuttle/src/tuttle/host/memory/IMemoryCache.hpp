@@ -2,6 +2,7 @@
 #define _TUTTLE_HOST_CORE_IMEMORYCACHE_HPP_
 
 #include "IMemoryPool.hpp"
+#include "MemoryCachePolicy.hpp"
 
 #include <boost/shared_ptr.hpp> ///< @todo temporary solution..
 #include <string>
@@ -65,6 +66,29 @@ public:
     virtual bool remove(const CACHE_ELEMENT&) = 0;
     virtual void clearUnused() = 0;
     virtual void clearAll() = 0;
+
+    /// @name Node results kept across frames, identified by a hash of the node and its inputs
+    /// @{
+    virtual void putResult(const std::size_t hash, CACHE_ELEMENT pData, const double cost) = 0;
+    virtual CACHE_ELEMENT getResult(const std::size_t hash) = 0;
+    virtual void setMaxMemorySize(const std::size_t maxSize) = 0;
+    virtual std::size_t getMaxMemorySize() const = 0;
+    virtual void setPolicy(const EMemoryCachePolicy policy) = 0;
+    virtual EMemoryCachePolicy getPolicy() const = 0;
+    virtual std::size_t getResultsMemorySize() const = 0;
+    virtual std::size_t getHitCount() const = 0;
+    virtual std::size_t getMissCount() const = 0;
+    virtual std::size_t getEvictionCount() const = 0;
+    virtual void resetCounters() = 0;
+    /// @}
+
+    /// @name Memory of the distinct images kept by the cache, and its high-water mark since the last resetPeak()
+    /// @{
+    virtual std::size_t getMemorySize() const = 0;
+    virtual std::size_t getPeakMemorySize() const = 0;
+    virtual void resetPeak() = 0;
+    /// @}
+
     virtual std::ostream& outputStream(std::ostream& os) const = 0;
     friend std::ostream& operator<<(std::ostream& os, const This& v);
 };
@@ -5,5 +5,6 @@
 #include <tuttle/host/memory/IMemoryCache.hpp>
 %}
 
+%include <tuttle/host/memory/MemoryCachePolicy.hpp>
 %include <tuttle/host/memory/IMemoryCache.hpp>
 
@@ -3,6 +3,8 @@
 
 #include <cstddef>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 namespace tuttle
@@ -20,6 +22,46 @@ public:
     virtual void release() = 0;
 };
 
+/**
+ * @brief What a buffer is allocated for: the image of a clip of a node at a time.
+ */
+struct BufferOwner
+{
+    BufferOwner()
+        : _time(0)
+    {
+    }
+    BufferOwner(const std::string& node, const std::string& clip, const double time)
+        : _node(node)
+        , _clip(clip)
+        , _time(time)
+    {
+    }
+
+    std::string _node; ///< empty if unknown
+    std::string _clip;
+    double _time;
+};
+
+/**
+ * @brief A buffer used by the pool, with its reserved size.
+ */
+struct BufferUsage
+{
+    BufferUsage()
+        : _size(0)
+    {
+    }
+    BufferUsage(const BufferOwner& owner, const std::size_t size)
+        : _owner(owner)
+        , _size(size)
+    {
+    }
+
+    BufferOwner _owner;
+    std::size_t _size;
+};
+
 class IPoolData : public IUnknown
 {
 public:
@@ -31,6 +73,8 @@ public:
     virtual const size_t reservedSize() const = 0;
 
     virtual void setSize(const std::size_t newSize) = 0;
+
+    virtual const BufferOwner& getOwner() const = 0;
 };
 
 void intrusive_ptr_add_ref(IPoolData* pData);
@@ -51,8 +95,20 @@ public:
     virtual void clear(size_t size) = 0;
     virtual void clearOne() = 0;
     virtual void clear() = 0;
-    virtual IPoolDataPtr allocate(const size_t size) = 0;
+    virtual IPoolDataPtr allocate(const size_t size, const BufferOwner& owner = BufferOwner()) = 0;
     virtual std::size_t updateMemoryAuthorizedWithRAM() = 0;
+
+    /// @name High-water mark since the last resetPeak()
+    /// @{
+    virtual std::size_t getPeakUsedMemorySize() const = 0;
+    virtual std::size_t getPeakAllocatedMemorySize() const = 0;
+    /// Buffers used when the used memory has reached its peak
+    virtual std::vector<BufferUsage> getPeakBuffers() const = 0;
+    virtual void resetPeak() = 0;
+    /// @}
+
+    /// Buffers currently used, with their owners
+    virtual std::vector<BufferUsage> getUsedBuffers() const = 0;
 };
 }
 }
@@ -4,6 +4,8 @@
 #include <boost/foreach.hpp>
 
 #include <functional>
+#include <algorithm>
+#include <climits>
 
 namespace tuttle
 {
@@ -31,13 +33,15 @@ struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
     {
     }
 
-    void operator()(const std::pair<Key, CACHE_ELEMENT>& pData)
+    void operator()(const std::pair<Key, CACHE_ELEMENT>& pData) { check(pData.second); }
+
+    void check(const CACHE_ELEMENT& pData)
     {
         // used data
-        if(!isUnused(pData.second))
+        if(!isUnused(pData))
             return;
 
-        const std::size_t bufferSize = pData.second->getPoolData()->reservedSize();
+        const std::size_t bufferSize = pData->getPoolData()->reservedSize();
 
         // Check minimum amount of memory
         if(_sizeNeeded > bufferSize)
@@ -47,7 +51,7 @@ struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
         if(diff >= _bestMatchDiff)
             return;
         _bestMatchDiff = diff;
-        _pBestMatch = pData.second;
+        _pBestMatch = pData;
     }
 
     CACHE_ELEMENT bestMatch() { return _pBestMatch; }
@@ -59,6 +63,19 @@ private:
 };
 }
 
+MemoryCache::MemoryCache()
+    : _resultsMemorySize(0)
+    , _maxMemorySize(0)
+    , _policy(eMemoryCachePolicyLRU)
+    , _inflation(0)
+    , _hitCount(0)
+    , _missCount(0)
+    , _evictionCount(0)
+    , _memorySize(0)
+    , _peakMemorySize(0)
+{
+}
+
 MemoryCache& MemoryCache::operator=(const MemoryCache& cache)
 {
     if(&cache == this)
@@ -66,13 +83,38 @@ MemoryCache& MemoryCache::operator=(const MemoryCache& cache)
     boost::mutex::scoped_lock lockerMap1(cache._mutexMap);
     boost::mutex::scoped_lock lockerMap2(_mutexMap);
     _map = cache._map;
+    _results = cache._results;
+    _usedResults = cache._usedResults;
+    _unusedResults = cache._unusedResults;
+    _unusedByPriority.clear();
+    for(ResultList::iterator it = _usedResults.begin(); it != _usedResults.end(); ++it)
+        _results[*it]._lruPosition = it;
+    for(ResultList::iterator it = _unusedResults.begin(); it != _unusedResults.end(); ++it)
+    {
+        Result& result = _results[*it];
+        result._lruPosition = it;
+        result._priorityPosition = _unusedByPriority.insert(std::make_pair(result._priority, *it));
+    }
+    _resultsMemorySize = cache._resultsMemorySize;
+    _maxMemorySize = cache._maxMemorySize;
+    _policy = cache._policy;
+    _inflation = cache._inflation;
+    _hitCount = cache._hitCount;
+    _missCount = cache._missCount;
+    _evictionCount = cache._evictionCount;
+    _imageReferences = cache._imageReferences;
+    _memorySize = cache._memorySize;
+    _peakMemorySize = cache._peakMemorySize;
     return *this;
 }
 
 void MemoryCache::put(const std::string& identifier, const double time, CACHE_ELEMENT pData)
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    _map[Key(identifier, time)] = pData;
+    CACHE_ELEMENT& element = _map[Key(identifier, time)];
+    referenceImage(pData);
+    unreferenceImage(element);
+    element = pData;
 }
 
 CACHE_ELEMENT MemoryCache::get(const std::string& identifier, const double time) const
@@ -100,7 +142,12 @@ CACHE_ELEMENT MemoryCache::get(const std::size_t& i) const
 CACHE_ELEMENT MemoryCache::getUnusedWithSize(const std::size_t requestedSize) const
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    return std::for_each(_map.begin(), _map.end(), UnusedDataFitSize(requestedSize)).bestMatch();
+    UnusedDataFitSize fitSize = std::for_each(_map.begin(), _map.end(), UnusedDataFitSize(requestedSize));
+    BOOST_FOREACH(const ResultMap::value_type& result, _results)
+    {
+        fitSize.check(result.second._data);
+    }
+    return fitSize.bestMatch();
 }
 
 std::size_t MemoryCache::size() const
@@ -172,10 +219,22 @@ const std::string& MemoryCache::getPluginName(const CACHE_ELEMENT& pData) const
 bool MemoryCache::remove(const CACHE_ELEMENT& pData)
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    const MAP::iterator itr = getIteratorForValue(pData);
+    bool removed = false;
+    for(ResultMap::iterator it = _results.begin(); it != _results.end(); ++it)
+    {
+        if(it->second._data == pData)
+        {
+            eraseResult(it);
+            ++_evictionCount;
+            removed = true;
+            break;
+        }
+    }
 
+    const MAP::iterator itr = getIteratorForValue(pData);
     if(itr == _map.end())
-        return false;
+        return removed;
+    unreferenceImage(itr->second);
     _map.erase(itr);
     return true;
 }
@@ -187,6 +246,7 @@ void MemoryCache::clearUnused()
     {
         if(isUnused(it->second))
         {
+            unreferenceImage(it->second);
             _map.erase(
                 it++); // post-increment here, increments 'it' and returns a copy of the original 'it' to be used by erase()
         }
@@ -195,6 +255,9 @@ void MemoryCache::clearUnused()
             ++it;
         }
     }
+    // results released during the frame can now be evicted
+    releaseUnusedResults();
+    evictResults();
 }
 
 void MemoryCache::clearAll()
@@ -202,11 +265,241 @@ void MemoryCache::clearAll()
     TUTTLE_LOG_DEBUG(" - MEMORYCACHE::CLEARALL - ");
     boost::mutex::scoped_lock lockerMap(_mutexMap);
     _map.clear();
+    _results.clear();
+    _usedResults.clear();
+    _unusedResults.clear();
+    _unusedByPriority.clear();
+    _resultsMemorySize = 0;
+    _imageReferences.clear();
+    _memorySize = 0;
+}
+
+void MemoryCache::putResult(const std::size_t hash, CACHE_ELEMENT pData, const double cost)
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    if(_maxMemorySize == 0 || pData.get() == NULL)
+        return;
+
+    ResultMap::iterator it = _results.find(hash);
+    if(it != _results.end())
+        eraseResult(it);
+
+    Result& result = _results[hash];
+    referenceImage(pData);
+    result._data = pData;
+    result._size = pData->getPoolData().get() ? pData->getPoolData()->reservedSize() : 0;
+    result._cost = cost;
+    result._priority = _inflation + cost / std::max(result._size, std::size_t(1));
+    // the result is used by the graph which computed it
+    result._used = true;
+    _usedResults.push_front(hash);
+    result._lruPosition = _usedResults.begin();
+    _resultsMemorySize += result._size;
+
+    evictResults();
+}
+
+CACHE_ELEMENT MemoryCache::getResult(const std::size_t hash)
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    if(_maxMemorySize == 0)
+        return CACHE_ELEMENT();
+
+    ResultMap::iterator it = _results.find(hash);
+    if(it == _results.end())
+    {
+        ++_missCount;
+        return CACHE_ELEMENT();
+    }
+    ++_hitCount;
+    it->second._priority = _inflation + it->second._cost / std::max(it->second._size, std::size_t(1));
+    markResultUsed(it->second);
+    return it->second._data;
+}
+
+void MemoryCache::markResultUsed(Result& result)
+{
+    if(result._used)
+    {
+        _usedResults.splice(_usedResults.begin(), _usedResults, result._lruPosition);
+        return;
+    }
+    _usedResults.splice(_usedResults.begin(), _unusedResults, result._lruPosition);
+    _unusedByPriority.erase(result._priorityPosition);
+    result._used = true;
+}
+
+void MemoryCache::markResultUnused(Result& result)
+{
+    _unusedResults.splice(_unusedResults.begin(), _usedResults, result._lruPosition);
+    result._priorityPosition = _unusedByPriority.insert(std::make_pair(result._priority, *result._lruPosition));
+    result._used = false;
+}
+
+/**
+ * @brief Move the results released since they were acquired to the unused ones, keeping their order of use.
+ */
+void MemoryCache::releaseUnusedResults()
+{
+    ResultList::iterator it = _usedResults.end();
+    while(it != _usedResults.begin())
+    {
+        ResultList::iterator previous = it;
+        --previous;
+        Result& result = _results.find(*previous)->second;
+        if(isUnused(result._data))
+            markResultUnused(result); // moved to the front of the unused results, `it` is still valid
+        else
+            it = previous;
+    }
+}
+
+void MemoryCache::eraseResult(const ResultMap::iterator it)
+{
+    _resultsMemorySize -= it->second._size;
+    unreferenceImage(it->second._data);
+    if(it->second._used)
+    {
+        _usedResults.erase(it->second._lruPosition);
+    }
+    else
+    {
+        _unusedResults.erase(it->second._lruPosition);
+        _unusedByPriority.erase(it->second._priorityPosition);
+    }
+    _results.erase(it);
+}
+
+void MemoryCache::evictResults()
+{
+    bool released = false;
+    while(_resultsMemorySize > _maxMemorySize)
+    {
+        if(_unusedResults.empty())
+        {
+            // only unused results can be removed, look once for the results released since they were acquired
+            if(released)
+                return;
+            releaseUnusedResults();
+            released = true;
+            continue;
+        }
+        const std::size_t hash =
+            _policy == eMemoryCachePolicyLRU ? _unusedResults.back() : _unusedByPriority.begin()->second;
+        ResultMap::iterator victim = _results.find(hash);
+        if(!isUnused(victim->second._data)) // acquired again without the cache
+        {
+            markResultUsed(victim->second);
+            continue;
+        }
+        if(_policy != eMemoryCachePolicyLRU)
+            _inflation = victim->second._priority;
+
+        TUTTLE_LOG_TRACE("[MemoryCache] evict result " << victim->second._data->getFullName());
+        eraseResult(victim);
+        ++_evictionCount;
+    }
+}
+
+void MemoryCache::referenceImage(const CACHE_ELEMENT& pData)
+{
+    if(pData.get() == NULL || ++_imageReferences[pData.get()] > 1)
+        return;
+    _memorySize += pData->getMemorySize();
+    _peakMemorySize = std::max(_peakMemorySize, _memorySize);
+}
+
+void MemoryCache::unreferenceImage(const CACHE_ELEMENT& pData)
+{
+    if(pData.get() == NULL)
+        return;
+    boost::unordered_map<const attribute::Image*, std::size_t>::iterator it = _imageReferences.find(pData.get());
+    if(it == _imageReferences.end() || --it->second > 0)
+        return;
+    _imageReferences.erase(it);
+    _memorySize -= pData->getMemorySize();
+}
+
+void MemoryCache::setMaxMemorySize(const std::size_t maxSize)
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    _maxMemorySize = maxSize;
+    evictResults();
+}
+
+std::size_t MemoryCache::getMaxMemorySize() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _maxMemorySize;
+}
+
+void MemoryCache::setPolicy(const EMemoryCachePolicy policy)
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    _policy = policy;
+}
+
+EMemoryCachePolicy MemoryCache::getPolicy() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _policy;
+}
+
+std::size_t MemoryCache::getResultsMemorySize() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _resultsMemorySize;
+}
+
+std::size_t MemoryCache::getHitCount() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _hitCount;
+}
+
+std::size_t MemoryCache::getMissCount() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _missCount;
+}
+
+std::size_t MemoryCache::getEvictionCount() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _evictionCount;
+}
+
+void MemoryCache::resetCounters()
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    _hitCount = _missCount = _evictionCount = 0;
+}
+
+std::size_t MemoryCache::getMemorySize() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _memorySize;
+}
+
+std::size_t MemoryCache::getPeakMemorySize() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _peakMemorySize;
+}
+
+void MemoryCache::resetPeak()
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    _peakMemorySize = _memorySize;
 }
 
 std::ostream& operator<<(std::ostream& os, const MemoryCache& v)
 {
     os << "[MemoryCache] size:" << v.size() << std::endl;
+    os << "[MemoryCache] results:" << v._results.size() << " (" << v._resultsMemorySize << "/" << v._maxMemorySize
+       << " bytes), images:" << v._memorySize << " bytes (peak " << v._peakMemorySize << ")"
+       << ", hits:" << v._hitCount << ", misses:" << v._missCount << ", evictions:" << v._evictionCount
+       << std::endl;
     BOOST_FOREACH(const MemoryCache::MAP::value_type& i, v._map)
     {
         os << "[MemoryCache] " << i.first << " id:" << i.second->getId()
@@ -7,6 +7,9 @@
 #include <boost/unordered_map.hpp>
 #include <boost/thread.hpp>
 
+#include <list>
+#include <map>
+
 namespace tuttle
 {
 namespace host
@@ -20,7 +23,7 @@ class MemoryCache : public IMemoryCache
 
 public:
     MemoryCache(const MemoryCache& other) { *this = other; }
-    MemoryCache() {}
+    MemoryCache();
     ~MemoryCache() {}
 
     MemoryCache& operator=(const MemoryCache& cache);
@@ -29,11 +32,56 @@ private:
     typedef boost::unordered_map<Key, CACHE_ELEMENT, KeyHash> MAP;
     //	typedef std::map<Key, CACHE_ELEMENT> MAP;
     MAP _map;
-    mutable boost::mutex _mutexMap; ///< Mutex for cache data map.
+    mutable boost::mutex _mutexMap; ///< Mutex for cache data map and results.
 
     MAP::const_iterator getIteratorForValue(const CACHE_ELEMENT&) const;
     MAP::iterator getIteratorForValue(const CACHE_ELEMENT&);
 
+#ifndef SWIG
+    typedef std::list<std::size_t> ResultList;
+    typedef std::multimap<double, std::size_t> ResultsByPriority;
+    struct Result
+    {
+        CACHE_ELEMENT _data;
+        std::size_t _size;
+        double _cost;     ///< time to compute the data
+        double _priority; ///< eMemoryCachePolicyCostSize priority
+        bool _used;       ///< in _usedResults, else in _unusedResults and _unusedByPriority
+        ResultList::iterator _lruPosition;
+        ResultsByPriority::iterator _priorityPosition; ///< only for an unused result
+    };
+    typedef boost::unordered_map<std::size_t, Result> ResultMap;
+    ResultMap _results;
+    /// @name Results hashes, most recently used first
+    /// Results acquired since the last check of their references are kept apart, so that an eviction only looks at
+    /// the unused ones.
+    /// @{
+    ResultList _usedResults;
+    ResultList _unusedResults;
+    ResultsByPriority _unusedByPriority; ///< lowest priority first
+    /// @}
+    std::size_t _resultsMemorySize;
+    std::size_t _maxMemorySize;
+    EMemoryCachePolicy _policy;
+    double _inflation; ///< eMemoryCachePolicyCostSize aging value
+    std::size_t _hitCount;
+    std::size_t _missCount;
+    std::size_t _evictionCount;
+
+    /// number of references of each image by the map and the results, to count each image once
+    boost::unordered_map<const attribute::Image*, std::size_t> _imageReferences;
+    std::size_t _memorySize;
+    std::size_t _peakMemorySize;
+
+    void markResultUsed(Result& result);
+    void markResultUnused(Result& result);
+    void releaseUnusedResults();
+    void eraseResult(const ResultMap::iterator it);
+    void evictResults();
+    void referenceImage(const CACHE_ELEMENT& pData);
+    void unreferenceImage(const CACHE_ELEMENT& pData);
+#endif
+
 public:
     void put(const std::string& identifier, const double time, CACHE_ELEMENT pData);
     CACHE_ELEMENT get(const std::string& identifier, const double time) const;
@@ -47,6 +95,24 @@ public:
     bool remove(const CACHE_ELEMENT&);
     void clearUnused();
     void clearAll();
+
+    void putResult(const std::size_t hash, CACHE_ELEMENT pData, const double cost);
+    CACHE_ELEMENT getResult(const std::size_t hash);
+    /// Memory budget of the results, 0 to disable them
+    void setMaxMemorySize(const std::size_t maxSize);
+    std::size_t getMaxMemorySize() const;
+    void setPolicy(const EMemoryCachePolicy policy);
+    EMemoryCachePolicy getPolicy() const;
+    std::size_t getResultsMemorySize() const;
+    std::size_t getHitCount() const;
+    std::size_t getMissCount() const;
+    std::size_t getEvictionCount() const;
+    void resetCounters();
+
+    std::size_t getMemorySize() const;
+    std::size_t getPeakMemorySize() const;
+    void resetPeak();
+
     std::ostream& outputStream(std::ostream& os) const
     {
         os << *this;
@@ -0,0 +1,23 @@
+#ifndef _TUTTLE_HOST_CORE_MEMORYCACHEPOLICY_HPP_
+#define _TUTTLE_HOST_CORE_MEMORYCACHEPOLICY_HPP_
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+/**
+ * @brief Choice of the node results to remove when the MemoryCache is over its memory budget.
+ */
+enum EMemoryCachePolicy
+{
+    eMemoryCachePolicyLRU = 0, ///< least recently used first
+    eMemoryCachePolicyCostSize ///< cheapest to recompute per byte first, aged by recency (GreedyDual-Size)
+};
+}
+}
+}
+
+#endif
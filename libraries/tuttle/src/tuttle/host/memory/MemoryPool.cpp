@@ -1,9 +1,12 @@
 #include "MemoryPool.hpp"
+#include "PoolAllocator.hpp"
 
 #include <tuttle/common/utils/global.hpp>
 #include <tuttle/common/system/memoryInfo.hpp>
 #include <tuttle/host/Core.hpp>
+#include <tuttle/host/Tracer.hpp>
 
+#include <boost/foreach.hpp>
 #include <boost/throw_exception.hpp>
 
 #include <algorithm>
@@ -27,17 +30,20 @@ private:
     friend class MemoryPool;
 
 public:
-    PoolData(IPool& pool, const std::size_t size)
+    PoolData(IPool& pool, const std::size_t size, const EPoolAllocator allocator, const BufferOwner& owner)
         : _pool(pool)
         , _id(_count++)
         , _reservedSize(size)
         , _size(size)
-        , _pData(new char[size])
+        , _allocator(allocator)
+        , _pData(poolAllocate(_allocator, size))
         , _refCount(0)
+        , _owner(owner)
+        , _usedGeneration(0)
     {
     }
 
-    ~PoolData() { delete[] _pData; }
+    ~PoolData() { poolDeallocate(_allocator, _pData, _reservedSize); }
 
 public:
     bool operator==(const PoolData& other) const { return _id == other._id; }
@@ -49,6 +55,7 @@ public:
     const char* data() const { return _pData; }
     const std::size_t size() const { return _size; }
     const std::size_t reservedSize() const { return _reservedSize; }
+    EPoolAllocator allocator() const { return _allocator; }
 
     void setSize(const std::size_t newSize)
     {
@@ -56,14 +63,20 @@ public:
         _size = newSize;
     }
 
+    const BufferOwner& getOwner() const { return _owner; }
+    void setOwner(const BufferOwner& owner) { _owner = owner; }
+
 private:
     static std::size_t _count;       ///< unique id generator
     IPool& _pool;                    ///< ref to the owner pool
     const std::size_t _id;           ///< unique id to identify one memory data
     const std::size_t _reservedSize; ///< memory allocated
     std::size_t _size;               ///< memory requested
+    EPoolAllocator _allocator;       ///< backing of the data, may differ from the requested one
     char* const _pData;              ///< own the data
     int _refCount;                   ///< counter on clients currently using this data
+    BufferOwner _owner;              ///< last requester of the data
+    std::size_t _usedGeneration;     ///< generation of the pool when the data was marked used
 };
 
 void intrusive_ptr_add_ref(IPoolData* pData)
@@ -91,8 +104,17 @@ void PoolData::release()
 }
 
 MemoryPool::MemoryPool(const std::size_t maxSize)
-    : _memoryAuthorized(maxSize)
-{
+    : _usedMemorySize(0)
+    , _unusedMemorySize(0)
+    , _wastedMemorySize(0)
+    , _memoryAuthorized(maxSize)
+    , _peakUsedMemorySize(0)
+    , _peakAllocatedMemorySize(0)
+    , _generation(0)
+    , _peakGeneration(0)
+{
+    std::fill(_allocatorMemorySize, _allocatorMemorySize + ePoolAllocatorCount, 0);
+    std::fill(_allocatorDataSize, _allocatorDataSize + ePoolAllocatorCount, 0);
 }
 
 MemoryPool::~MemoryPool()
@@ -105,80 +127,65 @@ MemoryPool::~MemoryPool()
     }
 }
 
+MemoryPool::DataBySize::key_type MemoryPool::sizeKey(const PoolData* pData)
+{
+    return std::make_pair(pData->reservedSize(), pData->_id);
+}
+
 void MemoryPool::referenced(PoolData* pData)
 {
     boost::mutex::scoped_lock locker(_mutex);
-    DataList::iterator it = _dataUnused.find(pData);
+    DataBySize::iterator it = _dataUnused.find(sizeKey(pData));
 
     if(it != _dataUnused.end())
     {
         _dataUnused.erase(it);
+        _unusedMemorySize -= pData->reservedSize();
+    }
+    else if(_dataUsed.find(pData) != _dataUsed.end()) // already marked used by getOneAvailableData
+    {
+        return;
     }
     else // a really new data
     {
-        _allDatas.push_back(pData);
+        std::size_t id = pData->_id;
+        _allDatas.insert(id, pData);
         _dataMap[pData->data()] = pData;
+        _allocatorMemorySize[pData->allocator()] += pData->reservedSize();
+        ++_allocatorDataSize[pData->allocator()];
     }
-    _dataUsed.insert(pData);
+    markUsed(pData);
 }
 
 void MemoryPool::released(PoolData* pData)
 {
     boost::mutex::scoped_lock locker(_mutex);
-    _dataUsed.erase(pData);
-    _dataUnused.insert(pData);
+    if(_dataUsed.erase(pData) == 0)
+        return;
+    ++_generation;
+    if(pData->_usedGeneration <= _peakGeneration) // the data was used at the peak
+        _peakReleasedBuffers.push_back(BufferUsage(pData->getOwner(), pData->reservedSize()));
+    _usedMemorySize -= pData->reservedSize();
+    _wastedMemorySize -= pData->reservedSize() - pData->size();
+    _dataUnused.insert(std::make_pair(sizeKey(pData), pData));
+    _unusedMemorySize += pData->reservedSize();
 }
 
 namespace
 {
-
-/// Functor to get the smallest element in pool
-struct DataFitSize : public std::unary_function<PoolData*, void>
-{
-    DataFitSize(std::size_t size)
-        : _sizeNeeded(size)
-        , _bestMatchDiff(ULONG_MAX)
-        , _pBestMatch(NULL)
-    {
-    }
-
-    void operator()(PoolData* pData)
-    {
-        const std::size_t dataSize = pData->reservedSize();
-
-        // Check minimum amount of memory
-        if(_sizeNeeded > dataSize)
-            return;
-        // Do not reuse too big buffers
-        if(dataSize > _maxBufferRatio * _sizeNeeded)
-            return;
-        const std::size_t diff = dataSize - _sizeNeeded;
-        if(diff >= _bestMatchDiff)
-            return;
-        _bestMatchDiff = diff;
-        _pBestMatch = pData;
-    }
-
-    PoolData* bestMatch() { return _pBestMatch; }
-
-private:
-    static const double _maxBufferRatio; //< max ratio between used and unused part of the buffer
-    const std::size_t _sizeNeeded;
-    std::size_t _bestMatchDiff;
-    PoolData* _pBestMatch;
-};
-
-const double DataFitSize::_maxBufferRatio = 2.0;
+/// max ratio between used and unused part of a reused buffer
+const std::size_t maxBufferRatio = 2;
 }
 
-IPoolDataPtr MemoryPool::allocate(const std::size_t size)
+IPoolDataPtr MemoryPool::allocate(const std::size_t size, const BufferOwner& owner)
 {
+    const TraceSpan trace("memory", "allocate", "", size);
+
     // Try to reuse a buffer available in the MemoryPool
-    IPoolData* pData = getOneAvailableData(size);
+    IPoolData* pData = getOneAvailableData(size, owner);
     if(pData != NULL)
     {
         TUTTLE_LOG_TRACE("[Memory Pool] Reuse a buffer available in the MemoryPool");
-        pData->setSize(size);
         return pData;
     }
 
@@ -191,11 +198,10 @@ IPoolDataPtr MemoryPool::allocate(const std::size_t size)
                                                                               << " of size " << size);
         memoryCache.remove(unusedCacheElement);
 
-        pData = getOneAvailableData(size);
+        pData = getOneAvailableData(size, owner);
         if(pData != NULL)
         {
             TUTTLE_LOG_TRACE("[Memory Pool] Reuse a buffer available in the MemoryPool");
-            pData->setSize(size);
             return pData;
         }
     }
@@ -227,8 +233,9 @@ IPoolDataPtr MemoryPool::allocate(const std::size_t size)
     }
 
     // Allocate a new buffer in MemoryPool
-    TUTTLE_LOG_TRACE("[Memory Pool] allocate " << size << " bytes");
-    return new PoolData(*this, size);
+    const EPoolAllocator allocator = core().getPreferences().getPoolAllocator();
+    TUTTLE_LOG_TRACE("[Memory Pool] allocate " << size << " bytes (" << getPoolAllocatorName(allocator) << ")");
+    return new PoolData(*this, size, allocator, owner);
 }
 
 std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
@@ -238,35 +245,22 @@ std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
     return _memoryAuthorized;
 }
 
-namespace
-{
-
-std::size_t accumulateReservedSize(const std::size_t& sum, const IPoolData* pData)
-{
-    return sum + pData->reservedSize();
-}
-
-std::size_t accumulateWastedSize(const std::size_t& sum, const IPoolData* pData)
-{
-    return sum + (pData->reservedSize() - pData->size());
-}
-}
-
 std::size_t MemoryPool::getUsedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUsed.begin(), _dataUsed.end(), 0, &accumulateReservedSize);
+    return _usedMemorySize;
 }
 
 std::size_t MemoryPool::getAllocatedAndUnusedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUnused.begin(), _dataUnused.end(), 0, &accumulateReservedSize);
+    return _unusedMemorySize;
 }
 
 std::size_t MemoryPool::getAllocatedMemorySize() const
 {
-    return getUsedMemorySize() + getAllocatedAndUnusedMemorySize();
+    boost::mutex::scoped_lock locker(_mutex);
+    return _usedMemorySize + _unusedMemorySize;
 }
 
 std::size_t MemoryPool::getMaxMemorySize() const
@@ -282,7 +276,19 @@ std::size_t MemoryPool::getAvailableMemorySize() const
 std::size_t MemoryPool::getWastedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUsed.begin(), _dataUsed.end(), 0, std::ptr_fun(&accumulateWastedSize));
+    return _wastedMemorySize;
+}
+
+std::size_t MemoryPool::getAllocatorMemorySize(const EPoolAllocator allocator) const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _allocatorMemorySize[allocator];
+}
+
+std::size_t MemoryPool::getAllocatorDataSize(const EPoolAllocator allocator) const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _allocatorDataSize[allocator];
 }
 
 std::size_t MemoryPool::getDataUsedSize() const
@@ -295,10 +301,92 @@ std::size_t MemoryPool::getDataUnusedSize() const
     return _dataUnused.size();
 }
 
-PoolData* MemoryPool::getOneAvailableData(const size_t size)
+PoolData* MemoryPool::getOneAvailableData(const size_t size, const BufferOwner& owner)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    // the smallest buffer big enough
+    DataBySize::iterator it = _dataUnused.lower_bound(std::make_pair(size, std::size_t(0)));
+    // Do not reuse too big buffers
+    if(it == _dataUnused.end() || it->first.first > maxBufferRatio * size)
+        return NULL;
+
+    PoolData* pData = it->second;
+    // Mark it as used right now, so that another thread can't get the same buffer
+    // before the caller takes a reference on it.
+    _dataUnused.erase(it);
+    _unusedMemorySize -= pData->reservedSize();
+    pData->setSize(size);
+    pData->setOwner(owner);
+    markUsed(pData);
+    return pData;
+}
+
+void MemoryPool::markUsed(PoolData* pData)
+{
+    _dataUsed.insert(pData);
+    pData->_usedGeneration = ++_generation;
+    _usedMemorySize += pData->reservedSize();
+    _wastedMemorySize += pData->reservedSize() - pData->size();
+    _peakAllocatedMemorySize = std::max(_peakAllocatedMemorySize, _usedMemorySize + _unusedMemorySize);
+    if(_usedMemorySize > _peakUsedMemorySize)
+        markPeak();
+}
+
+/**
+ * @brief Only record the generation of the peak, the datas used at the peak are listed by getPeakBuffers.
+ */
+void MemoryPool::markPeak()
+{
+    _peakUsedMemorySize = _usedMemorySize;
+    _peakGeneration = _generation;
+    _peakReleasedBuffers.clear();
+}
+
+std::vector<BufferUsage> MemoryPool::usedBuffers(const std::size_t maxGeneration) const
+{
+    std::vector<BufferUsage> buffers;
+    buffers.reserve(_dataUsed.size());
+    for(DataList::const_iterator it = _dataUsed.begin(); it != _dataUsed.end(); ++it)
+        if((*it)->_usedGeneration <= maxGeneration)
+            buffers.push_back(BufferUsage((*it)->getOwner(), (*it)->reservedSize()));
+    return buffers;
+}
+
+std::size_t MemoryPool::getPeakUsedMemorySize() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _peakUsedMemorySize;
+}
+
+std::size_t MemoryPool::getPeakAllocatedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::for_each(_dataUnused.begin(), _dataUnused.end(), DataFitSize(size)).bestMatch();
+    return _peakAllocatedMemorySize;
+}
+
+/**
+ * @brief The datas used at the peak are the ones released since the peak and the ones still used since before the
+ * peak.
+ */
+std::vector<BufferUsage> MemoryPool::getPeakBuffers() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    std::vector<BufferUsage> buffers = usedBuffers(_peakGeneration);
+    buffers.insert(buffers.end(), _peakReleasedBuffers.begin(), _peakReleasedBuffers.end());
+    return buffers;
+}
+
+void MemoryPool::resetPeak()
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _peakAllocatedMemorySize = _usedMemorySize + _unusedMemorySize;
+    markPeak();
+}
+
+std::vector<BufferUsage> MemoryPool::getUsedBuffers() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return usedBuffers(_generation);
 }
 
 void MemoryPool::clear(std::size_t size)
@@ -309,13 +397,27 @@ void MemoryPool::clear(std::size_t size)
 void MemoryPool::clear()
 {
     boost::mutex::scoped_lock locker(_mutex);
-    _dataUnused.clear();
+    while(!_dataUnused.empty())
+        freeUnused(_dataUnused.begin());
 }
 
 void MemoryPool::clearOne()
 {
     boost::mutex::scoped_lock locker(_mutex);
-    _dataUnused.erase(_dataUnused.begin());
+    if(_dataUnused.empty())
+        return;
+    freeUnused(_dataUnused.begin());
+}
+
+void MemoryPool::freeUnused(const DataBySize::iterator it)
+{
+    PoolData* pData = it->second;
+    _dataUnused.erase(it);
+    _unusedMemorySize -= pData->reservedSize();
+    _allocatorMemorySize[pData->allocator()] -= pData->reservedSize();
+    --_allocatorDataSize[pData->allocator()];
+    _dataMap.erase(pData->data());
+    _allDatas.erase(pData->_id); // give the memory back to the OS
 }
 
 std::ostream& operator<<(std::ostream& os, const MemoryPool& memoryPool)
@@ -329,6 +431,22 @@ std::ostream& operator<<(std::ostream& os, const MemoryPool& memoryPool)
     os << "[Memory Pool] Max memory:            " << memoryPool.getMaxMemorySize() << " bytes\n";
     os << "[Memory Pool] Available memory size: " << memoryPool.getAvailableMemorySize() << " bytes\n";
     os << "[Memory Pool] Wasted memory:         " << memoryPool.getWastedMemorySize() << " bytes\n";
+    os << "[Memory Pool] Peak used memory:      " << memoryPool.getPeakUsedMemorySize() << " bytes\n";
+    os << "[Memory Pool] Peak allocated memory: " << memoryPool.getPeakAllocatedMemorySize() << " bytes\n";
+    for(int i = 0; i < ePoolAllocatorCount; ++i)
+    {
+        const EPoolAllocator allocator = static_cast<EPoolAllocator>(i);
+        if(memoryPool.getAllocatorDataSize(allocator) == 0)
+            continue;
+        os << "[Memory Pool] Allocator " << getPoolAllocatorName(allocator) << ": "
+           << memoryPool.getAllocatorDataSize(allocator) << " datas, " << memoryPool.getAllocatorMemorySize(allocator)
+           << " bytes\n";
+    }
+    BOOST_FOREACH(const BufferUsage& buffer, memoryPool.getUsedBuffers())
+    {
+        os << "[Memory Pool] Used buffer: " << buffer._size << " bytes, node:" << buffer._owner._node
+           << " clip:" << buffer._owner._clip << " time:" << buffer._owner._time << "\n";
+    }
     return os;
 }
 }
@@ -2,13 +2,15 @@
 #define _TUTTLE_HOST_CORE_MEMORYPOOL_HPP_
 
 #include "IMemoryPool.hpp"
+#include "PoolAllocator.hpp"
 
-#include <boost/ptr_container/ptr_list.hpp>
+#include <boost/ptr_container/ptr_map.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/thread.hpp>
 
 #include <map>
 #include <list>
+#include <utility>
 #include <sstream>
 #include <numeric>
 #include <functional>
@@ -42,7 +44,7 @@ public:
     MemoryPool(const std::size_t maxSize = 0);
     ~MemoryPool();
 
-    IPoolDataPtr allocate(const std::size_t size);
+    IPoolDataPtr allocate(const std::size_t size, const BufferOwner& owner = BufferOwner());
     std::size_t updateMemoryAuthorizedWithRAM();
 
     void referenced(PoolData*);
@@ -55,10 +57,21 @@ public:
     std::size_t getAvailableMemorySize() const;
     std::size_t getWastedMemorySize() const;
 
+    /// Memory allocated with this backing, used or not
+    std::size_t getAllocatorMemorySize(const EPoolAllocator allocator) const;
+    /// Number of datas allocated with this backing, used or not
+    std::size_t getAllocatorDataSize(const EPoolAllocator allocator) const;
+
     std::size_t getDataUsedSize() const;
     std::size_t getDataUnusedSize() const;
 
-    PoolData* getOneAvailableData(const size_t size);
+    std::size_t getPeakUsedMemorySize() const;
+    std::size_t getPeakAllocatedMemorySize() const;
+    std::vector<BufferUsage> getPeakBuffers() const;
+    void resetPeak();
+    std::vector<BufferUsage> getUsedBuffers() const;
+
+    PoolData* getOneAvailableData(const size_t size, const BufferOwner& owner = BufferOwner());
 
     void clear(std::size_t size);
     void clear();
@@ -68,11 +81,31 @@ public:
 
 private:
     typedef boost::unordered_set<PoolData*> DataList;
-    boost::ptr_list<PoolData> _allDatas; // the owner
+    /// Unused datas sorted by reserved size (and unique id), to find the best fit in O(log n)
+    typedef std::map<std::pair<std::size_t, std::size_t>, PoolData*> DataBySize;
+
+    static DataBySize::key_type sizeKey(const PoolData* pData);
+    void freeUnused(const DataBySize::iterator it);
+    void markUsed(PoolData* pData);
+    void markPeak();
+    /// Used datas marked used up to this generation
+    std::vector<BufferUsage> usedBuffers(const std::size_t maxGeneration) const;
+
+    boost::ptr_map<std::size_t, PoolData> _allDatas; ///< the owner, indexed by the unique id of the datas
     std::map<char*, PoolData*> _dataMap;
     DataList _dataUsed;
-    DataList _dataUnused;
+    DataBySize _dataUnused;
+    std::size_t _usedMemorySize;   ///< sum of reserved sizes of used datas
+    std::size_t _unusedMemorySize; ///< sum of reserved sizes of unused datas
+    std::size_t _wastedMemorySize; ///< sum of reserved but not requested sizes of used datas
+    std::size_t _allocatorMemorySize[ePoolAllocatorCount];
+    std::size_t _allocatorDataSize[ePoolAllocatorCount];
     std::size_t _memoryAuthorized;
+    std::size_t _peakUsedMemorySize;
+    std::size_t _peakAllocatedMemorySize;
+    std::size_t _generation;     ///< incremented each time a data is marked used or released
+    std::size_t _peakGeneration; ///< generation at the peak of used memory
+    std::vector<BufferUsage> _peakReleasedBuffers; ///< datas used at the peak and released since
     mutable boost::mutex _mutex;
 };
 
@@ -0,0 +1,171 @@
+#include "PoolAllocator.hpp"
+
+#include <tuttle/common/system/system.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/throw_exception.hpp>
+
+#include <new>
+#include <cstdlib>
+
+#if defined(__WINDOWS__)
+#include <malloc.h>
+#elif defined(__UNIX__)
+#include <sys/mman.h>
+#endif
+
+#if defined(__LINUX__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+namespace
+{
+
+#if defined(__LINUX__)
+/// Smaller buffers can't use huge pages
+const std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+// from <numaif.h>, to avoid the dependency to libnuma
+const int kMpolInterleave = 3;
+const int kMpolLocal = 4;
+
+char* mapMemory(const std::size_t size)
+{
+    void* data = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(data == MAP_FAILED)
+        return NULL;
+    return static_cast<char*>(data);
+}
+
+bool bindMemory(char* data, const std::size_t size, const int mode)
+{
+#ifdef SYS_mbind
+    // all nodes, the kernel keeps the ones allowed for this process
+    const unsigned long nodeMask = ~0UL;
+    const unsigned long maxNode = (mode == kMpolLocal) ? 0 : sizeof(nodeMask) * 8;
+    return ::syscall(SYS_mbind, data, size, mode, (mode == kMpolLocal) ? NULL : &nodeMask, maxNode, 0) == 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+char* allocateAligned(const std::size_t size)
+{
+#if defined(__WINDOWS__)
+    return static_cast<char*>(_aligned_malloc(size, kPoolAlignment));
+#else
+    void* data = NULL;
+    if(::posix_memalign(&data, kPoolAlignment, size) != 0)
+        return NULL;
+    return static_cast<char*>(data);
+#endif
+}
+
+void deallocateAligned(char* data)
+{
+#if defined(__WINDOWS__)
+    _aligned_free(data);
+#else
+    std::free(data);
+#endif
+}
+}
+
+const char* getPoolAllocatorName(const EPoolAllocator allocator)
+{
+    switch(allocator)
+    {
+        case ePoolAllocatorDefault:
+            return "default";
+        case ePoolAllocatorAligned:
+            return "aligned";
+        case ePoolAllocatorHugePage:
+            return "huge pages";
+        case ePoolAllocatorNumaInterleave:
+            return "NUMA interleave";
+        case ePoolAllocatorNumaLocal:
+            return "NUMA local";
+        case ePoolAllocatorCount:
+            break;
+    }
+    return "unknown";
+}
+
+char* poolAllocate(EPoolAllocator& allocator, const std::size_t size)
+{
+    char* data = NULL;
+#if defined(__LINUX__)
+    switch(allocator)
+    {
+        case ePoolAllocatorHugePage:
+        {
+            if(size < kHugePageSize)
+                break;
+            data = mapMemory(size);
+#ifdef MADV_HUGEPAGE
+            if(data != NULL && ::madvise(data, size, MADV_HUGEPAGE) != 0)
+                TUTTLE_LOG_DEBUG("[Memory Pool] Transparent huge pages unavailable for " << size << " bytes");
+#endif
+            break;
+        }
+        case ePoolAllocatorNumaInterleave:
+        case ePoolAllocatorNumaLocal:
+        {
+            data = mapMemory(size);
+            if(data != NULL &&
+               !bindMemory(data, size, allocator == ePoolAllocatorNumaInterleave ? kMpolInterleave : kMpolLocal))
+                TUTTLE_LOG_DEBUG("[Memory Pool] Can't set the NUMA policy of " << size << " bytes");
+            break;
+        }
+        default:
+            break;
+    }
+    if(data != NULL)
+        return data;
+#endif
+
+    if(allocator != ePoolAllocatorDefault)
+    {
+        // the fallback of all specialized allocators
+        allocator = ePoolAllocatorAligned;
+        data = allocateAligned(size);
+        if(data == NULL)
+            BOOST_THROW_EXCEPTION(std::bad_alloc());
+        return data;
+    }
+    return new char[size];
+}
+
+void poolDeallocate(const EPoolAllocator allocator, char* data, const std::size_t size)
+{
+    switch(allocator)
+    {
+        case ePoolAllocatorDefault:
+            delete[] data;
+            return;
+        case ePoolAllocatorAligned:
+            deallocateAligned(data);
+            return;
+        case ePoolAllocatorHugePage:
+        case ePoolAllocatorNumaInterleave:
+        case ePoolAllocatorNumaLocal:
+#if defined(__UNIX__)
+            ::munmap(data, size);
+#endif
+            return;
+        case ePoolAllocatorCount:
+            break;
+    }
+}
+}
+}
+}
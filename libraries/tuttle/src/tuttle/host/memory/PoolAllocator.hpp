@@ -0,0 +1,47 @@
+#ifndef _TUTTLE_HOST_CORE_POOLALLOCATOR_HPP_
+#define _TUTTLE_HOST_CORE_POOLALLOCATOR_HPP_
+
+#include <cstddef>
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+/**
+ * @brief Backing memory of the buffers allocated by the MemoryPool.
+ */
+enum EPoolAllocator
+{
+    ePoolAllocatorDefault = 0,    ///< operator new
+    ePoolAllocatorAligned,        ///< aligned on kPoolAlignment bytes, for SIMD
+    ePoolAllocatorHugePage,       ///< mmap with transparent huge pages (Linux only, aligned otherwise)
+    ePoolAllocatorNumaInterleave, ///< pages interleaved on all NUMA nodes (Linux only, aligned otherwise)
+    ePoolAllocatorNumaLocal,      ///< pages on the NUMA node of the first thread writing them (Linux only, aligned otherwise)
+    ePoolAllocatorCount
+};
+
+#ifndef SWIG
+/// Alignment of ePoolAllocatorAligned buffers
+static const std::size_t kPoolAlignment = 64;
+
+const char* getPoolAllocatorName(const EPoolAllocator allocator);
+
+/**
+ * @brief Allocate @p size bytes with the @p allocator backing.
+ * @param[in,out] allocator the requested backing, modified if another one is used as fallback.
+ */
+char* poolAllocate(EPoolAllocator& allocator, const std::size_t size);
+
+/**
+ * @brief Free a buffer allocated with poolAllocate().
+ */
+void poolDeallocate(const EPoolAllocator allocator, char* data, const std::size_t size);
+#endif
+}
+}
+}
+
+#endif
@@ -151,6 +151,14 @@ bool OfxhImageEffectNodeBase::supportsTiles() const
     return _properties.getIntProperty(kOfxImageEffectPropSupportsTiles) != 0;
 }
 
+/// is each output pixel only computed from the source pixel at the same position
+bool OfxhImageEffectNodeBase::isPointwise() const
+{
+    // tuttle extension, absent from the descriptors of an older plugin cache
+    return _properties.hasProperty(kTuttleOfxImageEffectPropPointwise) &&
+           _properties.getIntProperty(kTuttleOfxImageEffectPropPointwise) != 0;
+}
+
 /// does this effect need random temporal access
 
 bool OfxhImageEffectNodeBase::temporalAccess() const
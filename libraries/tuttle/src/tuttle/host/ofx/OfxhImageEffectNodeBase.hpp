@@ -94,6 +94,9 @@ public:
     /// does the effect support tiled rendering
     bool supportsTiles() const;
 
+    /// is each output pixel only computed from the source pixel at the same position
+    bool isPointwise() const;
+
     /// does this effect need random temporal access
     bool temporalAccess() const;
 
@@ -1,10 +1,10 @@
 #include "OfxhMultiThreadSuite.hpp"
 #include "OfxhCore.hpp"
 
-#include <boost/thread/thread.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/ThreadPool.hpp>
+
 #include <boost/thread/recursive_mutex.hpp>
-#include <boost/thread/tss.hpp>
-#include <boost/bind.hpp>
 
 struct OfxMutex
 {
@@ -21,69 +21,34 @@ namespace ofx
 namespace
 {
 
-struct ThreadSpecificData
-{
-    ThreadSpecificData(unsigned int threadIndex)
-        : _index(0)
-    {
-    }
-    unsigned int _index;
-};
-
-boost::thread_specific_ptr<ThreadSpecificData> ptr;
-
-void launchThread(OfxThreadFunctionV1 func, unsigned int threadIndex, unsigned int threadMax, void* customArg)
-{
-    ptr.reset(new ThreadSpecificData(threadIndex));
-    func(threadIndex, threadMax, customArg);
-}
-
 OfxStatus multiThread(OfxThreadFunctionV1 func, const unsigned int nThreads, void* customArg)
 {
     if(nThreads == 0)
     {
         return kOfxStatErrValue;
     }
-    else if(nThreads == 1)
-    {
-        func(0, 1, customArg);
-    }
-    else
-    {
-        boost::thread_group group;
-        for(unsigned int i = 0; i < nThreads; ++i)
-        {
-            group.create_thread(boost::bind(launchThread, func, i, nThreads, customArg));
-        }
-        group.join_all();
-    }
+    core().getThreadPool().run(func, nThreads, customArg);
     return kOfxStatOK;
 }
 
 OfxStatus multiThreadNumCPUs(unsigned int* const nCPUs)
 {
-    //	*nCPUs = 1; /// @todo tuttle: needs to have an option to disable multithreading (force only one cpu).
-    *nCPUs = boost::thread::hardware_concurrency();
+    *nCPUs = core().getThreadPool().getNbThreads();
     TUTTLE_LOG_INFO("[Multi thread] CPUs used: " << *nCPUs);
     return kOfxStatOK;
 }
 
 OfxStatus multiThreadIndex(unsigned int* const threadIndex)
 {
-    //	*threadIndex = boost::this_thread::get_id(); //	we don't want a global thead id, but the thead index inside a node
-    // multithread process.
-    if(ptr.get() != NULL)
-    {
-        *threadIndex = 0;
+    // we don't want a global thread id, but the thread index inside a node multithread process.
+    if(!ThreadPool::getTaskIndex(*threadIndex))
         return kOfxStatFailed;
-    }
-    *threadIndex = ptr->_index;
     return kOfxStatOK;
 }
 
 int multiThreadIsSpawnedThread(void)
 {
-    return ptr.get() != NULL;
+    return ThreadPool::isInTask();
 }
 
 /**
@@ -3,6 +3,12 @@
 #include <boost/functional/hash.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
 namespace tuttle
 {
 namespace host
@@ -59,6 +65,52 @@ void OfxhParamString::setV(const OfxTime time, va_list arg, const EChange change
     this->setValueAtTime(time, value, change);
 }
 
+std::string OfxhParamString::getFilePathAtTime(const OfxTime time) const
+{
+    std::string filepath;
+    getValueAtTime(time, filepath);
+    const long frame = static_cast<long>(std::floor(time));
+
+    // padded sequence pattern: "image.####.exr"
+    const std::size_t patternEnd = filepath.find_last_of('#');
+    if(patternEnd != std::string::npos)
+    {
+        const std::size_t patternBegin = filepath.find_last_not_of('#', patternEnd) + 1;
+        std::ostringstream frameStr;
+        frameStr << std::setw(patternEnd - patternBegin + 1) << std::setfill('0') << frame;
+        return filepath.replace(patternBegin, patternEnd - patternBegin + 1, frameStr.str());
+    }
+
+    // printf sequence pattern: "image.%04d.exr"
+    const std::size_t formatBegin = filepath.find_last_of('%');
+    if(formatBegin != std::string::npos)
+    {
+        std::size_t formatEnd = formatBegin + 1;
+        while(formatEnd < filepath.size() && std::isdigit(static_cast<unsigned char>(filepath[formatEnd])))
+            ++formatEnd;
+        if(formatEnd < filepath.size() && filepath[formatEnd] == 'd' && formatEnd - formatBegin <= 3)
+        {
+            char frameStr[128];
+            const std::string format = filepath.substr(formatBegin, formatEnd - formatBegin) + "ld";
+            std::sprintf(frameStr, format.c_str(), frame);
+            return filepath.replace(formatBegin, formatEnd - formatBegin + 1, frameStr);
+        }
+    }
+    return filepath;
+}
+
+bool OfxhParamString::hasFileIdentityAtTime(const OfxTime time) const
+{
+    if(getStringMode() != kOfxParamStringIsFilePath)
+        return true;
+    std::string value;
+    getValueAtTime(time, value);
+    if(value.empty())
+        return true;
+    boost::system::error_code error;
+    return boost::filesystem::is_regular_file(getFilePathAtTime(time), error);
+}
+
 std::size_t OfxhParamString::getHashAtTime(const OfxTime time) const
 {
     std::string value;
@@ -66,9 +118,13 @@ std::size_t OfxhParamString::getHashAtTime(const OfxTime time) const
     std::size_t seed = boost::hash_value(value);
     if(getStringMode() == kOfxParamStringIsFilePath)
     {
-        if(boost::filesystem::exists(value))
+        // the file may be modified at the same path
+        const std::string filepath = getFilePathAtTime(time);
+        boost::system::error_code error;
+        if(boost::filesystem::is_regular_file(filepath, error))
         {
-            boost::hash_combine(seed, boost::filesystem::last_write_time(value));
+            boost::hash_combine(seed, boost::filesystem::last_write_time(filepath, error));
+            boost::hash_combine(seed, boost::filesystem::file_size(filepath, error));
         }
     }
     return seed;
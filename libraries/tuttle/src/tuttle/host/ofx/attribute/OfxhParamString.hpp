@@ -51,6 +51,18 @@ public:
 
     std::size_t getHashAtTime(const OfxTime time) const;
 
+    /**
+     * @brief Value of a file path param at @p time, with the frame number in place of a sequence pattern
+     * ("####" padded to the number of '#', or "%04d"). Other patterns are kept unchanged.
+     */
+    std::string getFilePathAtTime(const OfxTime time) const;
+
+    /**
+     * @brief A file path param names an existing file at @p time, so its hash includes the last write time
+     * and the size of the file. Always true for the other string params and for empty file paths.
+     */
+    bool hasFileIdentityAtTime(const OfxTime time) const;
+
     std::ostream& displayValues(std::ostream& os) const
     {
         os << getStringValue();
@@ -17,6 +17,7 @@
 #include <boost/exception/error_info.hpp>
 #include <boost/throw_exception.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -42,6 +43,15 @@ protected:
 
 private:
     unsigned int _nbThreads;
+    OfxPointI _tileSize;       ///< requested tile size
+    OfxPointI _renderTileSize; ///< tile size used by the current render, 0 to slice into bands
+    OfxPointI _nbTiles;
+    int _nextTile;
+    OFX::MultiThread::Mutex _tileMutex;
+
+public:
+    /// Size of the destination data of a tile with setTileSizeAuto(), to fit in a core's cache
+    static const std::size_t kTileCacheBytes = 256 * 1024;
 
 public:
     /** @brief ctor */
@@ -50,7 +60,11 @@ public:
         , _effect(effect)
         , _imageOrientation(imageOrientation)
         , _nbThreads(0) // auto, maximum allowable number of CPUs will be used
+        , _nextTile(0)
     {
+        _tileSize.x = _tileSize.y = 0;
+        _renderTileSize.x = _renderTileSize.y = 0;
+        _nbTiles.x = _nbTiles.y = 0;
         _dstPixelRod.x1 = _dstPixelRod.y1 = _dstPixelRod.x2 = _dstPixelRod.y2 = 0;
         _dstPixelRodSize.x = _dstPixelRodSize.y = 0;
         _renderWindowSize.x = _renderWindowSize.y = 0;
@@ -69,6 +83,25 @@ public:
     void setNbThreads(const unsigned int nbThreads) { _nbThreads = nbThreads; }
     void setNbThreadsAuto() { _nbThreads = 0; }
 
+    /**
+     * @brief Process the render window in tiles of this size, each thread taking the next tile until
+     * all are done. Useful when the cost of a pixel is not uniform across the image.
+     * Set 0 to slice the render window into one band per thread (default).
+     */
+    void setTileSize(const int tileWidth, const int tileHeight)
+    {
+        _tileSize.x = tileWidth;
+        _tileSize.y = tileHeight;
+    }
+    /** @brief Process in tiles sized for the destination data to fit in a core's cache */
+    void setTileSizeAuto() { setTileSize(-1, -1); }
+
+    /**
+     * @brief Tile size used to render, override in derived classes to choose it from the render arguments.
+     * A negative size means auto, 0 means no tiles.
+     */
+    virtual OfxPointI getTileSize() const { return _tileSize; }
+
     /** @brief called before any MP is done */
     virtual void preProcess() { progressBegin(_renderWindowSize.y * _renderWindowSize.x); }
 
@@ -144,6 +177,16 @@ public:
      */
     void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
     {
+        if(_renderTileSize.x > 0)
+        {
+            OfxRectI tile;
+            while(nextTile(tile))
+            {
+                multiThreadProcessImages(tile);
+            }
+            return;
+        }
+
         // slice the y range into the number of threads it has
         const int dy = std::abs(_renderArgs.renderWindow.y2 - _renderArgs.renderWindow.y1);
         const int y1 = _renderArgs.renderWindow.y1 + threadId * dy / nThreads;
@@ -179,12 +222,66 @@ public:
         // call the pre MP pass
         preProcess();
 
+        setupTiles();
+
         // call the base multi threading code, should put a pre & post thread calls in too
         multiThread(_nbThreads);
 
         // call the post MP pass
         postProcess();
     }
+
+private:
+    void setupTiles()
+    {
+        _renderTileSize = getTileSize();
+        if(_renderTileSize.x == 0 || _renderTileSize.y == 0)
+        {
+            _renderTileSize.x = _renderTileSize.y = 0;
+            return;
+        }
+        _nextTile = 0;
+        if(_renderWindowSize.x <= 0 || _renderWindowSize.y <= 0)
+        {
+            // nothing to render, no tile to take
+            _renderTileSize.x = _renderTileSize.y = 1;
+            _nbTiles.x = _nbTiles.y = 0;
+            return;
+        }
+        if(_renderTileSize.x < 0 || _renderTileSize.y < 0)
+        {
+            _renderTileSize.x = std::min(_renderWindowSize.x, 256);
+            std::size_t pixelBytes = _dst.get() ? _dst->getPixelBytes() : 0;
+            if(pixelBytes == 0)
+                pixelBytes = 16; // unknown, assume RGBA float
+            const std::size_t rowBytes = _renderTileSize.x * pixelBytes;
+            _renderTileSize.y = static_cast<int>(std::max(kTileCacheBytes / rowBytes, std::size_t(1)));
+        }
+        _nbTiles.x = (_renderWindowSize.x + _renderTileSize.x - 1) / _renderTileSize.x;
+        _nbTiles.y = (_renderWindowSize.y + _renderTileSize.y - 1) / _renderTileSize.y;
+    }
+
+    /** @brief Take the next tile to process, in render window coordinates */
+    bool nextTile(OfxRectI& tile)
+    {
+        int index;
+        {
+            OFX::MultiThread::AutoMutex locker(_tileMutex);
+            if(_nextTile >= _nbTiles.x * _nbTiles.y)
+                return false;
+            index = _nextTile++;
+        }
+        // if the host is trying to abort the rendering, stop taking tiles
+        if(_effect.abort())
+            return false;
+
+        const OfxRectI& window = _renderArgs.renderWindow;
+        tile.x1 = window.x1 + (index % _nbTiles.x) * _renderTileSize.x;
+        tile.y1 = window.y1 + (index / _nbTiles.x) * _renderTileSize.y;
+        tile.x2 = std::min(tile.x1 + _renderTileSize.x, window.x2);
+        tile.y2 = std::min(tile.y1 + _renderTileSize.y, window.y2);
+        return true;
+    }
 };
 }
 }
@@ -0,0 +1,89 @@
+#ifndef _TUTTLE_PLUGIN_REDUCEPROCESSOR_HPP_
+#define _TUTTLE_PLUGIN_REDUCEPROCESSOR_HPP_
+
+#include "IProgress.hpp"
+
+#include <terry/algorithm/reduce.hpp>
+
+#include <ofxsMultiThread.h>
+
+#include <cstddef>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+/**
+ * @brief Reduce the bands of a terry::algorithm::band_reduction with the threads of the host.
+ * If a progress is given, it moves forward of stepsPerRow per reduced row, and a thread stops at the abort.
+ */
+template <class RowReducer>
+class ReduceProcessor : public OFX::MultiThread::Processor
+{
+public:
+    typedef terry::algorithm::band_reduction<RowReducer> Reduction;
+
+    explicit ReduceProcessor(Reduction& reduction, IProgress* progress = NULL, const int stepsPerRow = 1)
+        : _reduction(reduction)
+        , _progress(progress)
+        , _stepsPerRow(stepsPerRow)
+    {
+    }
+
+    void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
+    {
+        for(std::size_t band = threadId; band < _reduction.nbBands(); band += nThreads)
+        {
+            _reduction.reduceBand(band);
+            if(_progress && _progress->progressForward(_reduction.nbBandRows(band) * _stepsPerRow))
+                return;
+        }
+    }
+
+private:
+    Reduction& _reduction;
+    IProgress* _progress;
+    int _stepsPerRow;
+};
+
+/**
+ * @brief Reduce the rows [y1, y2) with the threads of the host.
+ * The result doesn't depend on the number of threads.
+ */
+template <class RowReducer>
+RowReducer reduceRowsMultiThread(const RowReducer& init, const std::ptrdiff_t y1, const std::ptrdiff_t y2)
+{
+    typename ReduceProcessor<RowReducer>::Reduction reduction(init, y1, y2);
+    ReduceProcessor<RowReducer> processor(reduction);
+    processor.multiThread();
+    return reduction.result();
+}
+
+/**
+ * @brief Apply @p init to all the pixels of @p view with the threads of the host, like transform_pixels.
+ */
+template <class View, class PixelReducer>
+PixelReducer reducePixelsMultiThread(const View& view, const PixelReducer& init)
+{
+    return reduceRowsMultiThread(terry::algorithm::pixel_row_reducer<View, PixelReducer>(view, init), 0, view.height())
+        ._reducer;
+}
+
+/**
+ * @brief Same as reducePixelsMultiThread, moving @p progress forward of the width of the view per row.
+ * If the render is aborted, the remaining rows are not reduced.
+ */
+template <class View, class PixelReducer>
+PixelReducer reducePixelsMultiThread(const View& view, const PixelReducer& init, IProgress& progress)
+{
+    typedef terry::algorithm::pixel_row_reducer<View, PixelReducer> RowReducer;
+    typename ReduceProcessor<RowReducer>::Reduction reduction(RowReducer(view, init), 0, view.height());
+    ReduceProcessor<RowReducer> processor(reduction, &progress, view.width());
+    processor.multiThread();
+    return reduction.result()._reducer;
+}
+}
+}
+
+#endif
@@ -3,8 +3,27 @@
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/Node.hpp>
+#include <tuttle/host/Tracer.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
 
+#include <boost/make_shared.hpp>
+
+#include <cstring>
 #include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+std::size_t countOccurrences(const std::string& s, const std::string& pattern)
+{
+    std::size_t count = 0;
+    for(std::size_t pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + 1))
+        ++count;
+    return count;
+}
+}
 
 using namespace boost::unit_test;
 using namespace tuttle::host;
@@ -212,4 +231,122 @@ BOOST_AUTO_TEST_CASE(graph_compute)
     TUTTLE_LOG_INFO("----------------- DONE -----------------");
 }
 
+BOOST_AUTO_TEST_CASE(graph_compute_incremental_setup)
+{
+    Graph g;
+    Graph::Node& generator = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert1 = g.createNode("tuttle.invert");
+    Graph::Node& invert2 = g.createNode("tuttle.invert");
+    g.connect(generator, invert1);
+    g.connect(invert1, invert2);
+
+    // the graph at time is built for the first frame, then updated
+    boost::shared_ptr<Tracer> tracer = boost::make_shared<Tracer>();
+    memory::MemoryCache incrementalCache;
+    ComputeOptions incrementalOptions(0, 4);
+    incrementalOptions.setTracer(tracer);
+    BOOST_CHECK(g.compute(incrementalCache, invert2, incrementalOptions));
+
+    std::ostringstream os;
+    tracer->exportChromeTrace(os);
+    BOOST_CHECK_EQUAL(1U, countOccurrences(os.str(), "\"name\":\"buildGraphAtTime\""));
+    BOOST_CHECK_EQUAL(4U, countOccurrences(os.str(), "\"name\":\"updateGraphAtTime\""));
+
+    // same images as a graph at time rebuilt at each frame
+    memory::MemoryCache rebuiltCache;
+    ComputeOptions rebuiltOptions(0, 4);
+    rebuiltOptions.setIncrementalSetup(false);
+    BOOST_CHECK(g.compute(rebuiltCache, invert2, rebuiltOptions));
+
+    for(int time = 0; time <= 4; ++time)
+    {
+        const memory::CACHE_ELEMENT incremental = incrementalCache.get(invert2.getName(), time);
+        const memory::CACHE_ELEMENT rebuilt = rebuiltCache.get(invert2.getName(), time);
+        BOOST_REQUIRE(incremental.get() != NULL);
+        BOOST_REQUIRE(rebuilt.get() != NULL);
+        BOOST_REQUIRE_EQUAL(incremental->getMemorySize(), rebuilt->getMemorySize());
+        BOOST_CHECK(std::memcmp(incremental->getPixelData(), rebuilt->getPixelData(), rebuilt->getMemorySize()) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(graph_compute_incremental_setup_identity_change)
+{
+    Graph g;
+    Graph::Node& from = g.createNode("tuttle.checkerboard");
+    Graph::Node& to = g.createNode("tuttle.constant");
+    Graph::Node& fade = g.createNode("tuttle.fade");
+    Graph::Node& invert = g.createNode("tuttle.invert");
+    from.getParam("width").setValue(64);
+    from.getParam("height").setValue(48);
+    from.getParam("explicitConversion").setValue(3); // 32f
+    to.getParam("width").setValue(64);
+    to.getParam("height").setValue(48);
+    to.getParam("explicitConversion").setValue(3); // 32f
+    // identity to the first clip at the first frame, to the second clip at the last frame
+    fade.getParam("Transition").setValueAtTime(0, 0.0);
+    fade.getParam("Transition").setValueAtTime(4, 1.0);
+    g.connect(from, fade.getClip("SourceFrom"));
+    g.connect(to, fade.getClip("SourceTo"));
+    g.connect(fade, invert);
+
+    memory::MemoryCache incrementalCache;
+    ComputeOptions incrementalOptions(0, 4);
+    BOOST_CHECK(g.compute(incrementalCache, invert, incrementalOptions));
+
+    memory::MemoryCache rebuiltCache;
+    ComputeOptions rebuiltOptions(0, 4);
+    rebuiltOptions.setIncrementalSetup(false);
+    BOOST_CHECK(g.compute(rebuiltCache, invert, rebuiltOptions));
+
+    for(int time = 0; time <= 4; ++time)
+    {
+        const memory::CACHE_ELEMENT incremental = incrementalCache.get(invert.getName(), time);
+        const memory::CACHE_ELEMENT rebuilt = rebuiltCache.get(invert.getName(), time);
+        BOOST_REQUIRE(incremental.get() != NULL);
+        BOOST_REQUIRE(rebuilt.get() != NULL);
+        BOOST_REQUIRE_EQUAL(incremental->getMemorySize(), rebuilt->getMemorySize());
+        BOOST_CHECK(std::memcmp(incremental->getPixelData(), rebuilt->getPixelData(), rebuilt->getMemorySize()) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(graph_compute_fuse_pointwise_nodes)
+{
+    Graph g;
+    Graph::Node& generator = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert1 = g.createNode("tuttle.invert");
+    Graph::Node& gamma = g.createNode("tuttle.gamma");
+    Graph::Node& invert2 = g.createNode("tuttle.invert");
+    gamma.getParam("master").setValue(2.2);
+    g.connect(generator, invert1);
+    g.connect(invert1, gamma);
+    g.connect(gamma, invert2);
+
+    // the three pointwise nodes are rendered in the same buffer
+    boost::shared_ptr<Tracer> tracer = boost::make_shared<Tracer>();
+    memory::MemoryCache fusedCache;
+    ComputeOptions fusedOptions(0, 2);
+    fusedOptions.setFusePointwiseNodes(true);
+    fusedOptions.setTracer(tracer);
+    BOOST_CHECK(g.compute(fusedCache, invert2, fusedOptions));
+
+    std::ostringstream os;
+    tracer->exportChromeTrace(os);
+    BOOST_CHECK_EQUAL(3U, countOccurrences(os.str(), "\"name\":\"processFusedChain\""));
+
+    // same images as the nodes rendered one by one
+    memory::MemoryCache separateCache;
+    ComputeOptions separateOptions(0, 2);
+    BOOST_CHECK(g.compute(separateCache, invert2, separateOptions));
+
+    for(int time = 0; time <= 2; ++time)
+    {
+        const memory::CACHE_ELEMENT fused = fusedCache.get(invert2.getName(), time);
+        const memory::CACHE_ELEMENT separate = separateCache.get(invert2.getName(), time);
+        BOOST_REQUIRE(fused.get() != NULL);
+        BOOST_REQUIRE(separate.get() != NULL);
+        BOOST_REQUIRE_EQUAL(fused->getMemorySize(), separate->getMemorySize());
+        BOOST_CHECK(std::memcmp(fused->getPixelData(), separate->getPixelData(), separate->getMemorySize()) == 0);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
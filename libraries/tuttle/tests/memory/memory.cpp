@@ -2,10 +2,19 @@
 #include <tuttle/test/main.hpp>
 
 // custom host
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/MemoryReport.hpp>
 #include <tuttle/host/memory/MemoryPool.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 using namespace boost::unit_test;
 using namespace std;
@@ -107,6 +116,123 @@ BOOST_AUTO_TEST_CASE(memoryPool)
     }
 }
 
+BOOST_AUTO_TEST_CASE(memoryPool_peak)
+{
+    memory::MemoryPool pool(100);
+    {
+        const memory::IPoolDataPtr a = pool.allocate(10, memory::BufferOwner("read", "Output", 1));
+        const memory::IPoolDataPtr b = pool.allocate(20, memory::BufferOwner("blur", "Output", 1));
+        BOOST_CHECK_EQUAL(2U, pool.getUsedBuffers().size());
+    }
+    BOOST_CHECK_EQUAL(0U, pool.getUsedMemorySize());
+    BOOST_CHECK_EQUAL(30U, pool.getPeakUsedMemorySize());
+    BOOST_CHECK_EQUAL(30U, pool.getPeakAllocatedMemorySize());
+
+    // the owners of the buffers at the peak
+    const std::vector<memory::BufferUsage> peakBuffers = pool.getPeakBuffers();
+    BOOST_REQUIRE_EQUAL(2U, peakBuffers.size());
+    std::size_t peakSize = 0;
+    BOOST_FOREACH(const memory::BufferUsage& buffer, peakBuffers)
+    {
+        BOOST_CHECK(buffer._owner._node == "read" || buffer._owner._node == "blur");
+        BOOST_CHECK_EQUAL("Output", buffer._owner._clip);
+        peakSize += buffer._size;
+    }
+    BOOST_CHECK_EQUAL(30U, peakSize);
+
+    // the peak restarts from the current usage, the unused buffers are still allocated
+    pool.resetPeak();
+    BOOST_CHECK_EQUAL(0U, pool.getPeakUsedMemorySize());
+    BOOST_CHECK_EQUAL(30U, pool.getPeakAllocatedMemorySize());
+    BOOST_CHECK(pool.getPeakBuffers().empty());
+    {
+        const memory::IPoolDataPtr c = pool.allocate(20);
+        BOOST_CHECK_EQUAL(20U, pool.getPeakUsedMemorySize());
+        BOOST_CHECK(pool.getPeakBuffers().front()._owner._node.empty());
+    }
+
+    // a buffer released after the peak and reused by another owner is listed with its owner at the peak
+    pool.resetPeak();
+    {
+        const memory::IPoolDataPtr d = pool.allocate(20, memory::BufferOwner("read", "Output", 2));
+        const memory::IPoolDataPtr e = pool.allocate(10, memory::BufferOwner("blur", "Output", 2));
+    }
+    {
+        const memory::IPoolDataPtr f = pool.allocate(20, memory::BufferOwner("write", "Output", 2));
+        const std::vector<memory::BufferUsage> reusedPeakBuffers = pool.getPeakBuffers();
+        BOOST_REQUIRE_EQUAL(2U, reusedPeakBuffers.size());
+        BOOST_FOREACH(const memory::BufferUsage& buffer, reusedPeakBuffers)
+            BOOST_CHECK(buffer._owner._node == "read" || buffer._owner._node == "blur");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(memoryPool_allocation_latency)
+{
+    const std::size_t nbAllocations = 10000;
+    for(std::size_t population = 10; population <= 10000; population *= 10)
+    {
+        memory::MemoryPool pool(population * 2048);
+        {
+            // fill the pool with unused buffers of different sizes
+            std::vector<memory::IPoolDataPtr> datas;
+            for(std::size_t i = 0; i < population; ++i)
+                datas.push_back(pool.allocate(1024 + i % 1024));
+        }
+        BOOST_CHECK_EQUAL(population, pool.getDataUnusedSize());
+
+        boost::posix_time::ptime t0 = boost::posix_time::microsec_clock::local_time();
+        for(std::size_t i = 0; i < nbAllocations; ++i)
+        {
+            const memory::IPoolDataPtr pData = pool.allocate(1024 + (i * 7) % (population < 1024 ? population : 1024));
+            pool.getUsedMemorySize();
+        }
+        boost::posix_time::ptime t1 = boost::posix_time::microsec_clock::local_time();
+
+        // all allocations reuse a buffer
+        BOOST_CHECK_EQUAL(population, pool.getDataUnusedSize());
+        TUTTLE_LOG_INFO("[Memory Pool] " << population << " buffers: "
+                                         << (t1 - t0).total_nanoseconds() / nbAllocations << " ns per allocation");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(memoryPool_allocators)
+{
+    const std::size_t size = 4 * 1024 * 1024;
+    memory::MemoryPool pool(size * memory::ePoolAllocatorCount);
+    Preferences& preferences = core().getPreferences();
+    const memory::EPoolAllocator defaultAllocator = preferences.getPoolAllocator();
+    {
+        std::vector<memory::IPoolDataPtr> datas;
+        for(int i = 0; i < memory::ePoolAllocatorCount; ++i)
+        {
+            const memory::EPoolAllocator allocator = static_cast<memory::EPoolAllocator>(i);
+            preferences.setPoolAllocator(allocator);
+            datas.push_back(pool.allocate(size));
+            char* data = datas.back()->data();
+            data[0] = data[size - 1] = 1;
+            if(allocator != memory::ePoolAllocatorDefault)
+                BOOST_CHECK_EQUAL(0U, reinterpret_cast<std::size_t>(data) % memory::kPoolAlignment);
+        }
+        BOOST_CHECK_EQUAL(size, pool.getAllocatorMemorySize(memory::ePoolAllocatorDefault));
+    }
+    preferences.setPoolAllocator(defaultAllocator);
+
+    // each buffer is counted once, with the backing really used
+    std::size_t nbDatas = 0;
+    std::size_t memorySize = 0;
+    for(int i = 0; i < memory::ePoolAllocatorCount; ++i)
+    {
+        nbDatas += pool.getAllocatorDataSize(static_cast<memory::EPoolAllocator>(i));
+        memorySize += pool.getAllocatorMemorySize(static_cast<memory::EPoolAllocator>(i));
+    }
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(memory::ePoolAllocatorCount), nbDatas);
+    BOOST_CHECK_EQUAL(pool.getAllocatedMemorySize(), memorySize);
+
+    pool.clear();
+    for(int i = 0; i < memory::ePoolAllocatorCount; ++i)
+        BOOST_CHECK_EQUAL(0U, pool.getAllocatorDataSize(static_cast<memory::EPoolAllocator>(i)));
+}
+
 BOOST_AUTO_TEST_CASE(memoryCache)
 {
     memory::MemoryCache cache;
@@ -151,4 +277,73 @@ BOOST_AUTO_TEST_CASE(memoryCache)
     BOOST_CHECK_EQUAL(true, cache.inCache(pData));
 }
 
+BOOST_AUTO_TEST_CASE(memoryCache_results)
+{
+    memory::MemoryCache cache;
+
+    // results are disabled by default
+    BOOST_CHECK_EQUAL(0U, cache.getMaxMemorySize());
+    BOOST_CHECK_EQUAL(memory::eMemoryCachePolicyLRU, cache.getPolicy());
+    BOOST_CHECK(cache.getResult(42).get() == NULL);
+    BOOST_CHECK_EQUAL(0U, cache.getMissCount());
+
+    cache.setMaxMemorySize(1024 * 1024);
+    cache.setPolicy(memory::eMemoryCachePolicyCostSize);
+    BOOST_CHECK_EQUAL(memory::eMemoryCachePolicyCostSize, cache.getPolicy());
+
+    // an empty element is not kept
+    cache.putResult(42, memory::CACHE_ELEMENT(), 1.0);
+    BOOST_CHECK_EQUAL(0U, cache.getResultsMemorySize());
+    BOOST_CHECK(cache.getResult(42).get() == NULL);
+    BOOST_CHECK_EQUAL(0U, cache.getHitCount());
+    BOOST_CHECK_EQUAL(1U, cache.getMissCount());
+
+    cache.resetCounters();
+    BOOST_CHECK_EQUAL(0U, cache.getMissCount());
+    BOOST_CHECK_EQUAL(0U, cache.getEvictionCount());
+}
+
+BOOST_AUTO_TEST_CASE(memoryReport_compute)
+{
+    Graph g;
+    Graph::Node& generator = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert = g.createNode("tuttle.invert");
+    g.connect(generator, invert);
+
+    boost::shared_ptr<MemoryReport> report = boost::make_shared<MemoryReport>();
+    memory::MemoryCache outputCache;
+    ComputeOptions options(0, 1);
+    options.setMemoryReport(report);
+    BOOST_CHECK(g.compute(outputCache, invert, options));
+
+    BOOST_REQUIRE_EQUAL(2U, report->getNbFrames());
+    for(std::size_t i = 0; i < report->getNbFrames(); ++i)
+    {
+        const FrameMemoryUsage frame = report->getFrame(i);
+        BOOST_CHECK_GT(frame._predictedPeak, 0U);
+        BOOST_CHECK_GT(frame._poolPeakUsed, 0U);
+        BOOST_CHECK_GE(frame._poolPeakAllocated, frame._poolPeakUsed);
+        BOOST_REQUIRE(!frame._peakBuffers.empty());
+        // the images of the generator and of the invert are both used at the peak
+        bool generatorOwner = false;
+        bool invertOwner = false;
+        BOOST_FOREACH(const memory::BufferUsage& buffer, frame._peakBuffers)
+        {
+            generatorOwner |= buffer._owner._node == generator.getName();
+            invertOwner |= buffer._owner._node == invert.getName();
+            if(buffer._owner._node == invert.getName())
+                BOOST_CHECK_EQUAL(frame._time, buffer._owner._time);
+        }
+        BOOST_CHECK(generatorOwner);
+        BOOST_CHECK(invertOwner);
+    }
+    BOOST_CHECK_GT(report->getPeakUsedMemorySize(), 0U);
+    BOOST_CHECK_THROW(report->getFrame(2), std::exception);
+
+    std::ostringstream os;
+    report->exportJson(os);
+    BOOST_CHECK(os.str().find("\"peakBuffers\"") != std::string::npos);
+    BOOST_CHECK(os.str().find(invert.getName()) != std::string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
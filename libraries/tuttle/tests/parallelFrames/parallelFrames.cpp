@@ -0,0 +1,63 @@
+#define BOOST_TEST_MODULE tuttle_parallelFrames
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <iostream>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+BOOST_AUTO_TEST_SUITE(parallelFrames_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(compute_parallel_frames)
+{
+    TUTTLE_LOG_INFO("--> PLUGINS CREATION");
+    Graph g;
+    Graph::Node& generator = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert1 = g.createNode("tuttle.invert");
+    Graph::Node& invert2 = g.createNode("tuttle.invert");
+
+    TUTTLE_LOG_INFO("-------- GRAPH CONNECTION --------");
+    g.connect(generator, invert1);
+    g.connect(invert1, invert2);
+
+    std::list<std::string> outputs;
+    outputs.push_back(invert2.getName());
+
+    TUTTLE_LOG_INFO("-------- GRAPH PROCESSING --------");
+    memory::MemoryCache outputCache;
+    ComputeOptions options(0, 9);
+    options.setNbParallelFrames(4);
+    BOOST_CHECK(g.compute(outputCache, outputs, options));
+
+    // one output buffer per frame, whatever the thread which has rendered it
+    BOOST_CHECK_EQUAL(10U, outputCache.size());
+    for(int time = 0; time <= 9; ++time)
+    {
+        BOOST_CHECK(outputCache.get(invert2.getName(), time).get() != NULL);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compute_parallel_frames_aborted)
+{
+    Graph g;
+    Graph::Node& generator = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert = g.createNode("tuttle.invert");
+    g.connect(generator, invert);
+
+    std::list<std::string> outputs;
+    outputs.push_back(invert.getName());
+
+    memory::MemoryCache outputCache;
+    ComputeOptions options(0, 9);
+    options.setNbParallelFrames(4);
+    options.abort();
+
+    // the process result is not successful, because it has been aborted.
+    BOOST_CHECK(!g.compute(outputCache, outputs, options));
+    BOOST_CHECK(outputCache.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
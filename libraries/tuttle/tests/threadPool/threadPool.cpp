@@ -0,0 +1,185 @@
+#define BOOST_TEST_MODULE tuttle_threadPool
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/ThreadPool.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/bind.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace
+{
+
+struct Counters
+{
+    explicit Counters(const std::size_t size)
+        : _calls(size, 0)
+        , _badIndex(0)
+    {
+    }
+    boost::mutex _mutex;
+    std::vector<int> _calls;
+    int _badIndex;
+};
+
+void countCall(unsigned int index, unsigned int count, void* customArg)
+{
+    Counters& counters = *static_cast<Counters*>(customArg);
+    unsigned int taskIndex;
+    const bool inTask = ThreadPool::getTaskIndex(taskIndex);
+    boost::mutex::scoped_lock locker(counters._mutex);
+    if(!inTask || taskIndex != index || count != counters._calls.size())
+        ++counters._badIndex;
+    ++counters._calls[index];
+}
+
+struct NestedArg
+{
+    ThreadPool* _pool;
+    std::vector<Counters*> _counters;
+};
+
+void nestedCall(unsigned int index, unsigned int, void* customArg)
+{
+    NestedArg& arg = *static_cast<NestedArg*>(customArg);
+    arg._pool->run(countCall, arg._counters[index]->_calls.size(), arg._counters[index]);
+}
+
+void emptyTask(unsigned int, unsigned int, void*)
+{
+}
+
+void throwingCall(unsigned int index, unsigned int count, void* customArg)
+{
+    countCall(index, count, customArg);
+    if(index % 2)
+        throw std::runtime_error("task error");
+}
+
+void launchThread(ThreadPool::TaskFunction func, unsigned int threadIndex, unsigned int threadMax, void* customArg)
+{
+    func(threadIndex, threadMax, customArg);
+}
+
+/// The previous implementation of the OFX multithread suite: create threads at each call.
+void runWithNewThreads(ThreadPool::TaskFunction func, const unsigned int count, void* customArg)
+{
+    boost::thread_group group;
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        group.create_thread(boost::bind(launchThread, func, i, count, customArg));
+    }
+    group.join_all();
+}
+
+void checkCounters(const Counters& counters)
+{
+    BOOST_CHECK_EQUAL(counters._badIndex, 0);
+    for(std::size_t i = 0; i < counters._calls.size(); ++i)
+        BOOST_CHECK_EQUAL(counters._calls[i], 1);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(threadPool_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(threadPool_run)
+{
+    ThreadPool pool(4);
+    BOOST_CHECK_EQUAL(pool.getNbThreads(), 4U);
+    BOOST_CHECK(!ThreadPool::isInTask());
+
+    for(unsigned int count = 1; count < 40; count += 7)
+    {
+        Counters counters(count);
+        pool.run(countCall, count, &counters);
+        checkCounters(counters);
+    }
+    BOOST_CHECK(!ThreadPool::isInTask());
+}
+
+BOOST_AUTO_TEST_CASE(threadPool_nested_run)
+{
+    ThreadPool pool(3);
+    NestedArg arg;
+    arg._pool = &pool;
+    for(std::size_t i = 0; i < 8; ++i)
+        arg._counters.push_back(new Counters(5 + i));
+
+    pool.run(nestedCall, arg._counters.size(), &arg);
+
+    for(std::size_t i = 0; i < arg._counters.size(); ++i)
+    {
+        checkCounters(*arg._counters[i]);
+        delete arg._counters[i];
+    }
+}
+
+BOOST_AUTO_TEST_CASE(threadPool_concurrent_run)
+{
+    ThreadPool pool(2);
+    std::vector<Counters*> counters;
+    boost::thread_group callers;
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        counters.push_back(new Counters(16));
+        callers.create_thread(boost::bind(&ThreadPool::run, &pool, countCall, 16, counters.back()));
+    }
+    callers.join_all();
+
+    for(std::size_t i = 0; i < counters.size(); ++i)
+    {
+        checkCounters(*counters[i]);
+        delete counters[i];
+    }
+}
+
+BOOST_AUTO_TEST_CASE(threadPool_task_exception)
+{
+    ThreadPool pool(4);
+    for(unsigned int count = 2; count < 20; count += 5)
+    {
+        // the error reaches the caller, after all the indices are executed
+        Counters counters(count);
+        BOOST_CHECK_THROW(pool.run(throwingCall, count, &counters), std::runtime_error);
+        checkCounters(counters);
+    }
+
+    // without workers, the tasks run in the calling thread
+    ThreadPool singlePool(1);
+    Counters counters(3);
+    BOOST_CHECK_THROW(singlePool.run(throwingCall, 3, &counters), std::runtime_error);
+    checkCounters(counters);
+
+    // the pool is still usable
+    Counters afterError(16);
+    pool.run(countCall, 16, &afterError);
+    checkCounters(afterError);
+}
+
+BOOST_AUTO_TEST_CASE(threadPool_overhead)
+{
+    const std::size_t nbCalls = 1000;
+    ThreadPool pool;
+    const unsigned int nbThreads = pool.getNbThreads();
+
+    boost::posix_time::ptime t0 = boost::posix_time::microsec_clock::local_time();
+    for(std::size_t i = 0; i < nbCalls; ++i)
+        runWithNewThreads(emptyTask, nbThreads, NULL);
+    boost::posix_time::ptime t1 = boost::posix_time::microsec_clock::local_time();
+    for(std::size_t i = 0; i < nbCalls; ++i)
+        pool.run(emptyTask, nbThreads, NULL);
+    boost::posix_time::ptime t2 = boost::posix_time::microsec_clock::local_time();
+
+    TUTTLE_LOG_INFO("[Thread pool] " << nbCalls << " calls on " << nbThreads << " threads");
+    TUTTLE_LOG_INFO("[Thread pool] new threads: " << (t1 - t0).total_microseconds() / nbCalls << " us per call");
+    TUTTLE_LOG_INFO("[Thread pool] thread pool: " << (t2 - t1).total_microseconds() / nbCalls << " us per call");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
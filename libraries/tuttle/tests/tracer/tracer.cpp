@@ -0,0 +1,71 @@
+#define BOOST_TEST_MODULE tuttle_tracer
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Tracer.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/make_shared.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+BOOST_AUTO_TEST_SUITE(tracer_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(trace_only_attached_threads)
+{
+    Tracer tracer;
+    {
+        const TraceSpan span("test", "detached");
+    }
+    BOOST_CHECK_EQUAL(0U, tracer.getNbEvents());
+    {
+        const TraceScope scope(&tracer, 3);
+        const TraceSpan span("test", "attached", "node");
+        traceInstant("test", "instant", "node");
+    }
+    BOOST_CHECK_EQUAL(2U, tracer.getNbEvents());
+    BOOST_CHECK(Tracer::getCurrent() == NULL);
+
+    std::ostringstream os;
+    tracer.exportChromeTrace(os);
+    const std::string trace = os.str();
+    BOOST_CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"attached\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"ph\":\"X\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"ph\":\"i\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"frame\":3") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(trace_compute)
+{
+    Graph g;
+    Graph::Node& generator = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert = g.createNode("tuttle.invert");
+    g.connect(generator, invert);
+
+    boost::shared_ptr<Tracer> tracer = boost::make_shared<Tracer>();
+    memory::MemoryCache outputCache;
+    ComputeOptions options(0, 1);
+    options.setTracer(tracer);
+    BOOST_CHECK(g.compute(outputCache, invert, options));
+
+    std::ostringstream os;
+    tracer->exportChromeTrace(os);
+    const std::string trace = os.str();
+    BOOST_CHECK(trace.find("\"name\":\"setupAtTime\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"renderAction\"") != std::string::npos);
+    BOOST_CHECK(trace.find(invert.getName()) != std::string::npos);
+    BOOST_CHECK(trace.find("\"frame\":1") != std::string::npos);
+
+    // without tracer, nothing more is recorded
+    const std::size_t nbEvents = tracer->getNbEvents();
+    memory::MemoryCache outputCache2;
+    BOOST_CHECK(g.compute(outputCache2, invert, ComputeOptions(0)));
+    BOOST_CHECK_EQUAL(nbEvents, tracer->getNbEvents());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -44,6 +44,9 @@ static const std::string kParamMetaDataUnknown = common::kPrefixMetaData + "unkn
 static const std::string kParamMetaDataUnknownLabel = "Unknown";
 
 static const std::string kParamVerbose = "verbose";
+
+/// Number of frames decoded ahead of the rendered one
+static const std::size_t kNbDecodeAheadFrames = 4;
 }
 }
 }
@@ -33,14 +33,11 @@ AVReaderPlugin::AVReaderPlugin(OfxImageEffectHandle handle)
     , _paramVideoDetailCustom(common::kPrefixVideo, AV_OPT_FLAG_DECODING_PARAM | AV_OPT_FLAG_VIDEO_PARAM, true)
     , _inputFile(NULL)
     , _inputDecoder(NULL)
-    , _sourceImage(NULL)
-    , _imageToDecode(NULL)
     , _inputStream(NULL)
-    , _colorTransform()
+    , _decodeAheadQueue(NULL)
     , _libavFeatures()
     , _lastInputFilePath("")
     , _lastVideoStreamIndex(0)
-    , _lastFrame(-1)
     , _initVideo(false)
     , _isSetUp(false)
 {
@@ -98,6 +95,9 @@ void AVReaderPlugin::ensureVideoIsOpen()
 
     try
     {
+        // stop decoding the previous file
+        _decodeAheadQueue.reset();
+
         // set and analyse inputFile
         _inputFile.reset(new avtranscoder::InputFile(filepath));
         _lastInputFilePath = filepath;
@@ -132,10 +132,9 @@ void AVReaderPlugin::ensureVideoIsOpen()
 
 void AVReaderPlugin::cleanInputFile()
 {
+    _decodeAheadQueue.reset();
     _inputFile.reset();
     _inputDecoder.reset();
-    _sourceImage.reset();
-    _imageToDecode.reset();
     _lastInputFilePath = "";
     _lastVideoStreamIndex = 0;
     _initVideo = false;
@@ -166,6 +165,19 @@ AVReaderParams AVReaderPlugin::getProcessParams() const
     return params;
 }
 
+DecodeAheadQueue& AVReaderPlugin::getDecodeAheadQueue(const std::string& outputPixelName)
+{
+    if(!_decodeAheadQueue || _decodeAheadQueue->getOutputPixelName() != outputPixelName)
+    {
+        _decodeAheadQueue.reset();
+        const avtranscoder::VideoFrameDesc sourceImageDesc(_inputStream->getVideoCodec().getVideoFrameDesc());
+        _decodeAheadQueue.reset(new DecodeAheadQueue(*_inputFile, *_inputDecoder, sourceImageDesc, outputPixelName,
+                                                     getProcessParams()._inputVideoProperties->getGopSize(),
+                                                     kNbDecodeAheadFrames));
+    }
+    return *_decodeAheadQueue;
+}
+
 void AVReaderPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName)
 {
     ReaderPlugin::changedParam(args, paramName);
@@ -507,6 +519,9 @@ void AVReaderPlugin::beginSequenceRender(const OFX::BeginSequenceRenderArguments
 
     ensureVideoIsOpen();
 
+    // the decoding thread of the previous sequence must not use the file and the decoder while they are set up
+    _decodeAheadQueue.reset();
+
     AVReaderParams params = getProcessParams();
 
     // set format
@@ -539,14 +554,6 @@ void AVReaderPlugin::beginSequenceRender(const OFX::BeginSequenceRenderArguments
     videoProfile.insert(videoDetailProfile.begin(), videoDetailProfile.end());
     _inputDecoder->setupDecoder(videoProfile);
 
-    // get source image
-    const avtranscoder::VideoFrameDesc sourceImageDesc(_inputStream->getVideoCodec().getVideoFrameDesc());
-    _sourceImage.reset(new avtranscoder::VideoFrame(sourceImageDesc));
-
-    // get image to decode
-    const avtranscoder::VideoFrameDesc imageToDecodeDesc(sourceImageDesc._width, sourceImageDesc._height, "rgb24");
-    _imageToDecode.reset(new avtranscoder::VideoFrame(imageToDecodeDesc));
-
     _isSetUp = true;
 }
 
@@ -4,12 +4,13 @@
 #include <common/LibAVParams.hpp>
 #include <common/LibAVFeaturesAvailable.hpp>
 
+#include "DecodeAheadQueue.hpp"
+
 #include <tuttle/ioplugin/context/ReaderPlugin.hpp>
 
 #include <AvTranscoder/file/InputFile.hpp>
 #include <AvTranscoder/decoder/VideoDecoder.hpp>
 #include <AvTranscoder/data/decoded/VideoFrame.hpp>
-#include <AvTranscoder/transform/VideoTransform.hpp>
 
 #include <boost/scoped_ptr.hpp>
 
@@ -57,6 +58,12 @@ public:
 
     AVReaderParams getProcessParams() const;
 
+    /**
+     * @brief Queue decoding the frames in the pixel format @p outputPixelName.
+     * @warning the decoder have to be set up (see beginSequenceRender)
+     */
+    DecodeAheadQueue& getDecodeAheadQueue(const std::string& outputPixelName);
+
     void updateVisibleTools();
     void changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName);
 
@@ -103,11 +110,10 @@ public:
 
     boost::scoped_ptr<avtranscoder::InputFile> _inputFile;
     boost::scoped_ptr<avtranscoder::VideoDecoder> _inputDecoder;
-    boost::scoped_ptr<avtranscoder::VideoFrame> _sourceImage;
-    boost::scoped_ptr<avtranscoder::VideoFrame> _imageToDecode;
     avtranscoder::InputStream* _inputStream; ///< Has link (InputFile has ownership)
 
-    avtranscoder::VideoTransform _colorTransform;
+    /// Decodes in a background thread with the input file and decoder, so it's destroyed before them.
+    boost::scoped_ptr<DecodeAheadQueue> _decodeAheadQueue;
 
     // to access available libav features
     common::LibAVFeaturesAvailable _libavFeatures;
@@ -115,8 +121,6 @@ public:
     std::string _lastInputFilePath;
     size_t _lastVideoStreamIndex;
 
-    int _lastFrame;
-
     bool _initVideo; ///< Is the video init
     bool _isSetUp;   ///< Is the unwrapping and decoding setup
 };
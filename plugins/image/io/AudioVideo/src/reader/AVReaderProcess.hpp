@@ -8,6 +8,12 @@
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 
+#include <boost/gil/gil_all.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <string>
+
 namespace tuttle
 {
 namespace plugin
@@ -17,6 +23,35 @@ namespace av
 namespace reader
 {
 
+/**
+ * @brief Pixels decoded for an output view: in 8 bits for 8 bits outputs, in 16 bits otherwise,
+ * so 10 and 12 bits sources keep their precision.
+ */
+template <class View>
+struct DecodedPixel
+{
+    typedef typename boost::gil::channel_type<View>::type OutputChannel;
+    typedef typename boost::mpl::if_<boost::is_same<OutputChannel, boost::gil::bits8>, boost::gil::bits8,
+                                     boost::gil::bits16>::type Channel;
+    typedef boost::gil::pixel<Channel, typename View::value_type::layout_t> Pixel;
+    typedef typename boost::gil::type_from_x_iterator<const Pixel*>::view_t ConstView;
+
+    /// Name of the libav pixel format in the native endianness
+    static std::string getPixelName()
+    {
+        const bool is8bits = boost::is_same<Channel, boost::gil::bits8>::value;
+        switch(boost::gil::num_channels<View>::value)
+        {
+            case 3:
+                return is8bits ? "rgb24" : "rgb48";
+            case 4:
+                return is8bits ? "rgba" : "rgba64";
+            default:
+                return is8bits ? "gray" : "gray16";
+        }
+    }
+};
+
 /**
  * @brief Audio Video process
  *
@@ -26,6 +61,7 @@ class AVReaderProcess : public ImageGilProcessor<View>
 {
 protected:
     AVReaderPlugin& _plugin;
+    avtranscoder::VideoFrame* _decodedFrame; ///< Has link (the decode ahead queue has ownership)
 
 public:
     AVReaderProcess(AVReaderPlugin& instance);
@@ -33,7 +69,6 @@ public:
     void setup(const OFX::RenderArguments& args);
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
-    template <typename FileView>
     View& readImage(View& dst, avtranscoder::VideoFrame& image);
 };
 }
@@ -15,6 +15,7 @@ template <class View>
 AVReaderProcess<View>::AVReaderProcess(AVReaderPlugin& instance)
     : ImageGilProcessor<View>(instance, eImageOrientationFromTopToBottom)
     , _plugin(instance)
+    , _decodedFrame(NULL)
 {
     this->setNoMultiThreading();
 }
@@ -26,23 +27,14 @@ void AVReaderProcess<View>::setup(const OFX::RenderArguments& args)
 
     // if need to support interlace, use args.fieldToRender
 
-    // optimization for seek
-    if((_plugin._lastFrame + 1) != args.time)
-    {
-        _plugin._inputFile->seekAtFrame(args.time);
-        _plugin._inputDecoder->flushDecoder();
-    }
-
-    _plugin._lastFrame = args.time;
-
-    // Fetch output image
-    if(!_plugin._inputDecoder->decodeNextFrame(*_plugin._sourceImage))
+    // Fetch output image, decoded ahead in the pixel format of the output
+    DecodeAheadQueue& decodeAheadQueue = _plugin.getDecodeAheadQueue(DecodedPixel<View>::getPixelName());
+    _decodedFrame = decodeAheadQueue.getFrame(static_cast<std::size_t>(args.time));
+    if(!_decodedFrame)
     {
         BOOST_THROW_EXCEPTION(exception::Failed() << exception::user() + "Can't open the frame at time " + args.time
                                                   << exception::filename(_plugin._paramFilepath->getValue()));
     }
-
-    _plugin._colorTransform.convert(*_plugin._sourceImage, *_plugin._imageToDecode);
 }
 
 /**
@@ -52,79 +44,21 @@ void AVReaderProcess<View>::setup(const OFX::RenderArguments& args)
 template <class View>
 void AVReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    using namespace boost::gil;
     BOOST_ASSERT(procWindowRoW == this->_dstPixelRod);
 
-    avtranscoder::PixelProperties pixel(_plugin._inputFile->getProperties()
-                                            .getVideoProperties()
-                                            .at(_plugin._paramVideoStreamIndex->getValue())
-                                            .getPixelProperties());
-    const size_t components = pixel.getNbComponents();
-    const size_t bitDepth = pixel.getMaxNbBitsInChannels();
-
-    switch(bitDepth)
-    {
-        case 8:
-            switch(components)
-            {
-                case 3:
-                    readImage<rgb8c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-                case 4:
-                    readImage<rgba8c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-                default:
-                    readImage<gray8c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-            }
-            break;
-        case 16:
-            switch(components)
-            {
-                case 3:
-                    readImage<rgb16c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-                case 4:
-                    readImage<rgba16c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-                default:
-                    readImage<gray16c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-            }
-            break;
-        case 32:
-            switch(components)
-            {
-                case 3:
-                    readImage<rgb32c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-                case 4:
-                    readImage<rgba32c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-                default:
-                    readImage<gray32c_view_t>(this->_dstView, *_plugin._imageToDecode);
-                    break;
-            }
-            break;
-        default:
-            readImage<gray16c_view_t>(this->_dstView, *_plugin._imageToDecode);
-            break;
-    }
+    readImage(this->_dstView, *_decodedFrame);
 }
 
 template <class View>
-template <typename FileView>
 View& AVReaderProcess<View>::readImage(View& dst, avtranscoder::VideoFrame& image)
 {
-    typedef typename FileView::value_type Pixel;
+    using namespace boost::gil;
+    typedef typename DecodedPixel<View>::Pixel Pixel;
+    typedef typename DecodedPixel<View>::ConstView FileView;
 
     const size_t width = image.desc()._width;
     const size_t height = image.desc()._height;
-    const avtranscoder::PixelProperties pixel = _plugin._inputFile->getProperties()
-                                                    .getVideoProperties()
-                                                    .at(_plugin._paramVideoStreamIndex->getValue())
-                                                    .getPixelProperties();
-    const size_t rowSizeInBytes = pixel.getNbComponents() * width;
+    const size_t rowSizeInBytes = sizeof(Pixel) * width;
 
     FileView avSrcView = interleaved_view(width, height, (const Pixel*)(image.getData()[0]), rowSizeInBytes);
 
@@ -0,0 +1,215 @@
+#include "DecodeAheadQueue.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace av
+{
+namespace reader
+{
+
+namespace
+{
+const std::size_t kNoSlot = std::numeric_limits<std::size_t>::max();
+}
+
+DecodeAheadQueue::DecodeAheadQueue(avtranscoder::InputFile& inputFile, avtranscoder::VideoDecoder& decoder,
+                                   const avtranscoder::VideoFrameDesc& sourceDesc, const std::string& outputPixelName,
+                                   const std::size_t gopSize, const std::size_t nbFrames)
+    : _inputFile(inputFile)
+    , _decoder(decoder)
+    , _sourceImage(sourceDesc)
+    , _colorTransform()
+    , _outputPixelName(outputPixelName)
+    , _gopSize(gopSize)
+    , _nbFrames(std::max(nbFrames, std::size_t(1)))
+    , _usedSlot(kNoSlot)
+    , _nextFrame(0)
+    , _requestedFrame(0)
+    , _seekRequested(true)
+    , _endOfStream(false)
+    , _stop(false)
+{
+    const avtranscoder::VideoFrameDesc outputDesc(sourceDesc._width, sourceDesc._height, outputPixelName);
+    for(std::size_t slot = 0; slot <= _nbFrames; ++slot)
+    {
+        _slots.push_back(new avtranscoder::VideoFrame(outputDesc));
+        _freeSlots.push_back(slot);
+    }
+    _thread = boost::thread(&DecodeAheadQueue::decodeFrames, this);
+}
+
+DecodeAheadQueue::~DecodeAheadQueue()
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_all();
+    _thread.join();
+}
+
+avtranscoder::VideoFrame* DecodeAheadQueue::getFrame(const std::size_t frame)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+
+    if(_usedSlot != kNoSlot)
+    {
+        releaseSlot(_usedSlot);
+        _usedSlot = kNoSlot;
+    }
+    while(!_readyFrames.empty() && _readyFrames.front().first < frame)
+    {
+        releaseSlot(_readyFrames.front().second);
+        _readyFrames.pop_front();
+    }
+
+    const bool isDecoded = !_readyFrames.empty() && _readyFrames.front().first == frame;
+    // the frames between the decoder position and the requested one are decoded without being kept
+    const bool isComing = _readyFrames.empty() && !_seekRequested && !_endOfStream && frame >= _nextFrame &&
+                          frame - _nextFrame < std::max(_gopSize, _nbFrames);
+    if(!isDecoded && !isComing)
+    {
+        releaseReadyFrames();
+        _seekRequested = true;
+    }
+    _requestedFrame = frame;
+    _condition.notify_all();
+
+    while(_readyFrames.empty() || _readyFrames.front().first != frame)
+    {
+        // the decoder stopped or skipped the frame
+        if(!_seekRequested && (_endOfStream || !_readyFrames.empty()))
+            return NULL;
+        _condition.wait(lock);
+    }
+    _usedSlot = _readyFrames.front().second;
+    _readyFrames.pop_front();
+    _condition.notify_all();
+    return &_slots[_usedSlot];
+}
+
+void DecodeAheadQueue::decodeFrames()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    while(!_stop)
+    {
+        if(_seekRequested)
+        {
+            const std::size_t frame = _requestedFrame;
+            _seekRequested = false;
+            // the end of the stream from the previous position doesn't apply to the new one
+            _endOfStream = false;
+            lock.unlock();
+            std::size_t keyframe = frame;
+            bool seeked = true;
+            try
+            {
+                keyframe = seek(frame);
+            }
+            catch(std::exception& e)
+            {
+                TUTTLE_LOG_WARNING("AVReader: unable to seek at frame " << frame << ": " << e.what());
+                seeked = false;
+            }
+            lock.lock();
+            _nextFrame = keyframe;
+            _endOfStream = !seeked;
+            _condition.notify_all();
+            continue;
+        }
+        if(_endOfStream || _freeSlots.empty())
+        {
+            _condition.wait(lock);
+            continue;
+        }
+
+        const std::size_t slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        const std::size_t frame = _nextFrame;
+        const bool keepFrame = frame >= _requestedFrame;
+        lock.unlock();
+
+        bool decoded = false;
+        try
+        {
+            decoded = _decoder.decodeNextFrame(_sourceImage);
+            // frames before the requested one are only decoded to reach it
+            if(decoded && keepFrame)
+                _colorTransform.convert(_sourceImage, _slots[slot]);
+        }
+        catch(std::exception& e)
+        {
+            TUTTLE_LOG_WARNING("AVReader: unable to decode frame " << frame << ": " << e.what());
+            decoded = false;
+        }
+
+        lock.lock();
+        if(_seekRequested)
+        {
+            // the decoded frame is from the previous position
+            releaseSlot(slot);
+            continue;
+        }
+        ++_nextFrame;
+        if(!decoded)
+        {
+            _endOfStream = true;
+            releaseSlot(slot);
+        }
+        else if(frame < _requestedFrame)
+        {
+            releaseSlot(slot);
+        }
+        else if(!keepFrame)
+        {
+            // the request moved back to this frame during its decode, so it was not converted: decode it again
+            releaseSlot(slot);
+            _seekRequested = true;
+        }
+        else
+        {
+            _readyFrames.push_back(FrameSlot(frame, slot));
+        }
+        _condition.notify_all();
+    }
+}
+
+std::size_t DecodeAheadQueue::seek(const std::size_t frame)
+{
+    // Without GOP information, let the demuxer find the position.
+    // Otherwise start from the previous keyframe, so the decoder never starts from a frame predicted from missing ones.
+    const std::size_t keyframe = (_gopSize > 1) ? frame - frame % _gopSize : frame;
+    _inputFile.seekAtFrame(keyframe, (_gopSize > 1) ? AVSEEK_FLAG_BACKWARD : AVSEEK_FLAG_ANY);
+    _decoder.flushDecoder();
+    return keyframe;
+}
+
+void DecodeAheadQueue::releaseSlot(const std::size_t slot)
+{
+    _freeSlots.push_back(slot);
+}
+
+void DecodeAheadQueue::releaseReadyFrames()
+{
+    while(!_readyFrames.empty())
+    {
+        releaseSlot(_readyFrames.front().second);
+        _readyFrames.pop_front();
+    }
+}
+}
+}
+}
+}
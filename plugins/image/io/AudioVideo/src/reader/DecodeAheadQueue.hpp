@@ -0,0 +1,99 @@
+#ifndef _TUTTLE_PLUGIN_AV_READER_DECODE_AHEAD_QUEUE_HPP_
+#define _TUTTLE_PLUGIN_AV_READER_DECODE_AHEAD_QUEUE_HPP_
+
+#include <AvTranscoder/file/InputFile.hpp>
+#include <AvTranscoder/decoder/VideoDecoder.hpp>
+#include <AvTranscoder/data/decoded/VideoFrame.hpp>
+#include <AvTranscoder/transform/VideoTransform.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace av
+{
+namespace reader
+{
+
+/**
+ * @brief Decode the frames following the last requested one in a background thread.
+ *
+ * Frames are converted to the pixel format of the output and kept in a ring buffer of a fixed size,
+ * so sequential renders only copy an already decoded frame.
+ * A request for a frame before the buffered ones or far after them restarts the decoding from the
+ * keyframe before it. Close frames after the buffered ones are reached by decoding forward.
+ *
+ * The thread is the only user of the file and the decoder until the queue is destroyed.
+ */
+class DecodeAheadQueue : boost::noncopyable
+{
+public:
+    /**
+     * @param gopSize number of frames between two keyframes, 0 if unknown.
+     * @param nbFrames max number of decoded frames waiting to be used.
+     */
+    DecodeAheadQueue(avtranscoder::InputFile& inputFile, avtranscoder::VideoDecoder& decoder,
+                     const avtranscoder::VideoFrameDesc& sourceDesc, const std::string& outputPixelName,
+                     const std::size_t gopSize, const std::size_t nbFrames);
+    ~DecodeAheadQueue();
+
+    const std::string& getOutputPixelName() const { return _outputPixelName; }
+
+    /**
+     * @brief Wait for the decoded @p frame.
+     * The returned frame is valid until the next call.
+     * @return NULL if the frame can't be decoded.
+     */
+    avtranscoder::VideoFrame* getFrame(const std::size_t frame);
+
+private:
+    typedef std::pair<std::size_t, std::size_t> FrameSlot; ///< frame index, slot index
+
+    void decodeFrames();
+    std::size_t seek(const std::size_t frame);
+
+    void releaseSlot(const std::size_t slot);
+    void releaseReadyFrames();
+
+private:
+    avtranscoder::InputFile& _inputFile;
+    avtranscoder::VideoDecoder& _decoder;
+    avtranscoder::VideoFrame _sourceImage;
+    avtranscoder::VideoTransform _colorTransform;
+    const std::string _outputPixelName;
+    const std::size_t _gopSize;
+    const std::size_t _nbFrames;
+
+    boost::ptr_vector<avtranscoder::VideoFrame> _slots; ///< nbFrames frames to fill, and the frame in use
+    std::vector<std::size_t> _freeSlots;
+    std::deque<FrameSlot> _readyFrames; ///< consecutive decoded frames
+    std::size_t _usedSlot;              ///< slot of the last returned frame
+
+    std::size_t _nextFrame;      ///< next frame given by the decoder
+    std::size_t _requestedFrame; ///< frames before it are decoded but not kept
+    bool _seekRequested;
+    bool _endOfStream;
+    bool _stop;
+
+    boost::mutex _mutex;
+    boost::condition_variable _condition;
+    boost::thread _thread;
+};
+}
+}
+}
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include <tuttle/plugin/global.hpp>
 
+#include <ImfThreading.h>
+
+#include <boost/thread/thread.hpp>
+
 namespace tuttle
 {
 namespace plugin
@@ -12,6 +16,15 @@ namespace exr
 
 static const std::string kParamFileBitDepth = "fileBitDepth";
 
+/**
+ * @brief Let OpenEXR decode and encode the lines or tiles of a file in parallel, in its own thread pool.
+ */
+inline void initExrThreads()
+{
+    if(Imf::globalThreadCount() == 0)
+        Imf::setGlobalThreadCount(boost::thread::hardware_concurrency());
+}
+
 enum ETuttlePluginFileBitDepth
 {
     eTuttlePluginFileBitDepth16f = 0,
@@ -13,7 +13,15 @@ namespace exr
 namespace reader
 {
 
-static const bool kSupportTiles = false;
+static const bool kSupportTiles = true;
+
+/**
+ * @brief Function called when the plugin is loaded.
+ */
+void EXRReaderPluginFactory::load()
+{
+    initExrThreads();
+}
 
 /**
  * @brief Function called to describe the plugin main features.
@@ -11,7 +11,7 @@ namespace exr
 namespace reader
 {
 
-mDeclarePluginFactory(EXRReaderPluginFactory, {}, {});
+mDeclarePluginFactory(EXRReaderPluginFactory, ;, {});
 }
 }
 }
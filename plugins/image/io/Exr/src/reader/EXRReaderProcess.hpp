@@ -9,9 +9,13 @@
 #include <ofxsMultiThread.h>
 
 #include <ImfInputFile.h>
+#include <ImathBox.h>
 
 #include <boost/scoped_ptr.hpp>
 
+#include <vector>
+#include <string>
+
 namespace tuttle
 {
 namespace plugin
@@ -29,21 +33,33 @@ class EXRReaderProcess : public ImageGilProcessor<View>
 {
 protected:
     typedef typename View::value_type Pixel;
+    typedef typename boost::gil::channel_type<View>::type Channel;
     typedef std::vector<char, OfxAllocator<char> > DataVector;
 
+    /// Number of lines decoded at once when the lines can't be read directly in the output
+    static const int kBandHeight = 64;
+
     EXRReaderPlugin& _plugin; ///< Rendering plugin
     EXRReaderProcessParams _params;
     boost::scoped_ptr<Imf::InputFile> _exrImage; ///< Pointer to an exr image
 
-    template <typename PixelType>
-    void initExrChannel(DataVector& data, Imf::Slice& slice, Imf::FrameBuffer& frameBuffer, Imf::PixelType pixelType,
-                        std::string channelID, const Imath::Box2i& dw);
+    std::size_t getNbChannels() const;
+
+    bool readDirect(Imf::InputFile& input, View& dst, const Imath::V2i& dstOrigin, const Imath::Box2i& readWindow,
+                    const std::size_t nbChannels);
+
+    void readBands(Imf::InputFile& input, View& dst, const Imath::V2i& dstOrigin, const Imath::Box2i& readWindow,
+                   const std::size_t nbChannels);
+
+    void readScaled(Imf::InputFile& input, View& dst, const Imath::V2i& dstOrigin, const OfxPointD& scale,
+                    const Imath::Box2i& readWindow, const std::size_t nbChannels);
 
-    void channelCopy(Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst, const std::size_t nbChannels);
+    void setLineBuffers(Imf::InputFile& input, std::vector<DataVector>& buffers, const int y1, const int y2,
+                        const std::size_t nbChannels);
 
-    template <typename workingView>
-    void sliceCopy(Imf::InputFile& input, const Imf::Slice* slice, View& dst, const EXRReaderProcessParams& params,
-                   const std::size_t channelIndex);
+    template <typename SrcChannel>
+    void copyLineScaled(const char* srcLine, const int srcX1, View& dst, const int y, const Imath::V2i& dstOrigin,
+                        const OfxPointD& scale, const Imath::Box2i& readWindow, const std::size_t channelIndex);
 
     std::string getChannelName(size_t index);
 
@@ -54,7 +70,7 @@ public:
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
-    void readImage(const std::string& filepath);
+    void readImage(Imf::InputFile& input, const OfxRectI& procWindowRoW);
 };
 }
 }
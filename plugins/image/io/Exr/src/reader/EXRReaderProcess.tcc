@@ -19,6 +19,8 @@
 #include <ofxsMultiThread.h>
 
 #include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfThreading.h>
 #include <ImfArray.h>
 #include <ImathVec.h>
 
@@ -30,6 +32,7 @@
 #include <boost/mpl/vector.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/filesystem/fstream.hpp>
 
 #include <algorithm>
@@ -62,7 +65,8 @@ void EXRReaderProcess<View>::setup(const OFX::RenderArguments& args)
 
     try
     {
-        _exrImage.reset(new Imf::InputFile(_params._filepath.c_str()));
+        // lines or tiles are decoded in parallel by the OpenEXR thread pool
+        _exrImage.reset(new Imf::InputFile(_params._filepath.c_str(), Imf::globalThreadCount()));
     }
     catch(...)
     {
@@ -78,15 +82,9 @@ void EXRReaderProcess<View>::setup(const OFX::RenderArguments& args)
 template <class View>
 void EXRReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    using namespace terry;
-    BOOST_ASSERT(procWindowRoW == this->_dstPixelRod);
-
-    // TODO: Exr can contain a background color
-    terry::draw::fill_pixels(this->_dstView, terry::numeric::pixel_zeros<Pixel>());
-
     try
     {
-        readImage(_params._filepath);
+        readImage(*_exrImage, procWindowRoW);
     }
     catch(boost::exception& e)
     {
@@ -103,17 +101,9 @@ void EXRReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
 }
 
 template <class View>
-void EXRReaderProcess<View>::readImage(const std::string& filepath)
+std::size_t EXRReaderProcess<View>::getNbChannels() const
 {
-    using namespace boost;
-    using namespace mpl;
-    using namespace boost::gil;
-    using namespace Imf;
-
-    EXRReaderProcessParams params = _plugin.getProcessParams(this->_renderArgs.time);
-    Imf::InputFile in(filepath.c_str());
-
-    int nbChannels = std::min(_params._fileNbChannels, int(num_channels<View>::type::value));
+    int nbChannels = std::min(_params._fileNbChannels, int(boost::gil::num_channels<View>::type::value));
     nbChannels = std::min(nbChannels, _params._userNbComponents);
 
     if(nbChannels == 0)
@@ -121,164 +111,256 @@ void EXRReaderProcess<View>::readImage(const std::string& filepath)
         BOOST_THROW_EXCEPTION(exception::FileNotExist()
                               << exception::user() + "EXR: doesn't support " + _params._fileNbChannels + " channels.");
     }
-
-    channelCopy(in, params, this->_dstView, nbChannels);
+    return nbChannels;
 }
 
-template <class View>
-template <typename PixelType>
-void EXRReaderProcess<View>::initExrChannel(DataVector& data, Imf::Slice& slice, Imf::FrameBuffer& frameBuffer,
-                                            Imf::PixelType pixelType, std::string channelID, const Imath::Box2i& dw)
+inline Imath::Box2i boxIntersection(const Imath::Box2i& a, const Imath::Box2i& b)
 {
-    Imath::V2i s = dw.size();
-    s.x += 1;
-    s.y += 1;
-
-    const std::size_t allocSize = sizeof(PixelType) * s.x * s.y;
-    data.resize(allocSize);
-
-    slice.type = pixelType;
-    slice.base = (char*)(&data[0] - sizeof(PixelType) * (dw.min.x + dw.min.y * s.x));
-    slice.xStride = sizeof(PixelType);
-    slice.yStride = sizeof(PixelType) * s.x;
-    slice.xSampling = 1;
-    slice.ySampling = 1;
-    slice.fillValue = 1.0;
-
-    frameBuffer.insert(channelID.c_str(), slice);
+    Imath::Box2i res;
+
+    res.min.x = std::max(a.min.x, b.min.x);
+    res.min.y = std::max(a.min.y, b.min.y);
+
+    res.max.x = std::min(a.max.x, b.max.x);
+    res.max.y = std::min(a.max.y, b.max.y);
+
+    return res;
 }
 
+/**
+ * @brief Read the lines and columns of the file needed by the render window.
+ */
 template <class View>
-void EXRReaderProcess<View>::channelCopy(Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst,
-                                         const std::size_t nbChannels)
+void EXRReaderProcess<View>::readImage(Imf::InputFile& input, const OfxRectI& procWindowRoW)
 {
     using namespace boost::gil;
 
+    const std::size_t nbChannels = getNbChannels();
+
     const Imf::Header& header = input.header();
     const Imath::Box2i& dataWindow = header.dataWindow();
+    // the region of definition in file coordinates
+    const Imath::Box2i rodWindow = _params._displayWindow ? header.displayWindow() : dataWindow;
+
+    // The render window in the output view, from top to bottom like the file
+    const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates(procWindowRoW);
+    const int dstY1 = this->_dstPixelRodSize.y - procWindowOutput.y2;
+    const int dstY2 = this->_dstPixelRodSize.y - procWindowOutput.y1;
+    View dst = subimage_view(this->_dstView, procWindowOutput.x1, dstY1, procWindowOutput.x2 - procWindowOutput.x1,
+                             dstY2 - dstY1);
+    // file pixel of the top left corner of the render window, at full scale
+    const Imath::V2i dstOrigin(rodWindow.min.x + procWindowOutput.x1, rodWindow.min.y + dstY1);
+
+    const OfxPointD scale = this->_renderArgs.renderScale;
+    const bool fullScale = (scale.x == 1.0 && scale.y == 1.0);
+
+    const Imath::Box2i windowInFile(
+        Imath::V2i(rodWindow.min.x + int(procWindowOutput.x1 / scale.x), rodWindow.min.y + int(dstY1 / scale.y)),
+        Imath::V2i(rodWindow.min.x + int((procWindowOutput.x2 - 1) / scale.x),
+                   rodWindow.min.y + int((dstY2 - 1) / scale.y)));
+    const Imath::Box2i readWindow = boxIntersection(windowInFile, dataWindow);
+
+    // TODO: Exr can contain a background color
+    if(!fullScale || readWindow != windowInFile || nbChannels < std::size_t(num_channels<View>::type::value))
+        terry::draw::fill_pixels(dst, terry::numeric::pixel_zeros<Pixel>());
+
+    if(readWindow.isEmpty())
+        return;
+
+    if(!fullScale)
+    {
+        readScaled(input, dst, Imath::V2i(procWindowOutput.x1, dstY1), scale, readWindow, nbChannels);
+        return;
+    }
+    if(!readDirect(input, dst, dstOrigin, readWindow, nbChannels))
+        readBands(input, dst, dstOrigin, readWindow, nbChannels);
+}
+
+/**
+ * @brief Decode the lines directly in the output, without intermediate buffer.
+ * @return false if OpenEXR can't write in the output: channels not in float or columns outside of the render window.
+ */
+template <class View>
+bool EXRReaderProcess<View>::readDirect(Imf::InputFile& input, View& dst, const Imath::V2i& dstOrigin,
+                                        const Imath::Box2i& readWindow, const std::size_t nbChannels)
+{
+    if(!boost::is_same<Channel, boost::gil::bits32f>::value)
+        return false;
+
+    // OpenEXR writes all the columns of the data window
+    const Imath::Box2i& dataWindow = input.header().dataWindow();
+    if(readWindow.min.x != dataWindow.min.x || readWindow.max.x != dataWindow.max.x)
+        return false;
+
+    const Imf::ChannelList& channels = input.header().channels();
+    for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+    {
+        // OpenEXR converts half to float like terry
+        const Imf::PixelType type = channels[getChannelName(channelIndex).c_str()].type;
+        if(type != Imf::HALF && type != Imf::FLOAT)
+            return false;
+    }
+
+    // OpenEXR strides are unsigned: the lines are decoded in the output rows from the lowest one in memory,
+    // then flipped if the output image is from bottom to top in memory
+    const std::ptrdiff_t rowSize = dst.pixels().row_size();
+    const bool bottomToTop = rowSize < 0;
+    const std::ptrdiff_t xStride = sizeof(Pixel);
+    const std::ptrdiff_t yStride = bottomToTop ? -rowSize : rowSize;
+    const int dstY1 = readWindow.min.y - dstOrigin.y;
+    const int dstY2 = readWindow.max.y - dstOrigin.y;
 
     Imf::FrameBuffer frameBuffer;
-    std::vector<DataVector> data(nbChannels);
-    std::vector<Imf::Slice> slices(nbChannels);
+    for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+    {
+        char* lowestRow = reinterpret_cast<char*>(&dst(0, bottomToTop ? dstY2 : dstY1)[channelIndex]);
+        // address of the file pixel (0, 0), OpenEXR only uses it with pixels inside the read window
+        char* base = lowestRow - dstOrigin.x * xStride - readWindow.min.y * yStride;
+        frameBuffer.insert(getChannelName(channelIndex).c_str(),
+                           Imf::Slice(Imf::FLOAT, base, xStride, yStride, 1, 1, 0.0));
+    }
+    input.setFrameBuffer(frameBuffer);
+    input.readPixels(readWindow.min.y, readWindow.max.y);
 
-    for(size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+    if(bottomToTop)
     {
-        const Imf::ChannelList& cl(header.channels());
-        const Imf::Channel& ch = cl[getChannelName(channelIndex).c_str()];
-        switch(ch.type)
-        {
-            case Imf::HALF:
-            {
-                initExrChannel<half>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type,
-                                     getChannelName(channelIndex), dataWindow);
-                break;
-            }
-            case Imf::FLOAT:
-            {
-                initExrChannel<float>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type,
-                                      getChannelName(channelIndex), dataWindow);
-                break;
-            }
-            case Imf::UINT:
-            {
-                initExrChannel<boost::uint32_t>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type,
-                                                getChannelName(channelIndex), dataWindow);
-                break;
-            }
-            case Imf::NUM_PIXELTYPES:
-            {
-                BOOST_THROW_EXCEPTION(exception::Value() << exception::user("Pixel type not supported."));
-                break;
-            }
-        }
+        const int dstX1 = readWindow.min.x - dstOrigin.x;
+        const int dstX2 = readWindow.max.x - dstOrigin.x + 1;
+        for(int top = dstY1, bottom = dstY2; top < bottom; ++top, --bottom)
+            std::swap_ranges(dst.x_at(dstX1, top), dst.x_at(dstX2, top), dst.x_at(dstX1, bottom));
     }
+    return true;
+}
+
+/**
+ * @brief Buffers of the full data window width for the lines [y1, y2], in float or uint per channel.
+ */
+template <class View>
+void EXRReaderProcess<View>::setLineBuffers(Imf::InputFile& input, std::vector<DataVector>& buffers, const int y1,
+                                            const int y2, const std::size_t nbChannels)
+{
+    const Imath::Box2i& dataWindow = input.header().dataWindow();
+    const Imf::ChannelList& channels = input.header().channels();
+    const std::ptrdiff_t width = dataWindow.max.x - dataWindow.min.x + 1;
 
+    Imf::FrameBuffer frameBuffer;
+    for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+    {
+        const std::string channelName = getChannelName(channelIndex);
+        const Imf::PixelType fileType = channels[channelName.c_str()].type;
+        const Imf::PixelType type = (fileType == Imf::UINT) ? Imf::UINT : Imf::FLOAT;
+        const std::ptrdiff_t xStride = (type == Imf::UINT) ? sizeof(boost::uint32_t) : sizeof(float);
+        const std::ptrdiff_t yStride = xStride * width;
+
+        DataVector& buffer = buffers[channelIndex];
+        buffer.resize(yStride * (y2 - y1 + 1));
+        char* base = &buffer[0] - dataWindow.min.x * xStride - y1 * yStride;
+        frameBuffer.insert(channelName.c_str(), Imf::Slice(type, base, xStride, yStride, 1, 1, 0.0));
+    }
     input.setFrameBuffer(frameBuffer);
-    input.readPixels(dataWindow.min.y, dataWindow.max.y);
+}
+
+/**
+ * @brief Decode bands of lines in temporary buffers, and convert them into the output.
+ */
+template <class View>
+void EXRReaderProcess<View>::readBands(Imf::InputFile& input, View& dst, const Imath::V2i& dstOrigin,
+                                       const Imath::Box2i& readWindow, const std::size_t nbChannels)
+{
+    using namespace boost::gil;
 
-    for(size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+    const Imath::Box2i& dataWindow = input.header().dataWindow();
+    const int dataWidth = dataWindow.max.x - dataWindow.min.x + 1;
+    const int readWidth = readWindow.max.x - readWindow.min.x + 1;
+    std::vector<DataVector> buffers(nbChannels);
+
+    for(int y1 = readWindow.min.y; y1 <= readWindow.max.y; y1 += kBandHeight)
     {
-        switch(slices[channelIndex].type)
+        const int y2 = std::min(y1 + kBandHeight - 1, readWindow.max.y);
+        const int bandHeight = y2 - y1 + 1;
+        setLineBuffers(input, buffers, y1, y2, nbChannels);
+        input.readPixels(y1, y2);
+
+        View dstBand =
+            subimage_view(dst, readWindow.min.x - dstOrigin.x, y1 - dstOrigin.y, readWidth, bandHeight);
+        for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
         {
-            case Imf::HALF:
-            {
-                sliceCopy<gray16h_view_t>(input, &slices[channelIndex], dst, params, channelIndex);
-                break;
-            }
-            case Imf::FLOAT:
+            char* buffer = &buffers[channelIndex][0];
+            const std::ptrdiff_t xOffset = readWindow.min.x - dataWindow.min.x;
+            if(input.frameBuffer()[getChannelName(channelIndex).c_str()].type == Imf::UINT)
             {
-                sliceCopy<gray32f_view_t>(input, &slices[channelIndex], dst, params, channelIndex);
-                break;
+                gray32_view_t src = interleaved_view(dataWidth, bandHeight, reinterpret_cast<gray32_pixel_t*>(buffer),
+                                                     dataWidth * sizeof(boost::uint32_t));
+                copy_and_convert_pixels(subimage_view(src, xOffset, 0, readWidth, bandHeight),
+                                        nth_channel_view(dstBand, channelIndex));
             }
-            case Imf::UINT:
+            else
             {
-                sliceCopy<gray32_view_t>(input, &slices[channelIndex], dst, params, channelIndex);
-                break;
-            }
-            case Imf::NUM_PIXELTYPES:
-            {
-                BOOST_THROW_EXCEPTION(exception::Value() << exception::user("Pixel type not supported."));
-                break;
+                gray32f_view_t src = interleaved_view(dataWidth, bandHeight, reinterpret_cast<gray32f_pixel_t*>(buffer),
+                                                      dataWidth * sizeof(float));
+                copy_and_convert_pixels(subimage_view(src, xOffset, 0, readWidth, bandHeight),
+                                        nth_channel_view(dstBand, channelIndex));
             }
         }
     }
 }
 
-Imath::Box2i boxIntersection(const Imath::Box2i& a, const Imath::Box2i& b)
+/**
+ * @brief Proxy render: decode only the lines used by the output, with the nearest pixel.
+ */
+template <class View>
+void EXRReaderProcess<View>::readScaled(Imf::InputFile& input, View& dst, const Imath::V2i& dstOrigin,
+                                        const OfxPointD& scale, const Imath::Box2i& readWindow,
+                                        const std::size_t nbChannels)
 {
-    Imath::Box2i res;
+    const Imath::Box2i& dataWindow = input.header().dataWindow();
+    const Imath::Box2i rodWindow = _params._displayWindow ? input.header().displayWindow() : dataWindow;
+    std::vector<DataVector> buffers(nbChannels);
 
-    res.min.x = std::max(a.min.x, b.min.x);
-    res.min.y = std::max(a.min.y, b.min.y);
-
-    res.max.x = std::min(a.max.x, b.max.x);
-    res.max.y = std::min(a.max.y, b.max.y);
-
-    return res;
+    int previousY = readWindow.min.y - 1;
+    for(int y = 0; y < dst.height(); ++y)
+    {
+        const int fileY = rodWindow.min.y + int((dstOrigin.y + y) / scale.y);
+        if(fileY < readWindow.min.y || fileY > readWindow.max.y)
+            continue;
+        if(fileY != previousY)
+        {
+            setLineBuffers(input, buffers, fileY, fileY, nbChannels);
+            input.readPixels(fileY);
+            previousY = fileY;
+        }
+        for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+        {
+            if(input.frameBuffer()[getChannelName(channelIndex).c_str()].type == Imf::UINT)
+                copyLineScaled<boost::gil::bits32>(&buffers[channelIndex][0], dataWindow.min.x - rodWindow.min.x, dst, y,
+                                                   dstOrigin, scale, readWindow, channelIndex);
+            else
+                copyLineScaled<boost::gil::bits32f>(&buffers[channelIndex][0], dataWindow.min.x - rodWindow.min.x, dst,
+                                                    y, dstOrigin, scale, readWindow, channelIndex);
+        }
+    }
 }
 
+/**
+ * @param srcX1 first column of @p srcLine, relative to the region of definition in the file
+ */
 template <class View>
-template <typename workingView>
-void EXRReaderProcess<View>::sliceCopy(Imf::InputFile& input, const Imf::Slice* slice, View& dst,
-                                       const EXRReaderProcessParams& params, const std::size_t channelIndex)
+template <typename SrcChannel>
+void EXRReaderProcess<View>::copyLineScaled(const char* srcLine, const int srcX1, View& dst, const int y,
+                                            const Imath::V2i& dstOrigin, const OfxPointD& scale,
+                                            const Imath::Box2i& readWindow, const std::size_t channelIndex)
 {
-    using namespace terry;
-    const Imath::Box2i dataWindow = input.header().dataWindow();
-    Imath::V2i dataWindowSize = dataWindow.size();
-    dataWindowSize.x += 1;
-    dataWindowSize.y += 1;
-
-    if(dataWindowSize.x <= 0 || dataWindowSize.y <= 0)
-        return;
-
-    workingView dataView(interleaved_view(dataWindowSize.x, dataWindowSize.y, (typename workingView::value_type*)slice->base,
-                                          dataWindowSize.x * sizeof(typename workingView::value_type)));
-
-    if(params._displayWindow)
-    {
-        const Imath::Box2i displayWindow = input.header().displayWindow();
-        const Imath::Box2i croppedDisplayWindow = boxIntersection(displayWindow, dataWindow);
-        Imath::V2i croppedDisplayWindowSize = croppedDisplayWindow.size();
-        croppedDisplayWindowSize.x += 1;
-        croppedDisplayWindowSize.y += 1;
-
-        if(croppedDisplayWindowSize.x <= 0 || croppedDisplayWindowSize.y <= 0)
-            return;
-
-        workingView dataSubView = subimage_view(dataView, croppedDisplayWindow.min.x, croppedDisplayWindow.min.y,
-                                                croppedDisplayWindowSize.x, croppedDisplayWindowSize.y);
-
-        View dstSubView = subimage_view(dst, croppedDisplayWindow.min.x - displayWindow.min.x,
-                                        croppedDisplayWindow.min.y - displayWindow.min.y, croppedDisplayWindowSize.x,
-                                        croppedDisplayWindowSize.y);
-
-        copy_and_convert_pixels(dataSubView, nth_channel_view(dstSubView, channelIndex));
-    }
-    else
+    const SrcChannel* src = reinterpret_cast<const SrcChannel*>(srcLine);
+    const Imath::Box2i& dataWindow = _exrImage->header().dataWindow();
+    const int readX1 = readWindow.min.x - dataWindow.min.x;
+    const int readX2 = readWindow.max.x - dataWindow.min.x;
+    typename View::x_iterator dstIt = dst.row_begin(y);
+    for(int x = 0; x < dst.width(); ++x, ++dstIt)
     {
-        workingView dataSubView =
-            subimage_view(dataView, dataWindow.min.x, dataWindow.min.y, dataWindowSize.x, dataWindowSize.y);
-        copy_and_convert_pixels(dataSubView, nth_channel_view(dst, channelIndex));
+        const int srcX = int((dstOrigin.x + x) / scale.x) - srcX1;
+        if(srcX < readX1 || srcX > readX2)
+            continue;
+        (*dstIt)[channelIndex] = boost::gil::channel_convert<Channel>(src[srcX]);
     }
 }
 
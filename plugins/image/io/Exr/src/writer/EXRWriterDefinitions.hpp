@@ -18,12 +18,16 @@ namespace writer
 static const std::string kParamStorageType = "storage";
 static const std::string kParamStorageScanLine = "scanLine";
 static const std::string kParamStorageTiles = "tiles";
+static const std::string kParamStorageTilesMipmap = "tilesMipmap";
 
 enum EParamStorage
 {
     eParamStorageScanLine = 0,
-    eParamStorageTiles
+    eParamStorageTiles,
+    eParamStorageTilesMipmap
 };
+
+static const std::string kParamTileSize = "tileSize";
 }
 }
 }
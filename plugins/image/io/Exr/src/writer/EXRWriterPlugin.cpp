@@ -20,6 +20,7 @@ EXRWriterPlugin::EXRWriterPlugin(OfxImageEffectHandle handle)
 {
     _paramComponentsType = fetchChoiceParam(kTuttlePluginChannel);
     _paramStorageType = fetchChoiceParam(kParamStorageType);
+    _paramTileSize = fetchIntParam(kParamTileSize);
 
     _paramFileBitDepth = fetchChoiceParam(kParamFileBitDepth);
     _paramCompression = fetchChoiceParam(kParamCompression);
@@ -33,6 +34,7 @@ EXRWriterProcessParams EXRWriterPlugin::getProcessParams(const OfxTime time)
     params._fileBitDepth = (ETuttlePluginFileBitDepth) this->_paramFileBitDepth->getValue();
     params._componentsType = (ETuttlePluginComponents)_paramComponentsType->getValue();
     params._storageType = (EParamStorage)_paramStorageType->getValue();
+    params._tileSize = _paramTileSize->getValue();
     params._compression = (EParamCompression)_paramCompression->getValue();
 
     return params;
@@ -19,6 +19,7 @@ struct EXRWriterProcessParams
     ETuttlePluginFileBitDepth _fileBitDepth;
     ETuttlePluginComponents _componentsType;
     EParamStorage _storageType;
+    int _tileSize;
     EParamCompression _compression;
 };
 
@@ -38,6 +39,7 @@ public:
 protected:
     OFX::ChoiceParam* _paramComponentsType;
     OFX::ChoiceParam* _paramStorageType;
+    OFX::IntParam* _paramTileSize;
     OFX::ChoiceParam* _paramFileBitDepth;
     OFX::ChoiceParam* _paramCompression;
 };
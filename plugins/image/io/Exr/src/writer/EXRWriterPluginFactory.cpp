@@ -13,6 +13,14 @@ namespace exr
 namespace writer
 {
 
+/**
+ * @brief Function called when the plugin is loaded.
+ */
+void EXRWriterPluginFactory::load()
+{
+    initExrThreads();
+}
+
 /**
  * @brief Function called to describe the plugin main features.
  * @param[in, out]   desc     Effect descriptor
@@ -70,12 +78,18 @@ void EXRWriterPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc,
     OFX::ChoiceParamDescriptor* storageType = desc.defineChoiceParam(kParamStorageType);
     storageType->setLabel("Storage type");
     storageType->appendOption(kParamStorageScanLine);
-#if(TUTTLE_EXPERIMENTAL)
     storageType->appendOption(kParamStorageTiles);
-#endif
+    storageType->appendOption(kParamStorageTilesMipmap, "Tiles with all the mipmap levels, for texture maps.");
     storageType->setCacheInvalidation(OFX::eCacheInvalidateValueAll);
     storageType->setDefault(eParamStorageScanLine);
 
+    OFX::IntParamDescriptor* tileSize = desc.defineIntParam(kParamTileSize);
+    tileSize->setLabel("Tile size");
+    tileSize->setHint("Width and height of the tiles in pixels.");
+    tileSize->setRange(16, 1024);
+    tileSize->setDisplayRange(32, 256);
+    tileSize->setDefault(64);
+
     OFX::ChoiceParamDescriptor* bitDepth =
         static_cast<OFX::ChoiceParamDescriptor*>(desc.getParamDescriptor(kTuttlePluginBitDepth));
     bitDepth->resetOptions();
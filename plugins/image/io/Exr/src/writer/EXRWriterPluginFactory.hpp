@@ -12,7 +12,7 @@ namespace writer
 {
 
 static const bool kSupportTiles = false;
-mDeclarePluginFactory(EXRWriterPluginFactory, {}, {});
+mDeclarePluginFactory(EXRWriterPluginFactory, ;, {});
 }
 }
 }
@@ -8,6 +8,8 @@
 #include <terry/globals.hpp>
 
 #include <ImfOutputFile.h>
+#include <ImfTiledOutputFile.h>
+#include <ImfThreading.h>
 #include <ImfRgba.h>
 #include <ImfChannelList.h>
 #include <ImfArray.h>
@@ -48,6 +50,9 @@ protected:
 
     template <class WPixel>
     void writeImage(View& src, std::string& filepath, Imf::PixelType pixType);
+
+    template <class WPixel>
+    void writeMipmapLevels(Imf::TiledOutputFile& file, const View& src);
 };
 }
 }
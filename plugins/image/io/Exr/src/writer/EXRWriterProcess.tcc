@@ -10,9 +10,12 @@
 
 #include <boost/gil/gil_all.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/assert.hpp>
 
+#include <algorithm>
+
 namespace tuttle
 {
 namespace plugin
@@ -47,7 +50,7 @@ void EXRWriterProcess<View>::setup(const OFX::RenderArguments& args)
 template <class View>
 void EXRWriterProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    // no tiles and no multithreading supported
+    // the whole image is written at once, OpenEXR compresses it with its own threads
     BOOST_ASSERT((procWindowRoW == this->_dstPixelRod));
     BOOST_ASSERT((this->_srcPixelRod == this->_dstPixelRod));
 
@@ -268,6 +271,25 @@ struct FillFrameSwitch<4>
     }
 };
 
+/**
+ * @brief Insert slices reading the channels of the interleaved float view @p src in place.
+ * OpenEXR strides are unsigned, so @p src must be from top to bottom in memory.
+ */
+template <typename SView>
+void fillFrameBufferFromView(Imf::FrameBuffer& frameBuffer, const SView& src, const std::size_t nbChannels)
+{
+    static const char* const channelNames[] = {"R", "G", "B", "A"};
+    const std::ptrdiff_t xStride = sizeof(typename SView::value_type);
+    const std::ptrdiff_t yStride = src.pixels().row_size();
+    BOOST_ASSERT(yStride > 0);
+    for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+    {
+        char* base = (char*)&src(0, 0)[channelIndex];
+        frameBuffer.insert(nbChannels == 1 ? "Y" : channelNames[channelIndex],
+                           Imf::Slice(Imf::FLOAT, base, xStride, yStride));
+    }
+}
+
 template <class View>
 template <class WPixel>
 void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::PixelType pixType)
@@ -278,9 +300,9 @@ void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::P
     typedef boost::gil::image<WPixel, is_planar_t::value> image_t;
     typedef typename image_t::view_t view_t;
 
-    image_t img(src.width(), src.height());
-    view_t dvw(view(img));
-    boost::gil::copy_and_convert_pixels(src, dvw);
+    static const std::size_t view_nb_channels = boost::gil::num_channels<view_t>::value;
+    static const std::size_t src_nb_channels = boost::gil::num_channels<View>::value;
+
     Imf::Header header(src.width(), src.height(), (float)_plugin._clipSrc->getPixelAspectRatio());
 
     switch(_params._compression)
@@ -338,7 +360,7 @@ void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::P
             break;
     }
 
-    switch(dvw.num_channels())
+    switch(view_nb_channels)
     {
         case 1: // Gray
             header.channels().insert("Y", Imf::Channel(pixType));
@@ -362,17 +384,112 @@ void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::P
             BOOST_THROW_EXCEPTION(exception::ImageFormat() << exception::user("ExrWriter: incompatible image type"));
     }
 
-    Imf::OutputFile file(filepath.c_str(), header);
+    Imf::LevelMode levelMode = Imf::ONE_LEVEL;
+    if(_params._storageType == eParamStorageTilesMipmap)
+    {
+        if(pixType == Imf::UINT)
+            TUTTLE_LOG_WARNING("ExrWriter: no mipmap levels in uint32 files, only the full resolution is written.");
+        else
+            levelMode = Imf::MIPMAP_LEVEL;
+    }
+    if(_params._storageType != eParamStorageScanLine)
+        header.setTileDescription(Imf::TileDescription(_params._tileSize, _params._tileSize, levelMode, Imf::ROUND_DOWN));
+
     Imf::FrameBuffer frameBuffer;
+    image_t img;
+    boost::gil::image<typename View::value_type, false> topToBottom;
+    // OpenEXR converts float to half itself, so float pixels with the same channels are written from the source
+    // without conversion.
+    if(boost::is_same<typename boost::gil::channel_type<View>::type, boost::gil::bits32f>::value &&
+       pixType != Imf::UINT && src_nb_channels == view_nb_channels)
+    {
+        if(src.pixels().row_size() < 0)
+        {
+            // the source is from bottom to top in memory, copied in the order of the file lines
+            topToBottom.recreate(src.dimensions());
+            boost::gil::copy_pixels(src, view(topToBottom));
+            fillFrameBufferFromView(frameBuffer, view(topToBottom), view_nb_channels);
+        }
+        else
+            fillFrameBufferFromView(frameBuffer, src, view_nb_channels);
+    }
+    else
+    {
+        img.recreate(src.width(), src.height());
+        view_t dvw(view(img));
+        boost::gil::copy_and_convert_pixels(src, dvw);
 
-    const std::size_t rowBytes = bitsTypeSize * src.width();
+        const std::size_t rowBytes = bitsTypeSize * src.width();
+        FillFrameSwitch<view_nb_channels>::template fillFrameBuffer<view_t>(frameBuffer, dvw, pixType, bitsTypeSize,
+                                                                            rowBytes);
+    }
 
-    static const std::size_t view_nb_channels = boost::gil::num_channels<view_t>::value;
-    FillFrameSwitch<view_nb_channels>::template fillFrameBuffer<view_t>(frameBuffer, dvw, pixType, bitsTypeSize, rowBytes);
+    // Lines or tiles are compressed in parallel by the OpenEXR thread pool.
+    if(_params._storageType == eParamStorageScanLine)
+    {
+        Imf::OutputFile file(filepath.c_str(), header, Imf::globalThreadCount());
+        file.setFrameBuffer(frameBuffer);
+        // Finalize output
+        file.writePixels(src.height());
+        return;
+    }
 
+    Imf::TiledOutputFile file(filepath.c_str(), header, Imf::globalThreadCount());
     file.setFrameBuffer(frameBuffer);
-    // Finalize output
-    file.writePixels(src.height());
+    file.writeTiles(0, file.numXTiles(0) - 1, 0, file.numYTiles(0) - 1, 0);
+
+    if(levelMode == Imf::MIPMAP_LEVEL)
+        writeMipmapLevels<WPixel>(file, src);
+}
+
+/**
+ * @brief Write the levels of a mipmapped file, each level is the previous one reduced by a 2x2 box filter.
+ */
+template <class View>
+template <class WPixel>
+void EXRWriterProcess<View>::writeMipmapLevels(Imf::TiledOutputFile& file, const View& src)
+{
+    typedef boost::gil::pixel<boost::gil::bits32f,
+                              boost::gil::layout<typename boost::gil::color_space_type<WPixel>::type> > level_pixel_t;
+    typedef boost::gil::image<level_pixel_t, false> level_image_t;
+    typedef typename level_image_t::view_t level_view_t;
+
+    static const std::size_t nbChannels = boost::gil::num_channels<WPixel>::value;
+
+    level_image_t previous(src.width(), src.height());
+    boost::gil::copy_and_convert_pixels(src, view(previous));
+
+    for(int level = 1; level < file.numLevels(); ++level)
+    {
+        level_image_t current(file.levelWidth(level), file.levelHeight(level));
+        const level_view_t previousView = view(previous);
+        const level_view_t currentView = view(current);
+
+        // Levels are rounded down, but a dimension stops at 1 while the other one is still halved:
+        // the 2x2 blocks are clamped to the previous level.
+        const int lastX = previousView.width() - 1;
+        const int lastY = previousView.height() - 1;
+        for(int y = 0; y < currentView.height(); ++y)
+        {
+            typename level_view_t::x_iterator top = previousView.row_begin(std::min(2 * y, lastY));
+            typename level_view_t::x_iterator bottom = previousView.row_begin(std::min(2 * y + 1, lastY));
+            typename level_view_t::x_iterator dst = currentView.row_begin(y);
+            for(int x = 0; x < currentView.width(); ++x, ++dst)
+            {
+                const int left = std::min(2 * x, lastX);
+                const int right = std::min(2 * x + 1, lastX);
+                for(std::size_t c = 0; c < nbChannels; ++c)
+                    (*dst)[c] = 0.25f * (top[left][c] + top[right][c] + bottom[left][c] + bottom[right][c]);
+            }
+        }
+
+        Imf::FrameBuffer frameBuffer;
+        fillFrameBufferFromView(frameBuffer, currentView, nbChannels);
+        file.setFrameBuffer(frameBuffer);
+        file.writeTiles(0, file.numXTiles(level) - 1, 0, file.numYTiles(level) - 1, level);
+
+        previous.swap(current);
+    }
 }
 }
 }
@@ -6,6 +6,7 @@
 #include <tuttle/host/Graph.hpp>
 
 #include <boost/preprocessor/stringize.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <boost/timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -24,3 +25,44 @@ std::string pluginName = "tuttle.exrwriter";
 std::string filename = "test-exr.exr";
 #include <tuttle/test/io/writer.hpp>
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(plugin_Exr_mipmap)
+
+/**
+ * @brief Write and read back mipmapped files of non-square images.
+ * The smaller dimension reaches 1 pixel while the other one is still reduced.
+ */
+BOOST_AUTO_TEST_CASE(process_writer_mipmap_non_square)
+{
+    const int sizes[][2] = {{64, 4}, {4, 64}, {33, 2}};
+    for(std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        const boost::filesystem::path file =
+            boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("plugin_exr_%%%%%%%%.exr");
+
+        Graph g;
+        Graph::Node& constant = g.createNode("tuttle.constant");
+        Graph::Node& writer = g.createNode("tuttle.exrwriter");
+        constant.getParam("width").setValue(sizes[i][0]);
+        constant.getParam("height").setValue(sizes[i][1]);
+        writer.getParam("filename").setValue(file.string());
+        writer.getParam("storage").setValue(2); // tilesMipmap
+        writer.getParam("tileSize").setValue(16);
+        g.connect(constant, writer);
+        g.compute(writer);
+        BOOST_REQUIRE(boost::filesystem::exists(file));
+
+        Graph readGraph;
+        Graph::Node& reader = readGraph.createNode("tuttle.exrreader");
+        reader.getParam("filename").setValue(file.string());
+        memory::MemoryCache outputCache;
+        readGraph.compute(outputCache, reader);
+        memory::CACHE_ELEMENT imgRes = outputCache.get(reader.getName(), 0);
+        BOOST_CHECK_EQUAL(imgRes->getROD().x2 - imgRes->getROD().x1, sizes[i][0]);
+        BOOST_CHECK_EQUAL(imgRes->getROD().y2 - imgRes->getROD().y1, sizes[i][1]);
+
+        boost::filesystem::remove(file);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_COLORGRADATION_PROCESS_HPP_
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+#include <terry/colorspace/gradation_lut.hpp>
 #include <boost/scoped_ptr.hpp>
 
 namespace tuttle
@@ -20,10 +21,12 @@ class ColorGradationProcess : public ImageGilFilterProcessor<View>
 {
 public:
     typedef float Scalar;
+    typedef typename boost::gil::channel_type<View>::type Channel;
 
 protected:
     ColorGradationPlugin& _plugin; ///< Rendering plugin
     ColorGradationProcessParams<Scalar> _params;
+    terry::color::gradation_lut<Channel> _lut; ///< conversion of the channel values, built once by render
 
 public:
     ColorGradationProcess(ColorGradationPlugin& effect);
@@ -32,16 +35,10 @@ public:
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
 private:
-    template <class TIN, class TOUT>
-    GIL_FORCEINLINE void processSwitchAlpha(const bool processAlpha, const View& src, const View& dst,
-                                            TIN gradationIn = TIN(), TOUT gradationOut = TOUT());
-
     template <class TIN>
-    GIL_FORCEINLINE void processSwitchOut(const EParamGradation out, const bool processAlpha, const View& src,
-                                          const View& dst, TIN gradationIn = TIN());
+    void buildLutSwitchOut(const EParamGradation out, TIN gradationIn = TIN());
 
-    void processSwitchInOut(const EParamGradation in, const EParamGradation out, const bool processAlpha, const View& src,
-                            const View& dst);
+    void buildLutSwitchInOut(const EParamGradation in, const EParamGradation out);
 };
 }
 }
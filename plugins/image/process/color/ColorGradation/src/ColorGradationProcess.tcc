@@ -8,7 +8,7 @@
 
 #include <terry/globals.hpp>
 #include <terry/copy.hpp>
-#include <terry/colorspace/gradation.hpp>
+#include <terry/colorspace/gradation_lut.hpp>
 
 #include <boost/mpl/if.hpp>
 #include <boost/static_assert.hpp>
@@ -35,34 +35,13 @@ void ColorGradationProcess<View>::setup(const OFX::RenderArguments& args)
     ImageGilFilterProcessor<View>::setup(args);
 
     _params = _plugin.getProcessParams(args.renderScale);
-}
 
-template <class View>
-template <class TIN, class TOUT>
-GIL_FORCEINLINE void ColorGradationProcess<View>::processSwitchAlpha(const bool processAlpha, const View& src,
-                                                                     const View& dst, TIN gradationIn, TOUT gradationOut)
-{
-    using namespace boost::gil;
-    if(processAlpha)
-    {
-        terry::algorithm::transform_pixels_progress(
-            src, dst, terry::color::transform_pixel_color_gradation_t<TIN, TOUT>(gradationIn, gradationOut), *this);
-    }
-    else
-    {
-        /// @todo do not apply process on alpha directly inside transform, with a "channel_for_each_if_channel"
-        terry::algorithm::transform_pixels_progress(
-            src, dst, terry::color::transform_pixel_color_gradation_t<TIN, TOUT>(gradationIn, gradationOut), *this);
-
-        // temporary solution copy alpha channel
-        terry::copy_channel_if_exist<alpha_t>(src, dst);
-    }
+    buildLutSwitchInOut(_params._in, _params._out);
 }
 
 template <class View>
 template <class TIN>
-GIL_FORCEINLINE void ColorGradationProcess<View>::processSwitchOut(const EParamGradation out, const bool processAlpha,
-                                                                   const View& src, const View& dst, TIN gradationIn)
+void ColorGradationProcess<View>::buildLutSwitchOut(const EParamGradation out, TIN gradationIn)
 {
     using namespace boost::gil;
     terry::color::gradation::Gamma gamma(_params._GammaValueOut);
@@ -70,41 +49,40 @@ GIL_FORCEINLINE void ColorGradationProcess<View>::processSwitchOut(const EParamG
     switch(out)
     {
         case eParamGradation_linear:
-            processSwitchAlpha<TIN, terry::color::gradation::Linear>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::Linear());
             break;
         case eParamGradation_sRGB:
-            processSwitchAlpha<TIN, terry::color::gradation::sRGB>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::sRGB());
             break;
         case eParamGradation_Rec709:
-            processSwitchAlpha<TIN, terry::color::gradation::Rec709>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::Rec709());
             break;
         case eParamGradation_cineon:
-            processSwitchAlpha<TIN, terry::color::gradation::Cineon>(processAlpha, src, dst, gradationIn, cineon);
+            _lut.build(gradationIn, cineon);
             break;
         case eParamGradation_gamma:
-            processSwitchAlpha<TIN, terry::color::gradation::Gamma>(processAlpha, src, dst, gradationIn, gamma);
+            _lut.build(gradationIn, gamma);
             break;
         case eParamGradation_panalog:
-            processSwitchAlpha<TIN, terry::color::gradation::Panalog>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::Panalog());
             break;
         case eParamGradation_REDLog:
-            processSwitchAlpha<TIN, terry::color::gradation::REDLog>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::REDLog());
             break;
         case eParamGradation_ViperLog:
-            processSwitchAlpha<TIN, terry::color::gradation::ViperLog>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::ViperLog());
             break;
         case eParamGradation_REDSpace:
-            processSwitchAlpha<TIN, terry::color::gradation::REDSpace>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::REDSpace());
             break;
         case eParamGradation_AlexaV3LogC:
-            processSwitchAlpha<TIN, terry::color::gradation::AlexaV3LogC>(processAlpha, src, dst, gradationIn);
+            _lut.build(gradationIn, terry::color::gradation::AlexaV3LogC());
             break;
     }
 }
 
 template <class View>
-void ColorGradationProcess<View>::processSwitchInOut(const EParamGradation in, const EParamGradation out,
-                                                     const bool processAlpha, const View& src, const View& dst)
+void ColorGradationProcess<View>::buildLutSwitchInOut(const EParamGradation in, const EParamGradation out)
 {
     using namespace boost::gil;
     terry::color::gradation::Gamma gamma(_params._GammaValueIn);
@@ -112,34 +90,34 @@ void ColorGradationProcess<View>::processSwitchInOut(const EParamGradation in, c
     switch(in)
     {
         case eParamGradation_linear:
-            processSwitchOut<terry::color::gradation::Linear>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::Linear>(out);
             break;
         case eParamGradation_sRGB:
-            processSwitchOut<terry::color::gradation::sRGB>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::sRGB>(out);
             break;
         case eParamGradation_Rec709:
-            processSwitchOut<terry::color::gradation::Rec709>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::Rec709>(out);
             break;
         case eParamGradation_cineon:
-            processSwitchOut<terry::color::gradation::Cineon>(out, processAlpha, src, dst, cineon);
+            buildLutSwitchOut<terry::color::gradation::Cineon>(out, cineon);
             break;
         case eParamGradation_gamma:
-            processSwitchOut<terry::color::gradation::Gamma>(out, processAlpha, src, dst, gamma);
+            buildLutSwitchOut<terry::color::gradation::Gamma>(out, gamma);
             break;
         case eParamGradation_panalog:
-            processSwitchOut<terry::color::gradation::Panalog>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::Panalog>(out);
             break;
         case eParamGradation_REDLog:
-            processSwitchOut<terry::color::gradation::REDLog>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::REDLog>(out);
             break;
         case eParamGradation_ViperLog:
-            processSwitchOut<terry::color::gradation::ViperLog>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::ViperLog>(out);
             break;
         case eParamGradation_REDSpace:
-            processSwitchOut<terry::color::gradation::REDSpace>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::REDSpace>(out);
             break;
         case eParamGradation_AlexaV3LogC:
-            processSwitchOut<terry::color::gradation::AlexaV3LogC>(out, processAlpha, src, dst);
+            buildLutSwitchOut<terry::color::gradation::AlexaV3LogC>(out);
             break;
     }
 }
@@ -158,7 +136,13 @@ void ColorGradationProcess<View>::multiThreadProcessImages(const OfxRectI& procW
     View src = subimage_view(this->_srcView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
     View dst = subimage_view(this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
 
-    processSwitchInOut(_params._in, _params._out, _params._processAlpha, src, dst);
+    terry::algorithm::transform_pixels_progress(src, dst, terry::color::transform_pixel_gradation_lut_t<Channel>(_lut),
+                                                *this);
+    if(!_params._processAlpha)
+    {
+        /// @todo do not apply process on alpha directly inside transform, with a "channel_for_each_if_channel"
+        terry::copy_channel_if_exist<alpha_t>(src, dst);
+    }
 }
 }
 }
@@ -0,0 +1,144 @@
+#include "ColorSpaceChain.hpp"
+
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <terry/colorspace/gradation.hpp>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace colorspace
+{
+
+namespace
+{
+
+typedef terry::color::color_transform_chain Chain;
+typedef Chain::Matrix33 Matrix33;
+
+/**
+ * @brief Conversion of rgb values encoded with their gradation to the layout.
+ * The luma and chroma layouts (YUV, YPbPr) are defined on the encoded values, the other ones are identities here.
+ */
+Matrix33 encodedRgbToLayout(const ttlc::EParamLayout layout)
+{
+    switch(layout)
+    {
+        case ttlc::eParamLayoutRGB:
+        case ttlc::eParamLayoutXYZ:
+            return Chain::identity();
+        case ttlc::eParamLayoutYUV:
+            return Chain::rgb_to_yuv();
+        case ttlc::eParamLayoutYPbPr:
+            return Chain::rgb_to_YPbPr();
+        case ttlc::eParamLayoutHSV:
+        case ttlc::eParamLayoutHSL:
+        case ttlc::eParamLayoutLab:
+        case ttlc::eParamLayoutLuv:
+        case ttlc::eParamLayoutYxy:
+            break;
+    }
+    BOOST_THROW_EXCEPTION(exception::Unsupported() << exception::user("ColorSpace: only the RGB, YUV, YPbPr and XYZ "
+                                                                      "layouts are supported."));
+}
+
+/**
+ * @brief Conversion of linear rgb values to the layout.
+ * XYZ is defined on the linear values, the other layouts are identities here.
+ */
+Matrix33 linearRgbToLayout(const ttlc::EParamLayout layout)
+{
+    if(layout == ttlc::eParamLayoutXYZ)
+        return Chain::rgb_to_XYZ();
+    return Chain::identity();
+}
+
+/**
+ * @brief White balance from D65 to the color temperature, the diagonal of the terry::color::temperature matrices.
+ */
+Matrix33 d65ToTemperature(const ttlc::EColorTemperature temperature)
+{
+    static const double scales[][3] = {
+        {0.54194504, 1.21054840, 0.85470724}, // A
+        {0.80080682, 1.05155921, 1.32802486}, // B
+        {0.95100260, 1.02611196, 0.90880305}, // C
+        {0.85027254, 1.02490389, 1.38509774}, // D50
+        {0.90575325, 1.01328468, 1.21454775}, // D55
+        {0.93619251, 1.00805032, 1.13851726}, // D58
+        {1.0, 1.0, 1.0},                      // D65
+        {1.07631159, 0.99362320, 0.87314081}, // D75
+        {1.11976373, 1.00573123, 0.72909999}, // 9300
+        {0.82993227, 1.05454266, 1.10040021}, // E
+        {0.74563771, 1.06088448, 1.77422941}, // F2
+        {0.99945968, 1.00000501, 1.00154579}, // F7
+        {0.70728123, 1.08209848, 1.87809896}, // F11
+        {1.12864172, 0.95369333, 1.16999125}  // DCI-P3
+    };
+    const double* s = scales[temperature];
+    return Chain::diagonal(s[0], s[1], s[2]);
+}
+
+/// Add the conversion from the gradation to linear if @p toLinear, from linear to the gradation otherwise
+template <class Gradation>
+void addLinearGradation(terry::color::color_transform_chain& chain, const Gradation& gradation, const bool toLinear)
+{
+    if(toLinear)
+        chain.addGradation(gradation, terry::color::gradation::Linear());
+    else
+        chain.addGradation(terry::color::gradation::Linear(), gradation);
+}
+
+void addGradationLaw(terry::color::color_transform_chain& chain, const ttlc::EParamGradationLaw law,
+                     const ttlc::GradationLaw::gamma& gammaParams, const ttlc::GradationLaw::cineon& cineonParams,
+                     const bool toLinear)
+{
+    namespace gradation = terry::color::gradation;
+    switch(law)
+    {
+        case ttlc::eParamLinear:
+            break;
+        case ttlc::eParamsRGB:
+            addLinearGradation(chain, gradation::sRGB(), toLinear);
+            break;
+        case ttlc::eParamCineon:
+            addLinearGradation(chain, gradation::Cineon(cineonParams.blackPoint, cineonParams.whitePoint,
+                                                         cineonParams.gammaSensito),
+                               toLinear);
+            break;
+        case ttlc::eParamGamma:
+            addLinearGradation(chain, gradation::Gamma(gammaParams.value), toLinear);
+            break;
+        case ttlc::eParamPanalog:
+            addLinearGradation(chain, gradation::Panalog(), toLinear);
+            break;
+        case ttlc::eParamREDLog:
+            addLinearGradation(chain, gradation::REDLog(), toLinear);
+            break;
+        case ttlc::eParamViperLog:
+            addLinearGradation(chain, gradation::ViperLog(), toLinear);
+            break;
+        case ttlc::eParamREDSpace:
+            addLinearGradation(chain, gradation::REDSpace(), toLinear);
+            break;
+        case ttlc::eParamAlexaLogC:
+            addLinearGradation(chain, gradation::AlexaV3LogC(), toLinear);
+            break;
+    }
+}
+}
+
+void buildColorSpaceChain(const ColorSpaceProcessParams& params, terry::color::color_transform_chain& chain)
+{
+    chain.addMatrix(Chain::inverse(encodedRgbToLayout(params._layoutIn)));
+    addGradationLaw(chain, params._gradationIn, params._sGammaIn, params._sCineonIn, true);
+    chain.addMatrix(Chain::inverse(linearRgbToLayout(params._layoutIn)));
+    chain.addMatrix(Chain::inverse(d65ToTemperature(params._tempColorIn)));
+    chain.addMatrix(d65ToTemperature(params._tempColorOut));
+    chain.addMatrix(linearRgbToLayout(params._layoutOut));
+    addGradationLaw(chain, params._gradationOut, params._sGammaOut, params._sCineonOut, false);
+    chain.addMatrix(encodedRgbToLayout(params._layoutOut));
+}
+}
+}
+}
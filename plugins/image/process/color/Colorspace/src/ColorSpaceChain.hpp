@@ -0,0 +1,26 @@
+#ifndef _TUTTLE_COLORSPACE_CHAIN_HPP_
+#define _TUTTLE_COLORSPACE_CHAIN_HPP_
+
+#include "ColorSpacePlugin.hpp"
+
+#include <terry/colorspace/transform_chain.hpp>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace colorspace
+{
+
+/**
+ * @brief Add the conversion from the input to the output colorspace to @p chain:
+ * input luma and chroma layout to rgb, input gradation to linear, input XYZ layout to rgb, input temperature to D65,
+ * then the reverse to the output.
+ * The chain still has to be compiled.
+ */
+void buildColorSpaceChain(const ColorSpaceProcessParams& params, terry::color::color_transform_chain& chain);
+}
+}
+}
+
+#endif
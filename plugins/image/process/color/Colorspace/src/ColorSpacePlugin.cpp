@@ -125,23 +125,21 @@ ColorSpaceProcessParams ColorSpacePlugin::getProcessParams() const
 
 bool ColorSpacePlugin::isIdentity(const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime)
 {
-    /*
-    ColorSpaceProcessParams params = getProcessParams();
-    if(
-            params._BlackPointIn	== params._BlackPointOut &&
-            params._GammaSensitoIn	== params._GammaSensitoOut &&
-            params._GammaValueIn	== params._GammaValueOut &&
-            params._WhitePointIn	== params._WhitePointOut &&
-            params._gradationIn	== params._gradationOut &&
-            params._layoutIn	== params._layoutOut &&
-            params._tempColorIn	== params._tempColorOut
-     )
-    {
-            identityClip = _clipSrc;
-            identityTime = args.time;
-            return true;
-    }*/
-    return false;
+    const ColorSpaceProcessParams params = getProcessParams();
+    if(params._gradationIn != params._gradationOut || params._layoutIn != params._layoutOut ||
+       params._tempColorIn != params._tempColorOut)
+        return false;
+    if(params._gradationIn == ttlc::eParamGamma && params._sGammaIn.value != params._sGammaOut.value)
+        return false;
+    if(params._gradationIn == ttlc::eParamCineon &&
+       (params._sCineonIn.blackPoint != params._sCineonOut.blackPoint ||
+        params._sCineonIn.whitePoint != params._sCineonOut.whitePoint ||
+        params._sCineonIn.gammaSensito != params._sCineonOut.gammaSensito))
+        return false;
+
+    identityClip = _clipSrc;
+    identityTime = args.time;
+    return true;
 }
 
 /**
@@ -1,6 +1,8 @@
 #ifndef _TUTTLE_COLORSPACE_PROCESS_HPP_
 #define _TUTTLE_COLORSPACE_PROCESS_HPP_
 
+#include "ColorSpaceChain.hpp"
+
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 #include <terry/globals.hpp>
@@ -8,7 +10,9 @@
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 
-#include <boost/scoped_ptr.hpp>
+#include <boost/mpl/bool.hpp>
+
+#include <vector>
 
 namespace tuttle
 {
@@ -17,11 +21,20 @@ namespace plugin
 namespace colorspace
 {
 
+/**
+ * @brief Convert the images with the conversions from the input to the output colorspace, compiled into a chain
+ * of precomputed steps when the process is set up, and applied to the rows of each band in a single pass.
+ */
 template <class View>
 class ColorSpaceProcess : public ImageGilFilterProcessor<View>
 {
+public:
+    typedef typename View::value_type Pixel;
+    typedef typename boost::gil::channel_type<View>::type Channel;
+
 protected:
     ColorSpaceProcessParams _params;
+    terry::color::color_transform_chain _chain;
 
     ColorSpacePlugin& _plugin; ///< Rendering plugin
 
@@ -31,6 +44,12 @@ public:
     void setup(const OFX::RenderArguments& args);
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
+
+private:
+    /// Apply the chain to the rgb channels of the rows
+    void processRows(const View& src, const View& dst, boost::mpl::true_ hasRGB);
+    /// Images without rgb channels are copied
+    void processRows(const View& src, const View& dst, boost::mpl::false_ hasRGB);
 };
 }
 }
@@ -2,7 +2,10 @@
 #include <tuttle/plugin/exceptions.hpp>
 
 #include <terry/globals.hpp>
-#include <terry/color.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+
+#include <algorithm>
 
 namespace tuttle
 {
@@ -26,6 +29,10 @@ void ColorSpaceProcess<View>::setup(const OFX::RenderArguments& args)
     ImageGilFilterProcessor<View>::setup(args);
 
     _params = _plugin.getProcessParams();
+
+    _chain = terry::color::color_transform_chain();
+    buildColorSpaceChain(_params, _chain);
+    _chain.compile();
 }
 
 /**
@@ -41,16 +48,57 @@ void ColorSpaceProcess<View>::multiThreadProcessImages(const OfxRectI& procWindo
     View src = subimage_view(this->_srcView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
     View dst = subimage_view(this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
 
-    /*
-    terry::color::ColorSpaceAPI		csAPI;
-    csAPI.setGammaInProperties	( _params._sGammaIn );
-    csAPI.setCineonInProperties	( _params._sCineonIn );
-    csAPI.setGammaOutProperties	( _params._sGammaOut );
-    csAPI.setCineonOutProperties	( _params._sCineonOut );
+    processRows(src, dst, typename contains_color<Pixel, red_t>::type());
+}
+
+template <class View>
+void ColorSpaceProcess<View>::processRows(const View& src, const View& dst, boost::mpl::true_)
+{
+    const bool isIntegral = boost::is_integral<Channel>::value;
+    std::vector<float> values(3 * src.width());
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+    {
+        typename View::x_iterator itSrc = src.row_begin(y);
+        typename View::x_iterator itDst = dst.row_begin(y);
+        // the other channels, like alpha, are kept
+        std::copy(itSrc, src.row_end(y), itDst);
+        if(_chain.nbSteps() != 0)
+        {
+            float* v = &values.front();
+            for(std::ptrdiff_t x = 0; x < src.width(); ++x, v += 3)
+            {
+                v[0] = channel_convert<bits32f>(get_color(itSrc[x], red_t()));
+                v[1] = channel_convert<bits32f>(get_color(itSrc[x], green_t()));
+                v[2] = channel_convert<bits32f>(get_color(itSrc[x], blue_t()));
+            }
+            _chain.apply(&values.front(), src.width());
+            v = &values.front();
+            for(std::ptrdiff_t x = 0; x < src.width(); ++x, v += 3)
+            {
+                if(isIntegral)
+                {
+                    for(std::size_t c = 0; c < 3; ++c)
+                        v[c] = std::min(std::max(v[c], 0.0f), 1.0f);
+                }
+                get_color(itDst[x], red_t()) = channel_convert<Channel>(bits32f(v[0]));
+                get_color(itDst[x], green_t()) = channel_convert<Channel>(bits32f(v[1]));
+                get_color(itDst[x], blue_t()) = channel_convert<Channel>(bits32f(v[2]));
+            }
+        }
+        if(this->progressForward(src.width()))
+            return;
+    }
+}
 
-    terry::colorspace_pixels_progress( &csAPI, _params._gradationIn, _params._layoutIn, _params._tempColorIn,
-    _params._gradationOut, _params._layoutOut, _params._tempColorOut, src, dst, this );
-    */
+template <class View>
+void ColorSpaceProcess<View>::processRows(const View& src, const View& dst, boost::mpl::false_)
+{
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+    {
+        std::copy(src.row_begin(y), src.row_end(y), dst.row_begin(y));
+        if(this->progressForward(src.width()))
+            return;
+    }
 }
 }
 }
@@ -37,6 +37,7 @@ void GammaPluginFactory::describe(OFX::ImageEffectDescriptor& desc)
 
     // plugin flags
     desc.setSupportsTiles(kSupportTiles);
+    desc.setPointwise(true);
     desc.setRenderThreadSafety(OFX::eRenderFullySafe);
 }
 
@@ -12,6 +12,16 @@ namespace lut
 
 static const std::string kHelp = "help";
 static const std::string kInputFilenameLabel = "3D Lut input filename";
+
+static const std::string kParamInterpolation = "interpolation";
+static const std::string kParamInterpolationTrilinear = "Trilinear";
+static const std::string kParamInterpolationTetrahedral = "Tetrahedral";
+
+enum EParamInterpolation
+{
+    eParamInterpolationTrilinear = 0,
+    eParamInterpolationTetrahedral
+};
 }
 }
 }
@@ -1,6 +1,7 @@
 #include "LutPlugin.hpp"
 #include "LutProcess.hpp"
 #include "LutDefinitions.hpp"
+#include "lutEngine/LutCache.hpp"
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/gil/gil_all.hpp>
@@ -21,6 +22,7 @@ LutPlugin::LutPlugin(OfxImageEffectHandle handle)
     : ImageEffectGilPlugin(handle)
 {
     _sFilename = fetchStringParam(kTuttlePluginFilename);
+    _paramInterpolation = fetchChoiceParam(kParamInterpolation);
 }
 
 /**
@@ -29,24 +31,14 @@ LutPlugin::LutPlugin(OfxImageEffectHandle handle)
  */
 void LutPlugin::render(const OFX::RenderArguments& args)
 {
-    if(!_lutReader.readOk())
+    std::string str;
+    _sFilename->getValue(str);
+    if(!bfs::exists(str))
     {
-        std::string str;
-        _sFilename->getValue(str);
-        if(!bfs::exists(str))
-        {
-            BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::filename(str));
-        }
-        if(!_lutReader.read(str))
-        {
-            BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read lut file."));
-        }
-        _lut3D.reset(new TetraInterpolator(), _lutReader);
-    }
-    if(!_lutReader.readOk())
-    {
-        BOOST_THROW_EXCEPTION(exception::Unknown());
+        BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::filename(str));
     }
+    // only parsed again if the file changed
+    _lut = readBakedLut(str);
     doGilRender<LutProcess>(*this, args);
 }
 
@@ -58,11 +50,7 @@ void LutPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::st
         _sFilename->getValue(str);
         if(bfs::exists(str))
         {
-            if(!_lutReader.read(str))
-            {
-                BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read lut file..."));
-            }
-            _lut3D.reset(new TetraInterpolator(), _lutReader);
+            _lut = readBakedLut(str);
         }
     }
 }
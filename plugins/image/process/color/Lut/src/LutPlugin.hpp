@@ -1,11 +1,13 @@
 #ifndef _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 #define _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "LutDefinitions.hpp"
+#include "lutEngine/BakedLut3D.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <boost/shared_ptr.hpp>
+
 namespace tuttle
 {
 namespace plugin
@@ -28,9 +30,9 @@ public:
 
 public:
     OFX::StringParam* _sFilename; ///< Filename
+    OFX::ChoiceParam* _paramInterpolation;
 
-    LutReader _lutReader; ///< Reader
-    Lut3D _lut3D;
+    boost::shared_ptr<const BakedLut3D> _lut; ///< lut of the file, shared with the other instances
 };
 }
 }
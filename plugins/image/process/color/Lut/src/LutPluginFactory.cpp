@@ -62,6 +62,13 @@ void LutPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX::
     filename->setDefault("");
     filename->setLabels(kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel);
     filename->setStringType(OFX::eStringTypeFilePath);
+
+    OFX::ChoiceParamDescriptor* interpolation = desc.defineChoiceParam(kParamInterpolation);
+    interpolation->setLabel("Interpolation");
+    interpolation->appendOption(kParamInterpolationTrilinear);
+    interpolation->appendOption(kParamInterpolationTetrahedral);
+    interpolation->setHint("Interpolation between the nodes of the lut around each color.");
+    interpolation->setDefault(eParamInterpolationTetrahedral);
 }
 
 /**
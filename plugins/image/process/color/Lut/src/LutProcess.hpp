@@ -2,8 +2,7 @@
 #define _TUTTLE_PLUGIN_LUTPROCESS_HPP_
 
 #include "LutPlugin.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "lutEngine/BakedLut3D.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
@@ -13,6 +12,8 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle
 {
@@ -27,17 +28,31 @@ namespace lut
 template <class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
+public:
+    typedef typename View::value_type Pixel;
+    typedef typename boost::gil::channel_type<View>::type Channel;
+
 private:
-    Lut3D* _lut3D;      ///< Lut3D
+    boost::shared_ptr<const BakedLut3D> _lut; ///< kept during the render, even if the plugin reads another file
+    EParamInterpolation _interpolation;
     LutPlugin& _plugin; ///< Rendering plugin
 
 public:
     LutProcess<View>(LutPlugin& instance);
 
+    void setup(const OFX::RenderArguments& args);
+
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
-    // Lut3D Transform
-    void applyLut(View& dst, View& src, const OfxRectI& procWindow);
+private:
+    /// Interpolate the rgb values of @p nbPixels pixels of Stride floats
+    template <std::size_t Stride>
+    void applyLut(float* values, const std::size_t nbPixels) const;
+
+    /// Apply the lut to the rgb channels
+    void processRows(const View& src, const View& dst, boost::mpl::true_ hasRGB);
+    /// Images without rgb channels are copied
+    void processRows(const View& src, const View& dst, boost::mpl::false_ hasRGB);
 };
 }
 }
@@ -1,12 +1,5 @@
-#if defined(_MSC_VER)
-#pragma warning(disable : 4244)
-#endif
-
 #include "LutProcess.hpp"
 #include "LutDefinitions.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
-#include "lutEngine/TetraInterpolator.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -17,7 +10,10 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
-#include <boost/filesystem/fstream.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <algorithm>
+#include <vector>
 
 namespace tuttle
 {
@@ -26,14 +22,43 @@ namespace plugin
 namespace lut
 {
 
-using namespace boost::filesystem;
+using namespace boost::gil;
+
+namespace detail
+{
+
+template <class Iterator>
+void fillOpaque(Iterator it, const std::size_t width, boost::mpl::true_)
+{
+    typedef typename channel_type<Iterator>::type Channel;
+    for(std::size_t x = 0; x < width; ++x)
+        get_color(it[x], alpha_t()) = channel_traits<Channel>::max_value();
+}
+
+template <class Iterator>
+void fillOpaque(Iterator, const std::size_t, boost::mpl::false_)
+{
+}
+}
 
 template <class View>
 LutProcess<View>::LutProcess(LutPlugin& instance)
     : ImageGilFilterProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
 {
-    _lut3D = &_plugin._lut3D;
+}
+
+template <class View>
+void LutProcess<View>::setup(const OFX::RenderArguments& args)
+{
+    ImageGilFilterProcessor<View>::setup(args);
+
+    _lut = _plugin._lut;
+    if(!_lut)
+    {
+        BOOST_THROW_EXCEPTION(exception::Unknown() << exception::user("No lut loaded."));
+    }
+    _interpolation = static_cast<EParamInterpolation>(_plugin._paramInterpolation->getValue());
 }
 
 /**
@@ -43,35 +68,76 @@ LutProcess<View>::LutProcess(LutPlugin& instance)
 template <class View>
 void LutProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates(procWindowRoW);
+    const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates(procWindowRoW);
+    const OfxPointI procWindowSize = {procWindowRoW.x2 - procWindowRoW.x1, procWindowRoW.y2 - procWindowRoW.y1};
+
+    View src = subimage_view(this->_srcView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
+    View dst = subimage_view(this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
+
+    processRows(src, dst, typename contains_color<Pixel, red_t>::type());
+}
 
-    applyLut(this->_dstView, this->_srcView, procWindowOutput);
+template <class View>
+template <std::size_t Stride>
+void LutProcess<View>::applyLut(float* values, const std::size_t nbPixels) const
+{
+    if(_interpolation == eParamInterpolationTrilinear)
+        _lut->applyTrilinear<Stride>(values, nbPixels);
+    else
+        _lut->applyTetrahedral<Stride>(values, nbPixels);
 }
 
 template <class View>
-void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow)
+void LutProcess<View>::processRows(const View& src, const View& dst, boost::mpl::true_)
 {
-    using namespace terry;
-    typedef typename View::x_iterator vIterator;
-    typedef typename channel_type<View>::type Pixel;
-    const OfxPointI procWindowSize = {procWindow.x2 - procWindow.x1, procWindow.y2 - procWindow.y1};
+    static const std::size_t nbChannels = num_channels<View>::value;
+    // interleaved float pixels are interpolated in place, the others through a row of float rgb values
+    static const bool inPlace =
+        boost::is_same<Pixel, rgba32f_pixel_t>::value || boost::is_same<Pixel, rgb32f_pixel_t>::value;
+    const std::size_t width = src.width();
+    std::vector<float> values(inPlace ? 0 : 3 * width);
 
-    for(int y = procWindow.y1; y < procWindow.y2; ++y)
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
     {
-        vIterator sit = src.row_begin(y);
-        vIterator dit = dst.row_begin(y);
-        for(int x = procWindow.x1; x < procWindow.x2; ++x)
+        typename View::x_iterator itSrc = src.row_begin(y);
+        typename View::x_iterator itDst = dst.row_begin(y);
+        std::copy(itSrc, src.row_end(y), itDst);
+        if(inPlace)
+        {
+            applyLut<nbChannels>(reinterpret_cast<float*>(&(*itDst)), width);
+        }
+        else
         {
-            tuttle::Color col = _lut3D->getColor((*sit)[0], (*sit)[1], (*sit)[2]);
-            (*dit)[0] = static_cast<Pixel>(col.x);
-            (*dit)[1] = static_cast<Pixel>(col.y);
-            (*dit)[2] = static_cast<Pixel>(col.z);
-            if(dst.num_channels() > 3)
-                (*dit)[3] = channel_traits<typename channel_type<View>::type>::max_value();
-            ++sit;
-            ++dit;
+            float* v = &values.front();
+            for(std::size_t x = 0; x < width; ++x, v += 3)
+            {
+                v[0] = channel_convert<bits32f>(get_color(itSrc[x], red_t()));
+                v[1] = channel_convert<bits32f>(get_color(itSrc[x], green_t()));
+                v[2] = channel_convert<bits32f>(get_color(itSrc[x], blue_t()));
+            }
+            applyLut<3>(&values.front(), width);
+            v = &values.front();
+            for(std::size_t x = 0; x < width; ++x, v += 3)
+            {
+                // the lut values are within [0, 1]
+                get_color(itDst[x], red_t()) = channel_convert<Channel>(bits32f(v[0]));
+                get_color(itDst[x], green_t()) = channel_convert<Channel>(bits32f(v[1]));
+                get_color(itDst[x], blue_t()) = channel_convert<Channel>(bits32f(v[2]));
+            }
         }
-        if(this->progressForward(procWindowSize.x))
+        detail::fillOpaque(itDst, width, typename contains_color<Pixel, alpha_t>::type());
+        if(this->progressForward(width))
+            return;
+    }
+}
+
+template <class View>
+void LutProcess<View>::processRows(const View& src, const View& dst, boost::mpl::false_)
+{
+    for(std::ptrdiff_t y = 0; y < src.height(); ++y)
+    {
+        std::copy(src.row_begin(y), src.row_end(y), dst.row_begin(y));
+        if(this->progressForward(src.width()))
             return;
     }
 }
@@ -0,0 +1,39 @@
+#include "BakedLut3D.hpp"
+
+#include <tuttle/plugin/exceptions.hpp>
+
+namespace tuttle
+{
+
+BakedLut3D::BakedLut3D(const AbstractLut& lut)
+    : _dimSize(lut.dimSize())
+    , _maxIndex(float(lut.dimSize()) - 1.0f)
+    , _simd(terry::simd_level() != terry::eSimdNone)
+{
+    if(_dimSize < 2)
+    {
+        BOOST_THROW_EXCEPTION(plugin::exception::File() << plugin::exception::user("The lut needs at least 2 values by "
+                                                                                   "dimension."));
+    }
+    _strides[2] = nodeSize;
+    _strides[1] = _strides[2] * _dimSize;
+    _strides[0] = _strides[1] * _dimSize;
+    _nodes.resize(_dimSize * _dimSize * _dimSize * nodeSize);
+
+    float* node = &_nodes.front();
+    for(std::size_t r = 0; r < _dimSize; ++r)
+    {
+        for(std::size_t g = 0; g < _dimSize; ++g)
+        {
+            for(std::size_t b = 0; b < _dimSize; ++b, node += nodeSize)
+            {
+                const Color color = lut.getIndexedColor(r, g, b);
+                node[0] = float(color.x);
+                node[1] = float(color.y);
+                node[2] = float(color.z);
+                node[3] = 0.0f;
+            }
+        }
+    }
+}
+}
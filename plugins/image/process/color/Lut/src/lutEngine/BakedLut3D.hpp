@@ -0,0 +1,190 @@
+#ifndef _LUTENGINE_BAKEDLUT3D_HPP_
+#define _LUTENGINE_BAKEDLUT3D_HPP_
+
+#include "AbstractLut.hpp"
+
+#include <terry/simd.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tuttle
+{
+
+/**
+ * @brief Cube of a 3D lut converted to float for the rendering.
+ *
+ * The nodes are contiguous with the blue index varying first, like the 3dl files, and each node is padded to
+ * 4 floats so its red, green and blue values are loaded as one vector.
+ * The interpolations are applied to rows of interleaved values without virtual calls: the values are clamped
+ * to [0, 1], and the nodes of a pixel are blended with SSE when the CPU allows it.
+ */
+class BakedLut3D
+{
+public:
+    static const std::size_t nodeSize = 4;
+
+    explicit BakedLut3D(const AbstractLut& lut);
+
+    std::size_t dimSize() const { return _dimSize; }
+
+    /**
+     * @brief Trilinear interpolation of the 8 nodes around each value.
+     * @param[in, out] values red, green and blue values of the pixels, each pixel using Stride floats
+     */
+    template <std::size_t Stride>
+    void applyTrilinear(float* values, const std::size_t nbPixels) const;
+
+    /**
+     * @brief Tetrahedral interpolation of the 4 nodes of the tetrahedron around each value,
+     * same as TetraInterpolator.
+     * @param[in, out] values red, green and blue values of the pixels, each pixel using Stride floats
+     */
+    template <std::size_t Stride>
+    void applyTetrahedral(float* values, const std::size_t nbPixels) const;
+
+private:
+    /// Index of the lower node in one dimension, and the fraction toward the upper node
+    void locate(const float value, std::size_t& index, float& fraction) const
+    {
+        // NaN gives 0
+        const float v = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+        const float position = v * _maxIndex;
+        index = std::size_t(position);
+        if(index > _dimSize - 2)
+            index = _dimSize - 2;
+        fraction = position - float(index);
+    }
+
+    template <std::size_t N>
+    void blend(const float* const* nodes, const float* weights, float* dst) const;
+
+private:
+    std::size_t _dimSize;
+    float _maxIndex;
+    std::ptrdiff_t _strides[3]; ///< offset between two nodes along red, green and blue
+    std::vector<float> _nodes;
+    bool _simd;
+};
+
+template <std::size_t N>
+void BakedLut3D::blend(const float* const* nodes, const float* weights, float* dst) const
+{
+#ifdef TERRY_SIMD_X86
+    if(_simd)
+    {
+        __m128 acc = _mm_mul_ps(_mm_set1_ps(weights[0]), _mm_loadu_ps(nodes[0]));
+        for(std::size_t k = 1; k < N; ++k)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(nodes[k])));
+        float result[4];
+        _mm_storeu_ps(result, acc);
+        dst[0] = result[0];
+        dst[1] = result[1];
+        dst[2] = result[2];
+        return;
+    }
+#endif
+    float r = 0.0f, g = 0.0f, b = 0.0f;
+    for(std::size_t k = 0; k < N; ++k)
+    {
+        r += weights[k] * nodes[k][0];
+        g += weights[k] * nodes[k][1];
+        b += weights[k] * nodes[k][2];
+    }
+    dst[0] = r;
+    dst[1] = g;
+    dst[2] = b;
+}
+
+template <std::size_t Stride>
+void BakedLut3D::applyTrilinear(float* values, const std::size_t nbPixels) const
+{
+    const std::ptrdiff_t sr = _strides[0];
+    const std::ptrdiff_t sg = _strides[1];
+    const std::ptrdiff_t sb = _strides[2];
+    for(float* const end = values + Stride * nbPixels; values != end; values += Stride)
+    {
+        std::size_t ir, ig, ib;
+        float dr, dg, db;
+        locate(values[0], ir, dr);
+        locate(values[1], ig, dg);
+        locate(values[2], ib, db);
+
+        const float* n000 = &_nodes[ir * sr + ig * sg + ib * sb];
+        const float* nodes[8] = {n000,      n000 + sb,      n000 + sg,      n000 + sg + sb,
+                                 n000 + sr, n000 + sr + sb, n000 + sr + sg, n000 + sr + sg + sb};
+        const float er = 1.0f - dr;
+        const float eg = 1.0f - dg;
+        const float eb = 1.0f - db;
+        const float weights[8] = {er * eg * eb, er * eg * db, er * dg * eb, er * dg * db,
+                                  dr * eg * eb, dr * eg * db, dr * dg * eb, dr * dg * db};
+        blend<8>(nodes, weights, values);
+    }
+}
+
+template <std::size_t Stride>
+void BakedLut3D::applyTetrahedral(float* values, const std::size_t nbPixels) const
+{
+    const std::ptrdiff_t sr = _strides[0];
+    const std::ptrdiff_t sg = _strides[1];
+    const std::ptrdiff_t sb = _strides[2];
+    for(float* const end = values + Stride * nbPixels; values != end; values += Stride)
+    {
+        std::size_t ir, ig, ib;
+        float dr, dg, db;
+        locate(values[0], ir, dr);
+        locate(values[1], ig, dg);
+        locate(values[2], ib, db);
+
+        // the tetrahedron goes from the lower node to the upper one, along the dimensions sorted by fraction
+        const float* n000 = &_nodes[ir * sr + ig * sg + ib * sb];
+        const float* nodes[4] = {n000, n000, n000, n000 + sr + sg + sb};
+        float weights[4];
+        if(dr >= dg)
+        {
+            if(dg >= db)
+            {
+                nodes[1] += sr;
+                nodes[2] += sr + sg;
+                weights[0] = 1.0f - dr, weights[1] = dr - dg, weights[2] = dg - db, weights[3] = db;
+            }
+            else if(dr >= db)
+            {
+                nodes[1] += sr;
+                nodes[2] += sr + sb;
+                weights[0] = 1.0f - dr, weights[1] = dr - db, weights[2] = db - dg, weights[3] = dg;
+            }
+            else
+            {
+                nodes[1] += sb;
+                nodes[2] += sr + sb;
+                weights[0] = 1.0f - db, weights[1] = db - dr, weights[2] = dr - dg, weights[3] = dg;
+            }
+        }
+        else
+        {
+            if(dr >= db)
+            {
+                nodes[1] += sg;
+                nodes[2] += sr + sg;
+                weights[0] = 1.0f - dg, weights[1] = dg - dr, weights[2] = dr - db, weights[3] = db;
+            }
+            else if(dg >= db)
+            {
+                nodes[1] += sg;
+                nodes[2] += sg + sb;
+                weights[0] = 1.0f - dg, weights[1] = dg - db, weights[2] = db - dr, weights[3] = dr;
+            }
+            else
+            {
+                nodes[1] += sb;
+                nodes[2] += sg + sb;
+                weights[0] = 1.0f - db, weights[1] = db - dg, weights[2] = dg - dr, weights[3] = dr;
+            }
+        }
+        blend<4>(nodes, weights, values);
+    }
+}
+}
+
+#endif
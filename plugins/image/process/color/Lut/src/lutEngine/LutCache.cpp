@@ -0,0 +1,59 @@
+#include "LutCache.hpp"
+#include "LutReader.hpp"
+#include "Lut.hpp"
+
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ctime>
+#include <map>
+#include <string>
+
+namespace tuttle
+{
+
+namespace
+{
+
+struct CachedLut
+{
+    std::time_t _lastWriteTime;
+    boost::shared_ptr<const BakedLut3D> _lut;
+};
+
+boost::mutex cacheMutex;
+std::map<std::string, CachedLut> cache;
+}
+
+boost::shared_ptr<const BakedLut3D> readBakedLut(const boost::filesystem::path& filename)
+{
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time(filename);
+
+    boost::mutex::scoped_lock lock(cacheMutex);
+    CachedLut& cached = cache[filename.string()];
+    if(cached._lut && cached._lastWriteTime == lastWriteTime)
+        return cached._lut;
+
+    LutReader reader;
+    if(!reader.read(filename))
+    {
+        BOOST_THROW_EXCEPTION(plugin::exception::File() << plugin::exception::user("Unable to read lut file.")
+                                                        << plugin::exception::filename(filename.string()));
+    }
+    const std::size_t dimSize = reader.steps().size();
+    if(reader.data().size() != dimSize * dimSize * dimSize * 3)
+    {
+        BOOST_THROW_EXCEPTION(plugin::exception::File()
+                              << plugin::exception::user("The number of values doesn't match the size of the lut.")
+                              << plugin::exception::filename(filename.string()));
+    }
+    Lut3D lut3D;
+    lut3D.reset(reader);
+
+    cached._lut.reset(new BakedLut3D(lut3D));
+    cached._lastWriteTime = lastWriteTime;
+    return cached._lut;
+}
+}
@@ -0,0 +1,19 @@
+#ifndef _LUTENGINE_LUTCACHE_HPP_
+#define _LUTENGINE_LUTCACHE_HPP_
+
+#include "BakedLut3D.hpp"
+
+#include <boost/filesystem/path.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tuttle
+{
+
+/**
+ * @brief Baked lut of a 3dl file, shared by all the instances.
+ * The file is parsed only the first time, or again when its last write time changed.
+ */
+boost::shared_ptr<const BakedLut3D> readBakedLut(const boost::filesystem::path& filename);
+}
+
+#endif
@@ -3,13 +3,95 @@
 #define BOOST_TEST_MODULE test_plugin_lut
 #include <boost/test/unit_test.hpp>
 
-BOOST_AUTO_TEST_SUITE(plugin_lut)
+// the lut engine is built into the plugin, not into a library
+#include "../../src/lutEngine/AbstractLut.cpp"
+#include "../../src/lutEngine/BakedLut3D.cpp"
+#include "../../src/lutEngine/Lut.cpp"
+#include "../../src/lutEngine/LutReader.cpp"
+#include "../../src/lutEngine/TetraInterpolator.cpp"
+#include "../../src/lutEngine/TrilinInterpolator.cpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 using namespace boost::unit_test;
+using namespace tuttle;
+
+namespace
+{
+
+/// Rgb values in [0, 1), not aligned on the nodes of the cube
+std::vector<float> testValues()
+{
+    std::vector<float> values;
+    const int nbSteps = 23;
+    for(int r = 0; r < nbSteps; ++r)
+        for(int g = 0; g < nbSteps; ++g)
+            for(int b = 0; b < nbSteps; ++b)
+            {
+                values.push_back(r / float(nbSteps));
+                values.push_back(g / float(nbSteps));
+                values.push_back(b / float(nbSteps));
+            }
+    return values;
+}
+
+/// Largest difference between the baked interpolation of the values and the interpolator of the lut
+template <class BakedApply>
+double maxDifference(const AbstractLut& lut, const Interpolator& interpolator, BakedApply apply)
+{
+    const BakedLut3D baked(lut);
+    const std::vector<float> src = testValues();
+    std::vector<float> dst = src;
+    (baked.*apply)(&dst.front(), dst.size() / 3);
+
+    double maxDiff = 0.0;
+    for(std::size_t i = 0; i < src.size(); i += 3)
+    {
+        const Color expected = interpolator.interpolate(&lut, src[i], src[i + 1], src[i + 2]);
+        maxDiff = std::max(maxDiff, std::fabs(dst[i] - expected.x));
+        maxDiff = std::max(maxDiff, std::fabs(dst[i + 1] - expected.y));
+        maxDiff = std::max(maxDiff, std::fabs(dst[i + 2] - expected.z));
+    }
+    return maxDiff;
+}
+
+void checkInterpolations(const AbstractLut& lut)
+{
+    BOOST_CHECK_SMALL(maxDifference(lut, TrilinInterpolator(), &BakedLut3D::applyTrilinear<3>), 1e-5);
+    BOOST_CHECK_SMALL(maxDifference(lut, TetraInterpolator(), &BakedLut3D::applyTetrahedral<3>), 1e-5);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(plugin_lut)
+
+BOOST_AUTO_TEST_CASE(baked_lut_3dl_file)
+{
+    LutReader reader;
+    BOOST_REQUIRE(reader.read(boost::filesystem::path(__FILE__).parent_path() / "ident.3dl"));
+    Lut3D lut;
+    lut.reset(reader); // the values stay owned by the reader
+    checkInterpolations(lut);
+}
 
-BOOST_AUTO_TEST_CASE(plugin_lut_test_01)
+BOOST_AUTO_TEST_CASE(baked_lut_non_identity)
 {
-    BOOST_CHECK_EQUAL(1.0, 1.0);
+    const std::size_t dimSize = 9;
+    Lut3D lut(new TrilinInterpolator(), dimSize);
+    for(std::size_t r = 0; r < dimSize; ++r)
+        for(std::size_t g = 0; g < dimSize; ++g)
+            for(std::size_t b = 0; b < dimSize; ++b)
+            {
+                const double x = r / (dimSize - 1.0);
+                const double y = g / (dimSize - 1.0);
+                const double z = b / (dimSize - 1.0);
+                lut.setIndexedValues(r, g, b, x * x, std::sqrt(y) * (1.0 - 0.5 * z),
+                                     0.5 + 0.5 * std::sin(3.0 * x + y - z));
+            }
+    checkInterpolations(lut);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
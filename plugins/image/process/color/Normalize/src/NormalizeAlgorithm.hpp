@@ -7,7 +7,8 @@
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/minmax.hpp>
-#include <terry/algorithm/transform_pixels_progress.hpp>
+
+#include <tuttle/plugin/ReduceProcessor.hpp>
 
 namespace tuttle
 {
@@ -26,7 +27,7 @@ void analyseChannel(View& src, typename View::value_type& min, typename View::va
     typedef channel_view_type<LocalChannel, View> LocalView;
     typename LocalView::type localView(LocalView::make(src));
     pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-    transform_pixels_progress(localView, minmax, p);
+    minmax = reducePixelsMultiThread(localView, minmax, p);
     static_fill(min, minmax.min[0]);
     static_fill(max, minmax.max[0]);
 }
@@ -54,8 +55,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -66,7 +66,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef typename color_converted_view_type<View, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<typename LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -76,7 +76,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<red_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -86,7 +86,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<green_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -96,7 +96,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<blue_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -106,7 +106,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<alpha_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -117,7 +117,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
 template <>
 void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalyseMode analyseMode,
                         boost::gil::rgb32f_view_t::value_type& min, boost::gil::rgb32f_view_t::value_type& max,
-                        IProgress& progress)
+                        IProgress& p)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -130,8 +130,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, progress);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -142,7 +141,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef color_converted_view_type<rgb32f_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -152,7 +151,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef channel_view_type<red_t, rgb32f_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -162,7 +161,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef channel_view_type<green_t, rgb32f_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -172,7 +171,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef channel_view_type<blue_t, rgb32f_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -189,7 +188,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
 template <>
 void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyseMode analyseMode,
                         boost::gil::rgb16_view_t::value_type& min, boost::gil::rgb16_view_t::value_type& max,
-                        IProgress& progress)
+                        IProgress& p)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -202,8 +201,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, progress);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -214,7 +212,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef color_converted_view_type<rgb16_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -224,7 +222,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef channel_view_type<red_t, rgb16_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -234,7 +232,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef channel_view_type<green_t, rgb16_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -244,7 +242,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef channel_view_type<blue_t, rgb16_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -273,8 +271,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -285,7 +282,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef color_converted_view_type<rgb8_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -295,7 +292,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef channel_view_type<red_t, rgb8_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -305,7 +302,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef channel_view_type<green_t, rgb8_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -315,7 +312,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef channel_view_type<blue_t, rgb8_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -345,8 +342,7 @@ void analyseInputMinMax(const boost::gil::gray32f_view_t& src, const EParamAnaly
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -357,7 +353,7 @@ void analyseInputMinMax(const boost::gil::gray32f_view_t& src, const EParamAnaly
             typedef color_converted_view_type<gray32f_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -389,8 +385,7 @@ void analyseInputMinMax(const boost::gil::gray16_view_t& src, const EParamAnalys
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -401,7 +396,7 @@ void analyseInputMinMax(const boost::gil::gray16_view_t& src, const EParamAnalys
             typedef color_converted_view_type<gray16_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -433,8 +428,7 @@ void analyseInputMinMax(const boost::gil::gray8_view_t& src, const EParamAnalyse
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reducePixelsMultiThread(src, minmax, p);
             min = minmax.min;
             max = minmax.max;
             break;
@@ -445,7 +439,7 @@ void analyseInputMinMax(const boost::gil::gray8_view_t& src, const EParamAnalyse
             typedef color_converted_view_type<gray8_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reducePixelsMultiThread(localView, minmax, p);
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -1,6 +1,8 @@
 #include "OCIOColorSpacePlugin.hpp"
 #include "OCIOColorSpaceProcess.hpp"
 
+#include <common/OCIOProcessorCache.hpp>
+
 #include <tuttle/common/utils/color.hpp>
 
 #include <boost/filesystem/operations.hpp>
@@ -120,8 +122,9 @@ OCIOColorSpaceProcessParams OCIOColorSpacePlugin::getProcessParams(const OfxPoin
         BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::filename(str));
     }
 
-    // Get the OCIO configuration processor.
-    params._config = OCIO::Config::CreateFromFile(str.c_str());
+    // Get the OCIO configuration, only read again if the file changed.
+    params._configFilename = str;
+    params._config = getConfig(str);
 
     int index;
     _paramInputSpace->getValue(index);
@@ -3,6 +3,8 @@
 
 #include "OCIOColorSpacePlugin.hpp"
 
+#include <common/OCIOProcessorCache.hpp>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include <tuttle/plugin/global.hpp>
@@ -35,16 +37,13 @@ private:
     OCIOColorSpacePlugin& _plugin;       ///< Rendering plugin
     OCIOColorSpaceProcessParams _params; ///< parameters
 
-    OCIO::ConstConfigRcPtr _config;
+    OCIO::ConstProcessorRcPtr _processor; ///< shared with the other frames and instances
 
 public:
     OCIOColorSpaceProcess<View>(OCIOColorSpacePlugin& instance);
     void setup(const OFX::RenderArguments& args);
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
-
-    // Lut Transform
-    void applyLut(View& dst, View& src);
 };
 }
 }
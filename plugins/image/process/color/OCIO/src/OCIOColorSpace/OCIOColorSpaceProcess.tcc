@@ -36,11 +36,7 @@ void OCIOColorSpaceProcess<View>::setup(const OFX::RenderArguments& args)
 
     try
     {
-        // Load the current config.
-        _config = _params._config;
-
-        // Try to load the processor
-        _config->getProcessor(_params._inputSpace.c_str(), _params._outputSpace.c_str());
+        _processor = getColorSpaceProcessor(_params._configFilename, _params._inputSpace, _params._outputSpace);
     }
     catch(OCIO::Exception& exception)
     {
@@ -62,41 +58,9 @@ void OCIOColorSpaceProcess<View>::multiThreadProcessImages(const OfxRectI& procW
     View src = subimage_view(this->_srcView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
     View dst = subimage_view(this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
 
-    applyLut(dst, src);
-}
-
-template <class View>
-void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src)
-{
-    using namespace boost::gil;
-    typedef typename View::x_iterator vIterator;
-    typedef typename channel_type<View>::type Pixel;
-
-    copy_pixels(src, dst);
-
     try
     {
-        OCIO::ConstProcessorRcPtr processor =
-            _config->getProcessor(_params._inputSpace.c_str(), _params._outputSpace.c_str());
-
-        if(is_planar<View>::value)
-        {
-            BOOST_THROW_EXCEPTION(exception::NotImplemented());
-        }
-        else
-        {
-            for(std::size_t y = 0; y < (unsigned int)dst.height(); ++y)
-            {
-                // Wrap the image in a light-weight ImageDescription
-                OCIO::PackedImageDesc imageDesc((float*)&(dst(0, y)[0]), dst.width(), 1, num_channels<View>::type::value,
-                                                OCIO::AutoStride, dst.pixels().pixel_size(), dst.pixels().row_size());
-                // Apply the color transformation (in place)
-                // Need normalized values
-                processor->apply(imageDesc);
-                if(this->progressForward(dst.width()))
-                    return;
-            }
-        }
+        applyProcessor(_processor, src, dst, *this);
     }
     catch(OCIO::Exception& exception)
     {
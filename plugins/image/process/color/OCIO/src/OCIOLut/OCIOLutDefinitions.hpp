@@ -29,9 +29,6 @@ enum EInterpolationType
     eInterpolationTypeTetrahedral = 2,
 
 };
-
-static const std::string kOCIOInputspace = "RawInput";
-static const std::string kOCIOOutputspace = "ProcessedOutput";
 }
 }
 }
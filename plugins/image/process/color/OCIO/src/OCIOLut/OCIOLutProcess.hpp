@@ -3,6 +3,8 @@
 
 #include "OCIOLutPlugin.hpp"
 
+#include <common/OCIOProcessorCache.hpp>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include <tuttle/plugin/global.hpp>
@@ -35,18 +37,13 @@ private:
     OCIOLutPlugin& _plugin;       ///< Rendering plugin
     OCIOLutProcessParams _params; ///< parameters
 
-    OCIO::FileTransformRcPtr fileTransform;
-    OCIO::GroupTransformRcPtr groupTransform;
-    OCIO::ConfigRcPtr config;
+    OCIO::ConstProcessorRcPtr _processor; ///< shared with the other frames and instances
 
 public:
     OCIOLutProcess<View>(OCIOLutPlugin& instance);
     void setup(const OFX::RenderArguments& args);
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
-
-    // Lut Transform
-    void applyLut(View& dst, View& src);
 };
 }
 }
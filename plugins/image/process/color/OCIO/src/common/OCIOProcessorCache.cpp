@@ -0,0 +1,118 @@
+#include "OCIOProcessorCache.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ctime>
+#include <map>
+#include <sstream>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace ocio
+{
+
+namespace
+{
+
+struct CachedConfig
+{
+    std::time_t _lastWriteTime;
+    OCIO::ConstConfigRcPtr _config;
+};
+
+struct CachedProcessor
+{
+    std::time_t _lastWriteTime;
+    OCIO::ConstProcessorRcPtr _processor;
+};
+
+boost::mutex cacheMutex;
+std::map<std::string, CachedConfig> configs;
+std::map<std::string, CachedProcessor> processors;
+
+/// Config of a file, the cache mutex locked
+OCIO::ConstConfigRcPtr getConfigLocked(const std::string& filename, const std::time_t lastWriteTime)
+{
+    CachedConfig& cached = configs[filename];
+    if(!cached._config || cached._lastWriteTime != lastWriteTime)
+    {
+        cached._config = OCIO::Config::CreateFromFile(filename.c_str());
+        cached._lastWriteTime = lastWriteTime;
+    }
+    return cached._config;
+}
+}
+
+OCIO::ConstConfigRcPtr getConfig(const std::string& filename)
+{
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time(filename);
+    boost::mutex::scoped_lock lock(cacheMutex);
+    return getConfigLocked(filename, lastWriteTime);
+}
+
+OCIO::ConstProcessorRcPtr getColorSpaceProcessor(const std::string& configFilename, const std::string& inputSpace,
+                                                 const std::string& outputSpace)
+{
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time(configFilename);
+    boost::mutex::scoped_lock lock(cacheMutex);
+    const OCIO::ConstConfigRcPtr config = getConfigLocked(configFilename, lastWriteTime);
+
+    // the context depends on the environment, like the shot of the sequence
+    std::ostringstream key;
+    key << "colorspace\n" << configFilename << "\n" << inputSpace << "\n" << outputSpace << "\n"
+        << config->getCurrentContext()->getCacheID();
+    CachedProcessor& cached = processors[key.str()];
+    if(!cached._processor || cached._lastWriteTime != lastWriteTime)
+    {
+        cached._processor = config->getProcessor(inputSpace.c_str(), outputSpace.c_str());
+        cached._lastWriteTime = lastWriteTime;
+    }
+    return cached._processor;
+}
+
+OCIO::ConstProcessorRcPtr getFileTransformProcessor(const std::string& filename, const OCIO::Interpolation interpolation)
+{
+    static const char* inputSpace = "RawInput";
+    static const char* outputSpace = "ProcessedOutput";
+
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time(filename);
+    boost::mutex::scoped_lock lock(cacheMutex);
+
+    std::ostringstream key;
+    key << "file\n" << filename << "\n" << int(interpolation);
+    CachedProcessor& cached = processors[key.str()];
+    if(!cached._processor || cached._lastWriteTime != lastWriteTime)
+    {
+        OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+        fileTransform->setSrc(filename.c_str());
+        fileTransform->setInterpolation(interpolation);
+
+        // Add the file transform to the group, required by the transform process
+        OCIO::GroupTransformRcPtr groupTransform = OCIO::GroupTransform::Create();
+        groupTransform->push_back(fileTransform);
+        TUTTLE_LOG_INFO("Specified Transform:" << *(groupTransform));
+
+        OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+        OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
+        inputColorSpace->setName(inputSpace);
+        config->addColorSpace(inputColorSpace);
+
+        OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
+        outputColorSpace->setName(outputSpace);
+        outputColorSpace->setTransform(groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+        config->addColorSpace(outputColorSpace);
+
+        cached._processor = config->getProcessor(inputSpace, outputSpace);
+        cached._lastWriteTime = lastWriteTime;
+    }
+    return cached._processor;
+}
+}
+}
+}
@@ -0,0 +1,84 @@
+#ifndef _TUTTLE_PLUGIN_OCIOPROCESSORCACHE_HPP_
+#define _TUTTLE_PLUGIN_OCIOPROCESSORCACHE_HPP_
+
+#include <tuttle/plugin/IProgress.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace ocio
+{
+
+namespace OCIO = OCIO_NAMESPACE;
+
+/**
+ * @brief Config of a file, read again only when the file changed.
+ */
+OCIO::ConstConfigRcPtr getConfig(const std::string& filename);
+
+/**
+ * @brief Processor from the color space @p inputSpace to @p outputSpace of the config file,
+ * created once for all the frames and instances, for each config file, color spaces and context.
+ */
+OCIO::ConstProcessorRcPtr getColorSpaceProcessor(const std::string& configFilename, const std::string& inputSpace,
+                                                 const std::string& outputSpace);
+
+/**
+ * @brief Processor of a lut file, created once until the file changes.
+ */
+OCIO::ConstProcessorRcPtr getFileTransformProcessor(const std::string& filename, const OCIO::Interpolation interpolation);
+
+/// Number of bytes of the rows processed at once, to stay in the cache between the copy and the transform
+static const std::size_t kOCIOTileBytes = 256 * 1024;
+
+/**
+ * @brief Copy @p src into @p dst and apply the processor in place, by tiles of rows.
+ * Each tile is transformed just after its copy, while it is still in the cache.
+ * @return false if the process was aborted
+ */
+template <class View>
+bool applyProcessor(const OCIO::ConstProcessorRcPtr& processor, const View& src, const View& dst,
+                    IProgress& progress)
+{
+    using namespace boost::gil;
+    BOOST_STATIC_ASSERT((boost::is_same<typename channel_type<View>::type, bits32f>::value));
+    if(is_planar<View>::value)
+    {
+        BOOST_THROW_EXCEPTION(exception::NotImplemented());
+    }
+    const std::ptrdiff_t rowBytes = dst.width() * sizeof(typename View::value_type);
+    const std::ptrdiff_t tileHeight =
+        std::max(std::ptrdiff_t(1), std::ptrdiff_t(kOCIOTileBytes) / std::max(rowBytes, std::ptrdiff_t(1)));
+
+    for(std::ptrdiff_t y = 0; y < dst.height(); y += tileHeight)
+    {
+        const std::ptrdiff_t height = std::min(tileHeight, dst.height() - y);
+        copy_pixels(subimage_view(src, 0, y, src.width(), height), subimage_view(dst, 0, y, dst.width(), height));
+
+        // Wrap the tile in a light-weight ImageDescription and apply the color transformation in place
+        OCIO::PackedImageDesc imageDesc(reinterpret_cast<float*>(&dst(0, y)[0]), dst.width(), height,
+                                        num_channels<View>::value, OCIO::AutoStride, dst.pixels().pixel_size(),
+                                        dst.pixels().row_size());
+        processor->apply(imageDesc);
+        if(progress.progressForward(dst.width() * height))
+            return false;
+    }
+    return true;
+}
+}
+}
+}
+
+#endif
@@ -27,6 +27,16 @@ enum EParamBorder
     eParamBorderPadded
 };
 
+static const std::string kParamAlgorithm = "algorithm";
+static const std::string kParamAlgorithmConvolution = "Convolution";
+static const std::string kParamAlgorithmBoxCascade = "Box cascade";
+
+enum EParamAlgorithm
+{
+    eParamAlgorithmConvolution = 0,
+    eParamAlgorithmBoxCascade
+};
+
 static const std::string kParamGroupAdvanced = "advanced";
 static const std::string kParamNormalizedKernel = "normalizedKernel";
 static const std::string kParamKernelEpsilon = "kernelEpsilon";
@@ -18,6 +18,7 @@ BlurPlugin::BlurPlugin(OfxImageEffectHandle handle)
 {
     _paramSize = fetchDouble2DParam(kParamSize);
     _paramBorder = fetchChoiceParam(kParamBorder);
+    _paramAlgorithm = fetchChoiceParam(kParamAlgorithm);
     _paramNormalizedKernel = fetchBooleanParam(kParamNormalizedKernel);
     _paramKernelEpsilon = fetchDoubleParam(kParamKernelEpsilon);
 }
@@ -29,6 +30,7 @@ BlurProcessParams<BlurPlugin::Scalar> BlurPlugin::getProcessParams(const OfxPoin
     BlurProcessParams<Scalar> params;
     params._size = ofxToGil(_paramSize->getValue()) * ofxToGil(renderScale);
     params._border = static_cast<EParamBorder>(_paramBorder->getValue());
+    params._algorithm = static_cast<EParamAlgorithm>(_paramAlgorithm->getValue());
 
     const bool normalizedKernel = _paramNormalizedKernel->getValue();
     const double kernelEpsilon = _paramKernelEpsilon->getValue();
@@ -36,6 +38,10 @@ BlurProcessParams<BlurPlugin::Scalar> BlurPlugin::getProcessParams(const OfxPoin
     params._gilKernelX = buildGaussian1DKernel<Scalar>(params._size.x, normalizedKernel, kernelEpsilon);
     params._gilKernelY = buildGaussian1DKernel<Scalar>(params._size.y, normalizedKernel, kernelEpsilon);
 
+    // the size is the variance of the gaussian, as in buildGaussian1DKernel
+    params._boxX = extended_box(params._size.x);
+    params._boxY = extended_box(params._size.y);
+
     params._boundary_option = convolve_option_extend_mirror;
     switch(params._border)
     {
@@ -105,10 +111,20 @@ void BlurPlugin::getRegionsOfInterest(const OFX::RegionsOfInterestArguments& arg
     OfxRectD srcRod = _clipSrc->getCanonicalRod(args.time);
 
     OfxRectD srcRoi;
-    srcRoi.x1 = srcRod.x1 - params._gilKernelX.left_size();
-    srcRoi.y1 = srcRod.y1 - params._gilKernelY.left_size();
-    srcRoi.x2 = srcRod.x2 + params._gilKernelX.right_size();
-    srcRoi.y2 = srcRod.y2 + params._gilKernelY.right_size();
+    if(params._algorithm == eParamAlgorithmBoxCascade)
+    {
+        srcRoi.x1 = srcRod.x1 - params._boxX.margin();
+        srcRoi.y1 = srcRod.y1 - params._boxY.margin();
+        srcRoi.x2 = srcRod.x2 + params._boxX.margin();
+        srcRoi.y2 = srcRod.y2 + params._boxY.margin();
+    }
+    else
+    {
+        srcRoi.x1 = srcRod.x1 - params._gilKernelX.left_size();
+        srcRoi.y1 = srcRod.y1 - params._gilKernelY.left_size();
+        srcRoi.x2 = srcRod.x2 + params._gilKernelX.right_size();
+        srcRoi.y2 = srcRod.y2 + params._gilKernelY.right_size();
+    }
     rois.setRegionOfInterest(*_clipSrc, srcRoi);
 }
 
@@ -5,6 +5,7 @@
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/boxBlur.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -22,9 +23,19 @@ struct BlurProcessParams
     terry::point2<double> _size;
     EParamBorder _border;
     terry::filter::convolve_boundary_option _boundary_option;
+    EParamAlgorithm _algorithm;
 
     Kernel _gilKernelX;
     Kernel _gilKernelY;
+
+    terry::filter::extended_box _boxX;
+    terry::filter::extended_box _boxY;
+
+    BlurProcessParams()
+        : _boxX(0)
+        , _boxY(0)
+    {
+    }
 };
 
 /**
@@ -51,6 +62,7 @@ public:
 public:
     OFX::Double2DParam* _paramSize;
     OFX::ChoiceParam* _paramBorder;
+    OFX::ChoiceParam* _paramAlgorithm;
     OFX::BooleanParam* _paramNormalizedKernel;
     OFX::DoubleParam* _paramKernelEpsilon;
 };
@@ -96,13 +96,22 @@ void BlurPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX:
     border->appendOption(kParamBorderPadded);
     border->setDefault(eParamBorderMirror);
 
+    OFX::ChoiceParamDescriptor* algorithm = desc.defineChoiceParam(kParamAlgorithm);
+    algorithm->setLabel("Algorithm");
+    algorithm->appendOption(kParamAlgorithmConvolution);
+    algorithm->appendOption(kParamAlgorithmBoxCascade);
+    algorithm->setHint("Convolution: gaussian kernel, the cost grows with the size.\n"
+                       "Box cascade: 3 extended box filters approximating the gaussian, the cost doesn't depend on the size. "
+                       "Use it for large blurs.");
+    algorithm->setDefault(eParamAlgorithmConvolution);
+
     OFX::GroupParamDescriptor* advanced = desc.defineGroupParam(kParamGroupAdvanced);
     advanced->setLabel("Advanced");
     advanced->setOpen(false);
 
     OFX::BooleanParamDescriptor* normalizedKernel = desc.defineBooleanParam(kParamNormalizedKernel);
     normalizedKernel->setLabel("Normalized kernel");
-    normalizedKernel->setHint("Use a normalized kernel to compute the gradient.");
+    normalizedKernel->setHint("Use a normalized kernel to compute the gradient. The box cascade is always normalized.");
     normalizedKernel->setDefault(true);
     normalizedKernel->setParent(advanced);
 
@@ -2,6 +2,7 @@
 
 #include <terry/filter/gaussianKernel.hpp>
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/boxBlur.hpp>
 
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
 
@@ -52,7 +53,11 @@ void BlurProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 
     const Point proc_tl(procWindowRoW.x1 - this->_srcPixelRod.x1, procWindowRoW.y1 - this->_srcPixelRod.y1);
 
-    if(_params._size.x == 0)
+    if(_params._algorithm == eParamAlgorithmBoxCascade)
+    {
+        gaussian_box_blur<Pixel>(this->_srcView, _params._boxX, _params._boxY, dst, proc_tl, _params._boundary_option);
+    }
+    else if(_params._size.x == 0)
     {
         correlate_cols_auto<Pixel>(this->_srcView, _params._gilKernelY, dst, proc_tl, _params._boundary_option);
     }
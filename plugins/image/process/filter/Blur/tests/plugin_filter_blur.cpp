@@ -0,0 +1,71 @@
+#define BOOST_TEST_MODULE plugin_Blur
+#include <tuttle/test/main.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <string>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+BOOST_AUTO_TEST_SUITE(plugin_Blur)
+
+BOOST_AUTO_TEST_CASE(box_cascade_matches_convolution)
+{
+    static const char* borderNames[] = {"No", "Mirror", "Constant", "Black"};
+
+    for(int border = 0; border < 4; ++border)
+    {
+        Graph g;
+        Graph::Node& checkerboard = g.createNode("tuttle.checkerboard");
+        Graph::Node& convolution = g.createNode("tuttle.blur");
+        Graph::Node& boxCascade = g.createNode("tuttle.blur");
+
+        checkerboard.getParam("width").setValue(256);
+        checkerboard.getParam("height").setValue(256);
+        checkerboard.getParam("explicitConversion").setValue(3); // 32f
+        convolution.getParam("size").setValue(20.0, 20.0);
+        convolution.getParam("border").setValue(border);
+        convolution.getParam("algorithm").setValue("Convolution");
+        boxCascade.getParam("size").setValue(20.0, 20.0);
+        boxCascade.getParam("border").setValue(border);
+        boxCascade.getParam("algorithm").setValue("Box cascade");
+        g.connect(checkerboard, convolution);
+        g.connect(checkerboard, boxCascade);
+
+        memory::MemoryCache outputCache;
+        std::list<std::string> outputs;
+        outputs.push_back(convolution.getName());
+        outputs.push_back(boxCascade.getName());
+        g.compute(outputCache, outputs);
+
+        memory::CACHE_ELEMENT convolutionImg = outputCache.get(convolution.getName(), 0);
+        memory::CACHE_ELEMENT boxCascadeImg = outputCache.get(boxCascade.getName(), 0);
+        BOOST_REQUIRE(convolutionImg.get() && boxCascadeImg.get());
+        BOOST_CHECK_EQUAL(convolutionImg->getROD().x1, boxCascadeImg->getROD().x1);
+        BOOST_CHECK_EQUAL(convolutionImg->getROD().x2, boxCascadeImg->getROD().x2);
+
+        const boost::gil::rgba32f_view_t convolutionView = convolutionImg->getGilView<boost::gil::rgba32f_view_t>();
+        const boost::gil::rgba32f_view_t boxCascadeView = boxCascadeImg->getGilView<boost::gil::rgba32f_view_t>();
+        BOOST_REQUIRE(convolutionView.dimensions() == boxCascadeView.dimensions());
+
+        // 3 boxes are close to the gaussian, the differences are on the edges of the squares
+        float maxDiff = 0;
+        for(int y = 0; y < convolutionView.height(); ++y)
+            for(int x = 0; x < convolutionView.width(); ++x)
+                for(int c = 0; c < 4; ++c)
+                    maxDiff = std::max(maxDiff, std::abs(convolutionView(x, y)[c] - boxCascadeView(x, y)[c]));
+        TUTTLE_LOG_INFO("[Blur] border " << borderNames[border] << ", max difference: " << maxDiff);
+        BOOST_CHECK_SMALL(maxDiff, 0.05f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
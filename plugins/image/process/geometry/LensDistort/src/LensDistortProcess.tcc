@@ -18,6 +18,8 @@ LensDistortProcess<View>::LensDistortProcess(LensDistortPlugin& instance)
     : ImageGilFilterProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
 {
+    // the cost of a pixel depends on its distance to the distortion center
+    this->setTileSizeAuto();
 }
 
 template <class View>
@@ -59,6 +59,7 @@ void ResizePlugin::updateVisibleTools()
 ResizeProcessParams<ResizePlugin::Scalar> ResizePlugin::getProcessParams(const OfxPointD& renderScale) const
 {
     ResizeProcessParams<Scalar> params;
+    params._changeCenter = false;
 #if(TUTTLE_EXPERIMENTAL)
     OfxPointD centerPoint = _paramCenterPoint->getValue();
 
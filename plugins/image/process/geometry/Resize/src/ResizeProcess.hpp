@@ -3,6 +3,10 @@
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
+#include <terry/sampler/resize.hpp>
+
+#include <boost/scoped_ptr.hpp>
+
 namespace tuttle
 {
 namespace plugin
@@ -13,6 +17,8 @@ namespace resize
 /**
  * @brief Resize process
  *
+ * The resize is done in two separable passes with precomputed contribution tables,
+ * or with a 2D sampler for each pixel when the center is moved.
  */
 template <class View>
 class ResizeProcess : public ImageGilFilterProcessor<View>
@@ -26,12 +32,21 @@ protected:
     ResizePlugin& _plugin;               ///< Rendering plugin
     ResizeProcessParams<Scalar> _params; ///< parameters
 
+    boost::scoped_ptr<terry::sampler::contribution_table> _xContributions; ///< source columns of each output column
+    boost::scoped_ptr<terry::sampler::contribution_table> _yContributions; ///< source rows of each output row
+
 public:
     ResizeProcess(ResizePlugin& effect);
 
     void setup(const OFX::RenderArguments& args);
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
+
+private:
+    template <typename Sampler>
+    void setupContributions(const Sampler& sampler, const terry::sampler::EParamFilterOutOfImage outOfImageProcess);
+
+    void resampleProcess(const OfxRectI& procWindow);
 };
 }
 }
@@ -14,14 +14,99 @@ ResizeProcess<View>::ResizeProcess(ResizePlugin& effect)
     : ImageGilFilterProcessor<View>(effect, eImageOrientationFromBottomToTop)
     , _plugin(effect)
 {
-    this->setNoMultiThreading();
 }
 
 template <class View>
 void ResizeProcess<View>::setup(const OFX::RenderArguments& args)
 {
+    using namespace terry::sampler;
+
     ImageGilFilterProcessor<View>::setup(args);
     _params = _plugin.getProcessParams(args.renderScale);
+
+    _xContributions.reset();
+    _yContributions.reset();
+    if(_params._changeCenter || this->_srcView.width() == 0 || this->_srcView.height() == 0)
+    {
+        this->setNoMultiThreading();
+        return;
+    }
+
+    const EParamFilterOutOfImage outOfImageProcess =
+        static_cast<EParamFilterOutOfImage>(_params._samplerProcessParams._outOfImageProcess);
+
+    switch(_params._samplerProcessParams._filter)
+    {
+        case eParamFilterNearest:
+            setupContributions(nearest_neighbor_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterBilinear:
+            setupContributions(bilinear_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterBC:
+            setupContributions(bc_sampler(_params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC),
+                               outOfImageProcess);
+            break;
+        case eParamFilterBicubic:
+            setupContributions(bicubic_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterCatrom:
+            setupContributions(catrom_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterKeys:
+            setupContributions(keys_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterSimon:
+            setupContributions(simon_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterRifman:
+            setupContributions(rifman_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterMitchell:
+            setupContributions(mitchell_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterParzen:
+            setupContributions(parzen_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterGaussian:
+            setupContributions(gaussian_sampler(_params._samplerProcessParams._filterSize,
+                                                _params._samplerProcessParams._filterSigma),
+                               outOfImageProcess);
+            break;
+        case eParamFilterLanczos:
+            setupContributions(lanczos_sampler(_params._samplerProcessParams._filterSize,
+                                               _params._samplerProcessParams._filterSharpen),
+                               outOfImageProcess);
+            break;
+        case eParamFilterLanczos3:
+            setupContributions(lanczos3_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterLanczos4:
+            setupContributions(lanczos4_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterLanczos6:
+            setupContributions(lanczos6_sampler(), outOfImageProcess);
+            break;
+        case eParamFilterLanczos12:
+            setupContributions(lanczos12_sampler(), outOfImageProcess);
+            break;
+    }
+}
+
+/**
+ * @brief Compute the source pixels and weights of each output column and row, shared by all the rendering threads.
+ */
+template <class View>
+template <typename Sampler>
+void ResizeProcess<View>::setupContributions(const Sampler& sampler,
+                                             const terry::sampler::EParamFilterOutOfImage outOfImageProcess)
+{
+    using terry::sampler::contribution_table;
+
+    _xContributions.reset(
+        new contribution_table(sampler, this->_srcView.width(), this->_dstView.width(), outOfImageProcess));
+    _yContributions.reset(
+        new contribution_table(sampler, this->_srcView.height(), this->_dstView.height(), outOfImageProcess));
 }
 
 /**
@@ -30,6 +115,26 @@ void ResizeProcess<View>::setup(const OFX::RenderArguments& args)
  */
 template <class View>
 void ResizeProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow)
+{
+    using namespace terry::sampler;
+
+    if(!_xContributions)
+    {
+        resampleProcess(procWindow);
+        return;
+    }
+
+    const EParamFilterOutOfImage outOfImageProcess =
+        static_cast<EParamFilterOutOfImage>(_params._samplerProcessParams._outOfImageProcess);
+    resize_separable_progress(this->_srcView, this->_dstView, *_xContributions, *_yContributions, ofxToGil(procWindow),
+                              outOfImageProcess, this->getOfxProgress());
+}
+
+/**
+ * @brief Sample each output pixel at its transformed position in the source image.
+ */
+template <class View>
+void ResizeProcess<View>::resampleProcess(const OfxRectI& procWindow)
 {
     using namespace terry;
     using namespace terry::sampler;
@@ -36,6 +36,7 @@ void MathOperatorPluginFactory::describe(OFX::ImageEffectDescriptor& desc)
 
     // plugin flags
     desc.setSupportsTiles(kSupportTiles);
+    desc.setPointwise(true);
     desc.setRenderThreadSafety(OFX::eRenderFullySafe);
 }
 
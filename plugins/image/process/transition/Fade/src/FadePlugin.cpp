@@ -23,10 +23,10 @@ FadePlugin::FadePlugin(OfxImageEffectHandle handle)
     _paramColor = fetchRGBAParam(kParamColor);
 }
 
-FadeProcessParams FadePlugin::getProcessParams() const
+FadeProcessParams FadePlugin::getProcessParams(const OfxTime time) const
 {
     FadeProcessParams params;
-    params._transition = _paramTransition->getValue();
+    params._transition = _paramTransition->getValueAtTime(time);
     params._rod = static_cast<EParamRod>(_paramRod->getValue());
     params._color = ofxToGil(_paramColor->getValue());
     return params;
@@ -63,7 +63,7 @@ void FadePlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::s
 
 bool FadePlugin::isIdentity(const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime)
 {
-    FadeProcessParams params = getProcessParams();
+    FadeProcessParams params = getProcessParams(args.time);
     if(params._transition == 0.0 && _clipSrcFrom->isConnected())
     {
         identityClip = _clipSrcFrom;
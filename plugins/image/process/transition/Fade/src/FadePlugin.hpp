@@ -31,7 +31,7 @@ public:
     FadePlugin(OfxImageEffectHandle handle);
 
 public:
-    FadeProcessParams getProcessParams() const;
+    FadeProcessParams getProcessParams(const OfxTime time) const;
 
     void changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName);
 
@@ -121,7 +121,7 @@ void FadeProcess<View>::setup(const OFX::RenderArguments& args)
         }
     }
 
-    _params = _plugin.getProcessParams();
+    _params = _plugin.getProcessParams(args.time);
 }
 
 /**
@@ -0,0 +1,196 @@
+#ifndef _TUTTLE_PLUGIN_DIFF_ALGORITHM_HPP_
+#define _TUTTLE_PLUGIN_DIFF_ALGORITHM_HPP_
+
+#include <terry/filter/detail/weighted_sum.hpp>
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/channel.hpp>
+#include <boost/gil/pixel.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace quality
+{
+
+/**
+ * @brief Peak signal to noise ratio in dB of a mean square error.
+ * Identical images are limited to 100dB instead of an infinite ratio.
+ */
+inline double psnrFromMse(const double mse, const double peak)
+{
+    const double peak2 = peak * peak;
+    return 10.0 * std::log10(peak2 / std::max(mse, peak2 * 1e-10));
+}
+
+/**
+ * @brief Dynamic range of a channel, 1 for float channels.
+ */
+template <class Channel>
+double channelPeak()
+{
+    if(!boost::is_integral<Channel>::value)
+        return 1.0;
+    return double(boost::gil::channel_traits<Channel>::max_value()) -
+           double(boost::gil::channel_traits<Channel>::min_value());
+}
+
+/**
+ * @brief Write a value of the error map into a channel, rounded and clamped for integer channels.
+ */
+template <class Channel>
+Channel channelFromValue(const double value)
+{
+    if(!boost::is_integral<Channel>::value)
+        return Channel(value);
+    const double minValue = boost::gil::channel_traits<Channel>::min_value();
+    const double maxValue = boost::gil::channel_traits<Channel>::max_value();
+    return Channel(std::min(std::max(value + 0.5, minValue), maxValue));
+}
+
+/**
+ * @brief Structural similarity of the rows of two images, for each channel.
+ *
+ * The local means, variances and covariance use a gaussian window of 11x11 pixels with a standard deviation of 1.5,
+ * clamped to the borders of the views.
+ * [Wang, Bovik, Sheikh, Simoncelli, "Image quality assessment: from error visibility to structural similarity",
+ * IEEE Transactions on Image Processing 2004]
+ *
+ * The window is separable: each source row is filtered horizontally once into a ring of rows,
+ * then a row of the result is the vertical weighted sum of the ring. Both passes use vectorized weighted sums on
+ * the 5 values (a, b, a*a, b*b, a*b) of all the channels of a pixel.
+ * Rows are expected in increasing order, like a band of a multithreaded process.
+ */
+template <class View>
+class SsimRows
+{
+public:
+    static const std::size_t nbChannels = boost::gil::num_channels<View>::value;
+    static const std::ptrdiff_t radius = 5;
+    static const std::ptrdiff_t windowSize = 2 * radius + 1;
+    static const std::size_t nbValues = 5 * nbChannels; ///< values filtered for each pixel
+
+    /**
+     * @param peak dynamic range of the channels
+     */
+    SsimRows(const View& viewA, const View& viewB, const double peak)
+        : _viewA(viewA)
+        , _viewB(viewB)
+        , _width(viewA.width())
+        , _c1(float((0.01 * peak) * (0.01 * peak)))
+        , _c2(float((0.03 * peak) * (0.03 * peak)))
+        , _line((_width + 2 * radius) * nbValues)
+        , _ring(windowSize * _width * nbValues)
+        , _rowInSlot(windowSize, -1)
+        , _filtered(_width * nbValues)
+        , _ssim(_width * nbChannels)
+    {
+        double sum = 0.0;
+        for(std::ptrdiff_t i = 0; i < windowSize; ++i)
+        {
+            const double x = i - radius;
+            _weights[i] = float(std::exp(-x * x / (2.0 * 1.5 * 1.5)));
+            sum += _weights[i];
+        }
+        for(std::ptrdiff_t i = 0; i < windowSize; ++i)
+            _weights[i] = float(_weights[i] / sum);
+    }
+
+    /**
+     * @brief SSIM of the pixels of the row @p y of the views.
+     * @return width * nbChannels values, valid until the next call
+     */
+    const float* row(const std::ptrdiff_t y)
+    {
+        using terry::filter::detail::weighted_sum;
+
+        const float* rows[windowSize];
+        for(std::ptrdiff_t k = 0; k < windowSize; ++k)
+            rows[k] = filteredRow(clamp(y - radius + k, _viewA.height()));
+        weighted_sum(rows, _weights, windowSize, _width * nbValues, &_filtered.front());
+
+        const float* v = &_filtered.front();
+        float* ssim = &_ssim.front();
+        for(std::ptrdiff_t x = 0; x < _width; ++x, v += nbValues, ssim += nbChannels)
+        {
+            for(std::size_t c = 0; c < nbChannels; ++c)
+            {
+                const float meanA = v[c];
+                const float meanB = v[nbChannels + c];
+                const float varianceA = v[2 * nbChannels + c] - meanA * meanA;
+                const float varianceB = v[3 * nbChannels + c] - meanB * meanB;
+                const float covariance = v[4 * nbChannels + c] - meanA * meanB;
+                ssim[c] = ((2.0f * meanA * meanB + _c1) * (2.0f * covariance + _c2)) /
+                          ((meanA * meanA + meanB * meanB + _c1) * (varianceA + varianceB + _c2));
+            }
+        }
+        return &_ssim.front();
+    }
+
+private:
+    static std::ptrdiff_t clamp(const std::ptrdiff_t i, const std::ptrdiff_t size)
+    {
+        return std::min(std::max(i, std::ptrdiff_t(0)), size - 1);
+    }
+
+    /// Horizontally filtered values of the source row @p y
+    const float* filteredRow(const std::ptrdiff_t y)
+    {
+        using terry::filter::detail::weighted_sum;
+
+        const std::size_t slot = y % windowSize;
+        float* dst = &_ring[slot * _width * nbValues];
+        if(_rowInSlot[slot] == y)
+            return dst;
+        _rowInSlot[slot] = y;
+
+        typename View::x_iterator itA = _viewA.row_begin(y);
+        typename View::x_iterator itB = _viewB.row_begin(y);
+        float* values = &_line.front();
+        for(std::ptrdiff_t i = -radius; i < _width + radius; ++i, values += nbValues)
+        {
+            const std::ptrdiff_t x = clamp(i, _width);
+            for(std::size_t c = 0; c < nbChannels; ++c)
+            {
+                const float a = float(itA[x][c]);
+                const float b = float(itB[x][c]);
+                values[c] = a;
+                values[nbChannels + c] = b;
+                values[2 * nbChannels + c] = a * a;
+                values[3 * nbChannels + c] = b * b;
+                values[4 * nbChannels + c] = a * b;
+            }
+        }
+
+        const float* srcs[windowSize];
+        for(std::ptrdiff_t k = 0; k < windowSize; ++k)
+            srcs[k] = &_line[k * nbValues];
+        weighted_sum(srcs, _weights, windowSize, _width * nbValues, dst);
+        return dst;
+    }
+
+private:
+    View _viewA;
+    View _viewB;
+    std::ptrdiff_t _width;
+    float _c1;
+    float _c2;
+    float _weights[windowSize];
+    std::vector<float> _line;                ///< values of a source row, with the clamped borders
+    std::vector<float> _ring;                ///< windowSize horizontally filtered rows
+    std::vector<std::ptrdiff_t> _rowInSlot;  ///< source row in each slot of the ring
+    std::vector<float> _filtered;            ///< vertically filtered row
+    std::vector<float> _ssim;
+};
+}
+}
+}
+
+#endif
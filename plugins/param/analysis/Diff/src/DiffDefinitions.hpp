@@ -27,8 +27,26 @@ enum EMeasureFunction
     eMeasureFunctionSSIM
 };
 
+static const std::string kErrorMapTileSize = "errorMapTileSize";
+static const std::string kErrorMapTileSizeLabel = "Error map tile size";
+
+static const std::string kSequenceReport = "sequenceReport";
+static const std::string kSequenceReportLabel = "Sequence report";
+
+static const std::string kSequenceReset = "sequenceReset";
+static const std::string kSequenceResetLabel = "Reset sequence";
+
 static const std::string kOutputQualityMesure = "quality";
 static const std::string kOutputQualityMesureLabel = "Quality";
+
+static const std::string kOutputSequenceAverage = "sequenceAverage";
+static const std::string kOutputSequenceAverageLabel = "Sequence average";
+
+static const std::string kOutputSequenceWorst = "sequenceWorst";
+static const std::string kOutputSequenceWorstLabel = "Sequence worst";
+
+static const std::string kOutputSequenceNbFrames = "sequenceNbFrames";
+static const std::string kOutputSequenceNbFramesLabel = "Sequence frames";
 }
 }
 }
@@ -3,6 +3,9 @@
 
 #include <boost/gil/gil_all.hpp>
 
+#include <algorithm>
+#include <fstream>
+
 namespace tuttle
 {
 namespace plugin
@@ -18,19 +21,111 @@ DiffPlugin::DiffPlugin(OfxImageEffectHandle handle)
     _clipDst = fetchClip(kOfxImageEffectOutputClipName);
 
     _measureFunction = fetchChoiceParam(kMeasureFunction);
+    _errorMapTileSize = fetchIntParam(kErrorMapTileSize);
+    _sequenceReport = fetchStringParam(kSequenceReport);
     _qualityMesure = fetchRGBAParam(kOutputQualityMesure);
+    _sequenceAverage = fetchRGBAParam(kOutputSequenceAverage);
+    _sequenceWorst = fetchRGBAParam(kOutputSequenceWorst);
+    _sequenceNbFrames = fetchIntParam(kOutputSequenceNbFrames);
+    _sequenceMeasureFunction = static_cast<EMeasureFunction>(_measureFunction->getValue());
 }
 
 DiffProcessParams DiffPlugin::getProcessParams() const
 {
     DiffProcessParams params;
     params.measureFunction = static_cast<EMeasureFunction>(_measureFunction->getValue());
+    params.errorMapTileSize = _errorMapTileSize->getValue();
 
     return params;
 }
 
 void DiffPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName)
 {
+    // the measures of different functions can't be accumulated together
+    if(paramName == kSequenceReset || paramName == kMeasureFunction)
+    {
+        resetSequence();
+    }
+}
+
+void DiffPlugin::addFrameMeasure(const OfxTime time, const EMeasureFunction measureFunction,
+                                 const OfxRGBAColourD& measure)
+{
+    OFX::MultiThread::AutoMutex locker(_sequenceMutex);
+    _sequenceMeasures[time] = measure;
+    _sequenceMeasureFunction = measureFunction;
+
+    // for the mse the worst frame has the greatest error, for psnr and ssim the lowest similarity
+    const bool greaterIsWorse = measureFunction == eMeasureFunctionMSE;
+    OfxRGBAColourD sum = {0.0, 0.0, 0.0, 0.0};
+    OfxRGBAColourD worst = measure;
+    for(std::map<OfxTime, OfxRGBAColourD>::const_iterator it = _sequenceMeasures.begin(); it != _sequenceMeasures.end();
+        ++it)
+    {
+        const OfxRGBAColourD& m = it->second;
+        sum.r += m.r;
+        sum.g += m.g;
+        sum.b += m.b;
+        sum.a += m.a;
+        if(greaterIsWorse)
+        {
+            worst.r = std::max(worst.r, m.r);
+            worst.g = std::max(worst.g, m.g);
+            worst.b = std::max(worst.b, m.b);
+            worst.a = std::max(worst.a, m.a);
+        }
+        else
+        {
+            worst.r = std::min(worst.r, m.r);
+            worst.g = std::min(worst.g, m.g);
+            worst.b = std::min(worst.b, m.b);
+            worst.a = std::min(worst.a, m.a);
+        }
+    }
+    const double nbFrames = _sequenceMeasures.size();
+    _sequenceAverage->setValue(sum.r / nbFrames, sum.g / nbFrames, sum.b / nbFrames, sum.a / nbFrames);
+    _sequenceWorst->setValue(worst.r, worst.g, worst.b, worst.a);
+    _sequenceNbFrames->setValue(static_cast<int>(_sequenceMeasures.size()));
+}
+
+void DiffPlugin::endSequenceRender(const OFX::EndSequenceRenderArguments& args)
+{
+    OFX::MultiThread::AutoMutex locker(_sequenceMutex);
+    writeSequenceReport();
+}
+
+void DiffPlugin::resetSequence()
+{
+    OFX::MultiThread::AutoMutex locker(_sequenceMutex);
+    _sequenceMeasures.clear();
+    _sequenceAverage->setValue(0.0, 0.0, 0.0, 0.0);
+    _sequenceWorst->setValue(0.0, 0.0, 0.0, 0.0);
+    _sequenceNbFrames->setValue(0);
+}
+
+/**
+ * @brief Write the report file with the measure of all the frames, sorted by time, one csv line per frame.
+ * The render doesn't depend on the report, so errors are only logged.
+ */
+void DiffPlugin::writeSequenceReport() const
+{
+    const std::string filename = _sequenceReport->getValue();
+    if(filename.empty() || _sequenceMeasures.empty())
+        return;
+
+    std::ofstream report(filename.c_str(), std::ios::out | std::ios::trunc);
+    static const char* measureNames[] = {"mse", "psnr", "ssim"};
+    report << "time,measure,r,g,b,a\n";
+    report.precision(10);
+    for(std::map<OfxTime, OfxRGBAColourD>::const_iterator it = _sequenceMeasures.begin(); it != _sequenceMeasures.end();
+        ++it)
+    {
+        const OfxRGBAColourD& m = it->second;
+        report << it->first << "," << measureNames[_sequenceMeasureFunction] << "," << m.r << "," << m.g << "," << m.b
+               << "," << m.a << "\n";
+    }
+    if(!report)
+        TUTTLE_LOG_ERROR("Diff: unable to write the sequence report " << quotes(filename) << ".");
 }
 
 bool DiffPlugin::getRegionOfDefinition(const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod)
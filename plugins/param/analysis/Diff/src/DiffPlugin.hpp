@@ -5,6 +5,10 @@
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <ofxsMultiThread.h>
+
+#include <map>
+
 namespace tuttle
 {
 namespace plugin
@@ -15,6 +19,7 @@ namespace quality
 struct DiffProcessParams
 {
     EMeasureFunction measureFunction;
+    int errorMapTileSize; ///< 0 for a map of the pixels
 };
 
 /**
@@ -34,6 +39,24 @@ public:
 
     void render(const OFX::RenderArguments& args);
 
+    /// Write the report of the sequence
+    void endSequenceRender(const OFX::EndSequenceRenderArguments& args);
+
+    /**
+     * @brief Add the measure of a frame to the sequence and update the sequence outputs.
+     * Only the measures are kept, a frame rendered again replaces its previous measure.
+     *
+     * The sequence only contains the frames rendered by this instance: the frames rendered by other instances
+     * of the node (as with frames rendered in parallel by the host) or the results reused from a cache
+     * are missing.
+     */
+    void addFrameMeasure(const OfxTime time, const EMeasureFunction measureFunction, const OfxRGBAColourD& measure);
+
+    void resetSequence();
+
+private:
+    void writeSequenceReport() const;
+
 public:
     // do not need to delete these, the ImageEffect is managing them for us
     OFX::Clip* _clipSrcA; ///< Source image clip A
@@ -41,8 +64,18 @@ public:
     OFX::Clip* _clipDst;  ///< Destination image clip
 
     OFX::ChoiceParam* _measureFunction;
+    OFX::IntParam* _errorMapTileSize;
+    OFX::StringParam* _sequenceReport;
 
     OFX::RGBAParam* _qualityMesure;
+    OFX::RGBAParam* _sequenceAverage;
+    OFX::RGBAParam* _sequenceWorst;
+    OFX::IntParam* _sequenceNbFrames;
+
+private:
+    OFX::MultiThread::Mutex _sequenceMutex;
+    std::map<OfxTime, OfxRGBAColourD> _sequenceMeasures; ///< measure of each rendered frame
+    EMeasureFunction _sequenceMeasureFunction;
 };
 }
 }
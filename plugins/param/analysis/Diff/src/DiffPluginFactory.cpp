@@ -4,6 +4,8 @@
 
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 
+#include <limits>
+
 namespace tuttle
 {
 namespace plugin
@@ -21,7 +23,11 @@ void DiffPluginFactory::describe(OFX::ImageEffectDescriptor& desc)
     desc.setPluginGrouping("tuttle/param/analysis");
     desc.setDescription("Diff\n"
                         "Plugin is used to show the result of a quality mesure function between two given images. \n"
-                        "MSE (mean square error) and PSNR (peak signal to noise ratio) are available.");
+                        "MSE (mean square error), PSNR (peak signal to noise ratio) and SSIM (structural similarity) "
+                        "are available.\n"
+                        "The output clip is a map of the error, by pixel or by tile.\n"
+                        "The measures of the rendered frames are accumulated into sequence outputs and an optional "
+                        "csv report.");
 
     // add the supported contexts, only filter at the moment
     desc.addSupportedContext(OFX::eContextGeneral);
@@ -72,13 +78,53 @@ void DiffPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX:
     diffFunction->setLabel(kMeasureFunctionLabel);
     diffFunction->appendOption(kMeasureFunctionMSE);
     diffFunction->appendOption(kMeasureFunctionPSNR);
-    //	diffFunction->appendOption( kMeasureFunctionSSIM );
+    diffFunction->appendOption(kMeasureFunctionSSIM);
     diffFunction->setDefault(eMeasureFunctionPSNR);
 
+    OFX::IntParamDescriptor* errorMapTileSize = desc.defineIntParam(kErrorMapTileSize);
+    assert(errorMapTileSize);
+    errorMapTileSize->setLabel(kErrorMapTileSizeLabel);
+    errorMapTileSize->setHint("Size of the tiles of the error map written to the output clip, each tile filled with "
+                              "the measure of its pixels. 0 to map each pixel.");
+    errorMapTileSize->setRange(0, std::numeric_limits<int>::max());
+    errorMapTileSize->setDisplayRange(0, 128);
+    errorMapTileSize->setDefault(0);
+
+    OFX::StringParamDescriptor* sequenceReport = desc.defineStringParam(kSequenceReport);
+    assert(sequenceReport);
+    sequenceReport->setLabel(kSequenceReportLabel);
+    sequenceReport->setHint("Csv file written at the end of the render with the measure of all the frames "
+                            "rendered by this node.");
+    sequenceReport->setStringType(OFX::eStringTypeFilePath);
+    sequenceReport->setEvaluateOnChange(false);
+
+    OFX::PushButtonParamDescriptor* sequenceReset = desc.definePushButtonParam(kSequenceReset);
+    assert(sequenceReset);
+    sequenceReset->setLabel(kSequenceResetLabel);
+
     OFX::RGBAParamDescriptor* outputQualityMesure = desc.defineRGBAParam(kOutputQualityMesure);
     assert(outputQualityMesure);
     outputQualityMesure->setLabel(kOutputQualityMesureLabel);
     outputQualityMesure->setEvaluateOnChange(false);
+
+    OFX::RGBAParamDescriptor* outputSequenceAverage = desc.defineRGBAParam(kOutputSequenceAverage);
+    assert(outputSequenceAverage);
+    outputSequenceAverage->setLabel(kOutputSequenceAverageLabel);
+    outputSequenceAverage->setEvaluateOnChange(false);
+    outputSequenceAverage->setDefault(0.0, 0.0, 0.0, 0.0);
+
+    OFX::RGBAParamDescriptor* outputSequenceWorst = desc.defineRGBAParam(kOutputSequenceWorst);
+    assert(outputSequenceWorst);
+    outputSequenceWorst->setLabel(kOutputSequenceWorstLabel);
+    outputSequenceWorst->setHint("Greatest error or lowest similarity of the rendered frames.");
+    outputSequenceWorst->setEvaluateOnChange(false);
+    outputSequenceWorst->setDefault(0.0, 0.0, 0.0, 0.0);
+
+    OFX::IntParamDescriptor* outputSequenceNbFrames = desc.defineIntParam(kOutputSequenceNbFrames);
+    assert(outputSequenceNbFrames);
+    outputSequenceNbFrames->setLabel(kOutputSequenceNbFramesLabel);
+    outputSequenceNbFrames->setEvaluateOnChange(false);
+    outputSequenceNbFrames->setDefault(0);
 }
 
 /**
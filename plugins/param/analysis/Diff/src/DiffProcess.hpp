@@ -7,6 +7,8 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include <vector>
+
 namespace tuttle
 {
 namespace plugin
@@ -17,12 +19,16 @@ namespace quality
 /**
  * @brief Diff process
  *
+ * The rows of the render window are measured in parallel bands, each row keeps its own sums,
+ * then the sums are merged in the rows order in postProcess, so the measure doesn't depend on the number of threads.
  */
 template <class View>
 class DiffProcess : public ImageGilProcessor<View>
 {
     typedef typename boost::gil::pixel<boost::gil::bits32f,
                                        boost::gil::layout<typename boost::gil::color_space_type<View>::type> > PixelF;
+    typedef typename boost::gil::channel_type<View>::type Channel;
+    static const std::size_t nbChannels = boost::gil::num_channels<View>::value;
 
 protected:
     DiffPlugin& _plugin;       ///< Rendering plugin
@@ -34,18 +40,31 @@ protected:
     OfxRectI _srcPixelRodA;
     OfxRectI _srcPixelRodB;
 
+    View _windowViewA; ///< Source view A on the render window
+    View _windowViewB; ///< Source view B on the render window
+    View _windowViewDst;
+    double _peak; ///< dynamic range of the channels
+
+    OfxRectI _measuredRect;       ///< pixels counted in the measure, in render window coordinates
+    std::vector<double> _rowSums; ///< for each row and channel, sum of the squared errors or of the ssim
+    OfxPointI _nbTiles;
+    std::vector<double> _rowTileSums; ///< for each row, tile and channel, sum of the squared errors or of the ssim
+
 public:
     DiffProcess(DiffPlugin& instance);
     void setup(const OFX::RenderArguments& args);
 
     // Do some processing
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
-    template <class SView>
-    boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-    mse(const SView& v1, const SView& v2, const SView& dst, bool outputIsPsnr = false);
-    template <class SView>
-    boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-    psnr(const SView& v1, const SView& v2, const SView& dst);
+
+    void postProcess();
+
+private:
+    /// Measure of nbPixels pixels from the sum of their squared errors or ssim, for a channel
+    double measure(const double sum, const std::size_t nbPixels) const;
+    /// Error map value of nbPixels pixels from the sum of their squared errors or ssim, for a channel
+    double mapValue(const double sum, const std::size_t nbPixels) const;
+    void fillTiles();
 };
 }
 }
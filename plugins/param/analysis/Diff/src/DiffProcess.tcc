@@ -1,10 +1,13 @@
 #include "DiffPlugin.hpp"
-
-#include <climits>
+#include "DiffAlgorithm.hpp"
 
 #include <tuttle/plugin/numeric/rectOp.hpp>
 #include <terry/globals.hpp>
-#include <terry/basic_colors.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 namespace tuttle
 {
@@ -17,8 +20,10 @@ template <class View>
 DiffProcess<View>::DiffProcess(DiffPlugin& instance)
     : ImageGilProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
+    , _peak(1.0)
 {
-    this->setNoMultiThreading();
+    // each thread measures whole rows
+    this->setTileSize(0, 0);
 }
 
 template <class View>
@@ -75,6 +80,46 @@ void DiffProcess<View>::setup(const OFX::RenderArguments& args)
     {
         BOOST_THROW_EXCEPTION(exception::InputMismatch() << exception::user("Diff: components mismatch"));
     }
+
+    const OfxRectI& window = this->_renderArgs.renderWindow;
+    const OfxPointI& windowSize = this->_renderWindowSize;
+    _windowViewA = subimage_view(_srcViewA, window.x1 - _srcPixelRodA.x1, window.y1 - _srcPixelRodA.y1, windowSize.x,
+                                 windowSize.y);
+    _windowViewB = subimage_view(_srcViewB, window.x1 - _srcPixelRodB.x1, window.y1 - _srcPixelRodB.y1, windowSize.x,
+                                 windowSize.y);
+    _windowViewDst = subimage_view(this->_dstView, window.x1 - this->_dstPixelRod.x1, window.y1 - this->_dstPixelRod.y1,
+                                   windowSize.x, windowSize.y);
+    _peak = channelPeak<Channel>();
+
+    // the ssim of the borders uses clamped pixels, only the pixels with their whole window inside the image are
+    // measured, unless the image is smaller than the window
+    _measuredRect.x1 = _measuredRect.y1 = 0;
+    _measuredRect.x2 = windowSize.x;
+    _measuredRect.y2 = windowSize.y;
+    if(_params.measureFunction == eMeasureFunctionSSIM)
+    {
+        const int radius = SsimRows<View>::radius;
+        if(windowSize.x > 2 * radius)
+        {
+            _measuredRect.x1 = radius;
+            _measuredRect.x2 = windowSize.x - radius;
+        }
+        if(windowSize.y > 2 * radius)
+        {
+            _measuredRect.y1 = radius;
+            _measuredRect.y2 = windowSize.y - radius;
+        }
+    }
+    _rowSums.assign(windowSize.y * nbChannels, 0.0);
+
+    _nbTiles.x = _nbTiles.y = 0;
+    _rowTileSums.clear();
+    if(_params.errorMapTileSize > 0)
+    {
+        _nbTiles.x = (windowSize.x + _params.errorMapTileSize - 1) / _params.errorMapTileSize;
+        _nbTiles.y = (windowSize.y + _params.errorMapTileSize - 1) / _params.errorMapTileSize;
+        _rowTileSums.assign(windowSize.y * _nbTiles.x * nbChannels, 0.0);
+    }
 }
 
 /**
@@ -84,114 +129,164 @@ void DiffProcess<View>::setup(const OFX::RenderArguments& args)
 template <class View>
 void DiffProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    using namespace boost::gil;
-    OfxPointI procWindowSize = {procWindowRoW.x2 - procWindowRoW.x1, procWindowRoW.y2 - procWindowRoW.y1};
-    View srcViewA = subimage_view(this->_srcViewA, procWindowRoW.x1 - _srcPixelRodA.x1, procWindowRoW.y1 - _srcPixelRodA.y1,
-                                  procWindowSize.x, procWindowSize.y);
-    View srcViewB = subimage_view(this->_srcViewB, procWindowRoW.x1 - _srcPixelRodB.x1, procWindowRoW.y1 - _srcPixelRodB.y1,
-                                  procWindowSize.x, procWindowSize.y);
-    View dstView = subimage_view(this->_dstView, procWindowRoW.x1 - this->_dstPixelRod.x1,
-                                 procWindowRoW.y1 - this->_dstPixelRod.y1, procWindowSize.x, procWindowSize.y);
+    const OfxRectI& window = this->_renderArgs.renderWindow;
+    BOOST_ASSERT(procWindowRoW.x1 == window.x1 && procWindowRoW.x2 == window.x2);
+    const std::ptrdiff_t width = _windowViewA.width();
+    const int tileSize = _params.errorMapTileSize;
 
-    rgba32f_pixel_t paramRgbaValue(0, 0, 0, 0);
+    boost::scoped_ptr<SsimRows<View> > ssimRows;
+    if(_params.measureFunction == eMeasureFunctionSSIM)
+        ssimRows.reset(new SsimRows<View>(_windowViewA, _windowViewB, _peak));
+    std::vector<float> values(width * nbChannels); // squared error or ssim of the pixels of a row
 
-    switch(_params.measureFunction)
+    for(std::ptrdiff_t y = procWindowRoW.y1 - window.y1; y < procWindowRoW.y2 - window.y1; ++y)
     {
-        case eMeasureFunctionMSE:
-            color_convert(mse(srcViewA, srcViewB, dstView), paramRgbaValue);
-            break;
-        case eMeasureFunctionPSNR:
-            color_convert(psnr(srcViewA, srcViewB, dstView), paramRgbaValue);
-            break;
-        case eMeasureFunctionSSIM:
-            break;
-    }
+        typename View::x_iterator itA = _windowViewA.row_begin(y);
+        typename View::x_iterator itB = _windowViewB.row_begin(y);
+        if(ssimRows)
+        {
+            const float* ssim = ssimRows->row(y);
+            std::copy(ssim, ssim + values.size(), values.begin());
+        }
+        else
+        {
+            for(std::ptrdiff_t x = 0; x < width; ++x)
+            {
+                for(std::size_t c = 0; c < nbChannels; ++c)
+                {
+                    const float diff = float(itA[x][c]) - float(itB[x][c]);
+                    values[x * nbChannels + c] = diff * diff;
+                }
+            }
+        }
 
-    _plugin._qualityMesure->setValueAtTime(this->_renderArgs.time, get_color(paramRgbaValue, red_t()),
-                                           get_color(paramRgbaValue, green_t()), get_color(paramRgbaValue, blue_t()),
-                                           get_color(paramRgbaValue, alpha_t()));
-}
+        if(y >= _measuredRect.y1 && y < _measuredRect.y2)
+        {
+            double* rowSums = &_rowSums[y * nbChannels];
+            for(std::ptrdiff_t x = _measuredRect.x1; x < _measuredRect.x2; ++x)
+                for(std::size_t c = 0; c < nbChannels; ++c)
+                    rowSums[c] += values[x * nbChannels + c];
+        }
 
-template <class View>
-template <class SView>
-boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-DiffProcess<View>::psnr(const SView& v1, const SView& v2, const SView& dst)
-{
-    typedef boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-        Pixel32F;
-    typedef typename boost::gil::channel_type<Pixel32F>::type Value32F;
-    typedef typename boost::gil::channel_type<typename SView::value_type>::type SValueType;
-
-    size_t d = (size_t)(std::pow(2.0, sizeof(SValueType) * 8.0)) - 1;
-    size_t d2 = d * d;
-    Pixel32F psnr = mse(v1, v2, dst, true);
-    for(int i = 0; i < boost::gil::num_channels<Pixel32F>::type::value; ++i)
-    {
-        float p = (float)d2 - ((float)d2 / psnr[i]);
-        if(p > std::numeric_limits<float>::epsilon())
-            psnr[i] = Value32F(10.0 * std::log10(p));
+        if(tileSize > 0)
+        {
+            // the tiles are filled once all the rows are measured
+            double* tileSums = &_rowTileSums[y * _nbTiles.x * nbChannels];
+            for(std::ptrdiff_t x = 0; x < width; ++x)
+                for(std::size_t c = 0; c < nbChannels; ++c)
+                    tileSums[(x / tileSize) * nbChannels + c] += values[x * nbChannels + c];
+        }
         else
-            psnr[i] = 0;
+        {
+            typename View::x_iterator itD = _windowViewDst.row_begin(y);
+            for(std::ptrdiff_t x = 0; x < width; ++x)
+                for(std::size_t c = 0; c < nbChannels; ++c)
+                    itD[x][c] = channelFromValue<Channel>(mapValue(values[x * nbChannels + c], 1));
+        }
+
+        if(this->progressForward(width))
+            return;
     }
-    return psnr;
 }
 
 template <class View>
-template <class SView>
-boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-DiffProcess<View>::mse(const SView& v1, const SView& v2, const SView& dst, bool outputIsPsnr)
+void DiffProcess<View>::postProcess()
 {
-    using namespace terry;
-    typedef boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-        Pixel32F;
-    typedef typename boost::gil::channel_type<Pixel32F>::type Value32F;
-    typedef typename boost::gil::channel_type<typename SView::value_type>::type SValueType;
+    using namespace boost::gil;
+
+    if(!this->_effect.abort())
+    {
+        if(_nbTiles.x > 0)
+            fillTiles();
 
-    Pixel32F veqm = get_black<Pixel32F>();
-    int w = v1.width();
-    int h = v1.height();
+        std::vector<double> sums(nbChannels, 0.0);
+        for(std::ptrdiff_t y = _measuredRect.y1; y < _measuredRect.y2; ++y)
+            for(std::size_t c = 0; c < nbChannels; ++c)
+                sums[c] += _rowSums[y * nbChannels + c];
 
-    size_t d = (size_t)(std::pow(2.0, sizeof(SValueType) * 8.0)) - 1;
-    size_t d2 = d * d;
+        const std::size_t nbPixels =
+            std::size_t(_measuredRect.x2 - _measuredRect.x1) * std::size_t(_measuredRect.y2 - _measuredRect.y1);
+        PixelF measurePixel;
+        for(std::size_t c = 0; c < nbChannels; ++c)
+            measurePixel[c] = bits32f(measure(sums[c], nbPixels));
+
+        rgba32f_pixel_t paramRgbaValue(0, 0, 0, 0);
+        color_convert(measurePixel, paramRgbaValue);
+        _plugin._qualityMesure->setValueAtTime(this->_renderArgs.time, get_color(paramRgbaValue, red_t()),
+                                               get_color(paramRgbaValue, green_t()), get_color(paramRgbaValue, blue_t()),
+                                               get_color(paramRgbaValue, alpha_t()));
+
+        const OfxRGBAColourD frameMeasure = {get_color(paramRgbaValue, red_t()), get_color(paramRgbaValue, green_t()),
+                                             get_color(paramRgbaValue, blue_t()), get_color(paramRgbaValue, alpha_t())};
+        _plugin.addFrameMeasure(this->_renderArgs.time, _params.measureFunction, frameMeasure);
+    }
+
+    ImageGilProcessor<View>::postProcess();
+}
 
-    for(typename SView::y_coord_t y = 0; y < h; ++y)
+/**
+ * @brief Fill each tile of the error map with the measure of its pixels.
+ */
+template <class View>
+void DiffProcess<View>::fillTiles()
+{
+    const int tileSize = _params.errorMapTileSize;
+    const std::ptrdiff_t width = _windowViewDst.width();
+    const std::ptrdiff_t height = _windowViewDst.height();
+    std::vector<double> sums(_nbTiles.x * nbChannels);
+    for(int ty = 0; ty < _nbTiles.y; ++ty)
     {
-        typename SView::x_iterator itA = v1.row_begin(y);
-        typename SView::x_iterator itB = v2.row_begin(y);
-        typename SView::x_iterator itD = dst.row_begin(y);
+        const std::ptrdiff_t y1 = ty * tileSize;
+        const std::ptrdiff_t y2 = std::min(y1 + tileSize, height);
+        std::fill(sums.begin(), sums.end(), 0.0);
+        for(std::ptrdiff_t y = y1; y < y2; ++y)
+            for(std::size_t i = 0; i < sums.size(); ++i)
+                sums[i] += _rowTileSums[y * sums.size() + i];
 
-        for(typename SView::x_coord_t x = 0; x < w; ++x)
+        for(int tx = 0; tx < _nbTiles.x; ++tx)
         {
-            for(int i = 0; i < boost::gil::num_channels<Pixel32F>::type::value; ++i)
-            {
-                Value32F diff = (Value32F)std::abs(double((*itA)[i] - (*itB)[i]));
-
-                if(outputIsPsnr)
-                {
-                    float p = (float)d2 / diff;
-                    if(p > std::numeric_limits<float>::epsilon())
-                        (*itD)[i] = Value32F(10.0 * std::log10(p));
-                    else
-                        (*itD)[i] = 0;
-                }
-                else
-                {
-                    (*itD)[i] = diff;
-                }
-                veqm[i] += diff * diff;
-            }
-            ++itA;
-            ++itB;
-            ++itD;
+            const std::ptrdiff_t x1 = tx * tileSize;
+            const std::ptrdiff_t x2 = std::min(x1 + tileSize, width);
+            const std::size_t nbPixels = std::size_t(x2 - x1) * std::size_t(y2 - y1);
+            typename View::value_type pixel;
+            for(std::size_t c = 0; c < nbChannels; ++c)
+                pixel[c] = channelFromValue<Channel>(mapValue(sums[tx * nbChannels + c], nbPixels));
+            boost::gil::fill_pixels(subimage_view(_windowViewDst, x1, y1, x2 - x1, y2 - y1), pixel);
         }
-        this->progressUpdate((float)(y + 1) / h);
     }
+}
 
-    for(int i = 0; i < boost::gil::num_channels<Pixel32F>::type::value; ++i)
+template <class View>
+double DiffProcess<View>::measure(const double sum, const std::size_t nbPixels) const
+{
+    const double mean = nbPixels ? sum / nbPixels : 0.0;
+    switch(_params.measureFunction)
     {
-        veqm[i] /= (w * h);
+        case eMeasureFunctionMSE:
+        case eMeasureFunctionSSIM:
+            return mean;
+        case eMeasureFunctionPSNR:
+            return psnrFromMse(mean, _peak);
+    }
+    return 0.0;
+}
+
+template <class View>
+double DiffProcess<View>::mapValue(const double sum, const std::size_t nbPixels) const
+{
+    const double mean = nbPixels ? sum / nbPixels : 0.0;
+    switch(_params.measureFunction)
+    {
+        case eMeasureFunctionMSE:
+            // root of the mean square error, the absolute difference for a pixel
+            return std::sqrt(mean);
+        case eMeasureFunctionPSNR:
+            return psnrFromMse(mean, _peak);
+        case eMeasureFunctionSSIM:
+            // in the range of the channels
+            return mean * _peak;
     }
-    return veqm;
+    return 0.0;
 }
 }
 }
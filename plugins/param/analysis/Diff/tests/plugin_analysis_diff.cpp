@@ -0,0 +1,115 @@
+#define BOOST_TEST_MODULE plugin_Diff
+#include <tuttle/test/main.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace
+{
+
+struct Measure
+{
+    std::string name;
+    double r, g, b, a;
+};
+
+/**
+ * @brief Compare two constant float images and read the measure of the frame from the sequence report.
+ */
+Measure diffConstants(const int measureFunction, const double colorA[4], const double colorB[4])
+{
+    const boost::filesystem::path report =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("plugin_diff_%%%%%%%%.csv");
+
+    Graph g;
+    Graph::Node& constantA = g.createNode("tuttle.constant");
+    Graph::Node& constantB = g.createNode("tuttle.constant");
+    Graph::Node& diff = g.createNode("tuttle.diff");
+
+    constantA.getParam("width").setValue(64);
+    constantA.getParam("height").setValue(64);
+    constantA.getParam("explicitConversion").setValue(3); // 32f
+    constantA.getParam("color").setValue(colorA[0], colorA[1], colorA[2], colorA[3]);
+    constantB.getParam("width").setValue(64);
+    constantB.getParam("height").setValue(64);
+    constantB.getParam("explicitConversion").setValue(3); // 32f
+    constantB.getParam("color").setValue(colorB[0], colorB[1], colorB[2], colorB[3]);
+    diff.getParam("measureFunction").setValue(measureFunction);
+    diff.getParam("sequenceReport").setValue(report.string());
+    g.connect(constantA, diff.getAttribute("SourceA"));
+    g.connect(constantB, diff.getAttribute("SourceB"));
+
+    g.compute(diff);
+
+    // the report is written at the end of the sequence: "time,measure,r,g,b,a" then one line per frame
+    Measure measure = {"", 0, 0, 0, 0};
+    std::ifstream file(report.string().c_str());
+    std::string header;
+    std::string line;
+    BOOST_REQUIRE(std::getline(file, header) && std::getline(file, line));
+    char name[16] = {0};
+    double time = 0;
+    BOOST_REQUIRE_EQUAL(std::sscanf(line.c_str(), "%lf,%15[a-z],%lf,%lf,%lf,%lf", &time, name, &measure.r, &measure.g,
+                                    &measure.b, &measure.a),
+                        6);
+    measure.name = name;
+    file.close();
+    boost::filesystem::remove(report);
+    return measure;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(plugin_Diff)
+
+BOOST_AUTO_TEST_CASE(identical_images)
+{
+    const double color[4] = {0.2, 0.5, 0.8, 1.0};
+
+    const Measure ssim = diffConstants(2, color, color);
+    BOOST_CHECK_EQUAL(ssim.name, "ssim");
+    BOOST_CHECK_CLOSE(ssim.r, 1.0, 1e-3);
+    BOOST_CHECK_CLOSE(ssim.g, 1.0, 1e-3);
+    BOOST_CHECK_CLOSE(ssim.b, 1.0, 1e-3);
+    BOOST_CHECK_CLOSE(ssim.a, 1.0, 1e-3);
+
+    // no infinite ratio, the psnr of identical images is limited to 100dB
+    const Measure psnr = diffConstants(1, color, color);
+    BOOST_CHECK_EQUAL(psnr.name, "psnr");
+    BOOST_CHECK_CLOSE(psnr.r, 100.0, 1e-6);
+    BOOST_CHECK_CLOSE(psnr.g, 100.0, 1e-6);
+    BOOST_CHECK_CLOSE(psnr.b, 100.0, 1e-6);
+    BOOST_CHECK_CLOSE(psnr.a, 100.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(known_offset)
+{
+    const double colorA[4] = {0.5, 0.5, 0.5, 1.0};
+    const double colorB[4] = {0.25, 0.5, 0.75, 0.875};
+
+    // every pixel has the same error: mse = offset^2, psnr = 10 * log10(1 / mse) for float images
+    const Measure mse = diffConstants(0, colorA, colorB);
+    BOOST_CHECK_EQUAL(mse.name, "mse");
+    BOOST_CHECK_CLOSE(mse.r, 0.0625, 1e-4);
+    BOOST_CHECK_SMALL(mse.g, 1e-12);
+    BOOST_CHECK_CLOSE(mse.b, 0.0625, 1e-4);
+    BOOST_CHECK_CLOSE(mse.a, 0.015625, 1e-4);
+
+    const Measure psnr = diffConstants(1, colorA, colorB);
+    BOOST_CHECK_CLOSE(psnr.r, 10.0 * std::log10(16.0), 1e-4);
+    BOOST_CHECK_CLOSE(psnr.g, 100.0, 1e-6);
+    BOOST_CHECK_CLOSE(psnr.b, 10.0 * std::log10(16.0), 1e-4);
+    BOOST_CHECK_CLOSE(psnr.a, 10.0 * std::log10(64.0), 1e-4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()